@@ -1,8 +1,13 @@
 #ifndef ARRAYLIST_H
 #define ARRAYLIST_H
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <utility>
+#include <vector>
 #include "../node/node.h"
+#include "../memory_usage/memory_usage.h"
 
 template <typename T>
 class ArrayList {
@@ -13,29 +18,40 @@ class ArrayList {
         int size;
         void addWhenEmpty(Node<T>* node);
         void removeWhenEmpty();
-        void shift();
-        void unshift();
-        void removeMiddle(Node<T>* node);
+        void linkLast(Node<T>* first, Node<T>* last, int count);
 
     public:
         ArrayList<T>();
+        ArrayList<T>(const ArrayList<T>& other);
+        ArrayList<T>& operator=(const ArrayList<T>& other);
+        ArrayList<T>(ArrayList<T>&& other) noexcept;
+        ArrayList<T>& operator=(ArrayList<T>&& other) noexcept;
+        void clear();
         void addFirst(T data);
         void addLast(T data);
+        template <typename Iterator>
+        void appendRange(Iterator first, Iterator last);
+        void splice(ArrayList<T>& other);
+        void splice(ArrayList<T>& other, Node<T>* first, Node<T>* last);
         Node<T>* get();
         Node<T>* get(int index);
-        Node<T>* getFirst();
-        Node<T>* getLast();
+        Node<T>* getFirst() const;
+        Node<T>* getLast() const;
         Node<T>* remove(int index);
         Node<T>* removeFirst();
         Node<T>* removeLast();
+        Node<T>* removeNode(Node<T>* node);
+        template <typename Compare = std::less<T>>
+        void sort(Compare compare = Compare());
         bool currentNext();
         bool currentPrevious();
         void currentReset();
         Node<T>* currentPeek();
-        bool has(T data);
+        bool has(const T &data) const;
         int getSize() const;
+        MemoryFootprint footprint() const;
         void printList();
-        bool isEmpty();
+        bool isEmpty() const;
         ~ArrayList();
 };
 
@@ -52,12 +68,84 @@ ArrayList<T>::ArrayList() {
     this->size = 0;
 }
 
+/**
+ * @brief Constructor de copia profunda.
+ * Duplica cada nodo de la lista origen para que ambas instancias sean dueñas de su memoria;
+ * el cursor de la copia queda en la misma posición relativa que el de la original.
+ * @param other Lista a copiar.
+ */
+template<typename T>
+ArrayList<T>::ArrayList(const ArrayList<T>& other) : ArrayList<T>() {
+    *this = other;
+}
+
+/**
+ * @brief Asignación por copia profunda.
+ * Libera los nodos actuales y replica el contenido y la posición del cursor de la lista origen.
+ * @param other Lista a copiar.
+ * @return Referencia a esta lista.
+ */
+template<typename T>
+ArrayList<T>& ArrayList<T>::operator=(const ArrayList<T>& other) {
+    if (this == &other) return *this;
+    this->clear();
+    Node<T> *temp = other.head;
+    while (temp != nullptr) {
+        this->addLast(temp->getData());
+        if (temp == other.current) this->current = this->tail;
+        temp = temp->getNextNode();
+    }
+    return *this;
+}
+
+/**
+ * @brief Constructor de movimiento.
+ * Transfiere la propiedad de los nodos sin copiarlos; la lista origen queda vacía.
+ * @param other Lista cuyos nodos se adoptan.
+ */
+template<typename T>
+ArrayList<T>::ArrayList(ArrayList<T>&& other) noexcept : ArrayList<T>() {
+    *this = std::move(other);
+}
+
+/**
+ * @brief Asignación por movimiento.
+ * Libera los nodos actuales y adopta los de la lista origen, que queda vacía.
+ * @param other Lista cuyos nodos se adoptan.
+ * @return Referencia a esta lista.
+ */
+template<typename T>
+ArrayList<T>& ArrayList<T>::operator=(ArrayList<T>&& other) noexcept {
+    if (this == &other) return *this;
+    this->clear();
+    this->head = other.head;
+    this->tail = other.tail;
+    this->current = other.current;
+    this->size = other.size;
+    other.removeWhenEmpty();
+    return *this;
+}
+
+/**
+ * @brief Elimina todos los nodos y deja la lista vacía.
+ */
+template<typename T>
+void ArrayList<T>::clear() {
+    Node<T> *temp = this->head;
+    while (temp != nullptr) {
+        Node<T> *next = temp->getNextNode();
+        delete temp;
+        temp = next;
+    }
+    this->removeWhenEmpty();
+}
+
 /**
  * @brief Verifica el estado de vacuidad de la lista.
  * @return true si la lista no contiene elementos (head es nulo), false en caso contrario.
  */
 template<typename T>
-bool ArrayList<T>::isEmpty() {
+bool ArrayList<T>::isEmpty() const {
     return this->head == nullptr;
 }
 
@@ -81,7 +169,7 @@ void ArrayList<T>::addWhenEmpty(Node<T> *node) {
  */
 template<typename T>
 void ArrayList<T>::addFirst(T data) {
-    Node<T> *node = new Node<T>(data);
+    Node<T> *node = new Node<T>(std::move(data));
     if (this->isEmpty()) {
         this->addWhenEmpty(node);
         return;
@@ -103,7 +191,7 @@ void ArrayList<T>::addFirst(T data) {
  */
 template<typename T>
 void ArrayList<T>::addLast(T data) {
-    Node<T> *node = new Node<T>(data);
+    Node<T> *node = new Node<T>(std::move(data));
     if (this->isEmpty()) {
         this->addWhenEmpty(node);
         return;
@@ -191,8 +279,8 @@ Node<T>* ArrayList<T>::currentPeek() {
  * @return Puntero al nodo cabeza (head).
  */
 template<typename T>
-Node<T> *ArrayList<T>::getFirst() {
-    return this->get(1);
+Node<T> *ArrayList<T>::getFirst() const {
+    return this->head;
 }
 
 /**
@@ -200,8 +288,8 @@ Node<T> *ArrayList<T>::getFirst() {
  * @return Puntero al nodo cola (tail).
  */
 template<typename T>
-Node<T> *ArrayList<T>::getLast() {
-    return this->get(this->size);
+Node<T> *ArrayList<T>::getLast() const {
+    return this->tail;
 }
 
 /**
@@ -217,69 +305,116 @@ void ArrayList<T>::removeWhenEmpty() {
 }
 
 /**
- * @brief Elimina el primer elemento de la lista (similar a pop_front).
+ * @brief Enlaza al final una cadena de nodos ya construida.
+ * @note Método privado de soporte para splice(); los nodos no se copian.
+ * @param first Primer nodo de la cadena.
+ * @param last Último nodo de la cadena.
+ * @param count Número de nodos entre @p first y @p last, ambos incluidos.
  */
 template<typename T>
-void ArrayList<T>::shift() {
-    if (this->isEmpty()) return;
-
-    if (this->size == 1) {
-        this->removeWhenEmpty();
+void ArrayList<T>::linkLast(Node<T> *first, Node<T> *last, const int count) {
+    first->setPreviousNode(this->tail);
+    last->setNextNode(nullptr);
+    if (this->isEmpty()) {
+        this->head = first;
+        this->current = first;
     } else {
-        this->head = this->head->getNextNode();
-        if (this->current == this->head->getPreviousNode()) this->current = this->head;
-        this->head->setPreviousNode(nullptr);
-        --this->size;
+        this->tail->setNextNode(first);
     }
+    this->tail = last;
+    this->size += count;
 }
 
 /**
- * @brief Elimina el último elemento de la lista (similar a pop_back).
+ * @brief Inserta al final una copia de cada elemento de un rango.
+ * Con std::make_move_iterator los elementos se mueven en lugar de copiarse.
+ * @param first Iterador al primer elemento.
+ * @param last Iterador posterior al último elemento.
  */
 template<typename T>
-void ArrayList<T>::unshift() {
-    if (this->isEmpty()) return;
+template<typename Iterator>
+void ArrayList<T>::appendRange(Iterator first, const Iterator last) {
+    for (; first != last; ++first) this->addLast(*first);
+}
 
-    if (this->size == 1) {
-        this->removeWhenEmpty();
-    } else {
-        this->tail = this->tail->getPreviousNode();
-        if (this->current == this->tail->getPreviousNode()) this->current = this->tail ;
-        this->tail->setNextNode(nullptr);
-        --this->size;
+/**
+ * @brief Mueve todos los nodos de otra lista al final de esta en O(1).
+ * Los nodos cambian de dueño sin copiarse; la lista origen queda vacía. El cursor de esta
+ * lista no cambia, salvo si estaba vacía, en cuyo caso adopta el de la lista origen.
+ * @param other Lista cuyos nodos se adoptan.
+ */
+template<typename T>
+void ArrayList<T>::splice(ArrayList<T> &other) {
+    if (this == &other || other.isEmpty()) return;
+    Node<T> *cursor = this->isEmpty() ? other.current : this->current;
+    this->linkLast(other.head, other.tail, other.size);
+    this->current = cursor;
+    other.removeWhenEmpty();
+}
+
+/**
+ * @brief Mueve el tramo [first, last] de otra lista al final de esta.
+ * Los nodos no se copian, pero contar el tramo cuesta O(k) saltos de puntero. Si el cursor
+ * de la lista origen estaba dentro del tramo, pasa al nodo siguiente (o al anterior).
+ * @param other Lista que contiene el tramo; debe ser distinta de esta.
+ * @param first Primer nodo del tramo.
+ * @param last Último nodo del tramo; debe alcanzarse desde @p first.
+ */
+template<typename T>
+void ArrayList<T>::splice(ArrayList<T> &other, Node<T> *first, Node<T> *last) {
+    if (this == &other || first == nullptr || last == nullptr) return;
+    Node<T> *previous = first->getPreviousNode();
+    Node<T> *next = last->getNextNode();
+    int count = 0;
+    bool movesCursor = false;
+    for (Node<T> *node = first; node != next; node = node->getNextNode()) {
+        movesCursor = movesCursor || node == other.current;
+        ++count;
     }
+
+    if (previous != nullptr) previous->setNextNode(next);
+    else other.head = next;
+    if (next != nullptr) next->setPreviousNode(previous);
+    else other.tail = previous;
+    if (movesCursor) other.current = next != nullptr ? next : previous;
+    other.size -= count;
+
+    this->linkLast(first, last, count);
 }
 
 /**
- * @brief Desvincula un nodo intermedio mediante la reestructuración de enlaces adyacentes.
- * @param node Puntero al nodo que se desea extraer. Debe ser un nodo intermedio (no head ni tail).
+ * @brief Desvincula un nodo de la lista en O(1).
+ * Si el cursor apuntaba al nodo, pasa al siguiente (o al anterior si era la cola).
+ * @param node Nodo que pertenece a esta lista.
+ * @return El mismo nodo, sin enlaces (el usuario es responsable de su memoria); nullptr si @p node es nulo.
  */
 template<typename T>
-void ArrayList<T>::removeMiddle(Node<T> *node) {
-    Node<T> *tempNext = node->getNextNode();
-    Node<T> *tempPrevious = node->getPreviousNode();
-    tempPrevious->setNextNode(tempNext);
-    tempNext->setPreviousNode(tempPrevious);
-    if (this->current == node) this->current = tempNext;
+Node<T>* ArrayList<T>::removeNode(Node<T> *node) {
+    if (node == nullptr) return nullptr;
+    Node<T> *previous = node->getPreviousNode();
+    Node<T> *next = node->getNextNode();
+
+    if (previous != nullptr) previous->setNextNode(next);
+    else this->head = next;
+    if (next != nullptr) next->setPreviousNode(previous);
+    else this->tail = previous;
+    if (this->current == node) this->current = next != nullptr ? next : previous;
     --this->size;
+
+    node->setNextNode(nullptr);
+    node->setPreviousNode(nullptr);
+    return node;
 }
 
 /**
  * @brief Elimina y retorna un nodo en un índice específico.
+ * Localizar el índice cuesta O(n); si ya se tiene el nodo, removeNode() es O(1).
  * @param index Posición del elemento a eliminar.
  * @return El puntero al nodo eliminado (el usuario es responsable de su memoria).
  */
 template<typename T>
 Node<T>* ArrayList<T>::remove(int index) {
-    Node<T> *temp = this->get(index);
-    if (temp == nullptr) return nullptr;
-    if (index == 1) this->shift();
-    else if (index == this->size) this->unshift();
-    else this->removeMiddle(temp);
-
-    temp->setNextNode(nullptr);
-    temp->setPreviousNode(nullptr);
-    return temp;
+    return this->removeNode(this->get(index));
 }
 
 /**
@@ -288,7 +423,7 @@ Node<T>* ArrayList<T>::remove(int index) {
  */
 template<typename T>
 Node<T> *ArrayList<T>::removeFirst() {
-    return this->remove(1);
+    return this->removeNode(this->head);
 }
 
 /**
@@ -297,7 +432,37 @@ Node<T> *ArrayList<T>::removeFirst() {
  */
 template<typename T>
 Node<T> *ArrayList<T>::removeLast() {
-    return this->remove(this->size);
+    return this->removeNode(this->tail);
+}
+
+/**
+ * @brief Ordena la lista de forma estable sin mover los datos.
+ * * Copia los punteros a los nodos en un arreglo contiguo, los ordena con std::stable_sort
+ * (merge sort) y reenlaza la lista en una sola pasada. Los datos nunca se copian y los
+ * punteros a nodos siguen siendo válidos, incluido el cursor.
+ * @param compare Orden estricto débil sobre T.
+ */
+template<typename T>
+template<typename Compare>
+void ArrayList<T>::sort(Compare compare) {
+    if (this->size < 2) return;
+    std::vector<Node<T>*> nodes;
+    nodes.reserve(static_cast<size_t>(this->size));
+    for (Node<T> *node = this->head; node != nullptr; node = node->getNextNode()) nodes.push_back(node);
+
+    std::stable_sort(nodes.begin(), nodes.end(), [&compare](const Node<T>* left, const Node<T>* right) {
+        return compare(left->getDataRef(), right->getDataRef());
+    });
+
+    Node<T> *previous = nullptr;
+    for (Node<T> *node : nodes) {
+        node->setPreviousNode(previous);
+        if (previous != nullptr) previous->setNextNode(node);
+        previous = node;
+    }
+    previous->setNextNode(nullptr);
+    this->head = nodes.front();
+    this->tail = previous;
 }
 
 /**
@@ -322,17 +487,32 @@ int ArrayList<T>::getSize() const {
     return this->size;
 }
 
+/**
+ * @brief Calcula la memoria ocupada por la lista.
+ * @return Bytes de los nodos enlazados y bytes de heap reservados por los datos (p. ej. cadenas).
+ */
+template<typename T>
+MemoryFootprint ArrayList<T>::footprint() const {
+    MemoryFootprint usage;
+    usage.nodeBytes = static_cast<size_t>(this->size) * sizeof(Node<T>);
+    Node<T> *temp = this->head;
+    while (temp != nullptr) {
+        usage.stringBytes += heapBytes(temp->getDataRef());
+        temp = temp->getNextNode();
+    }
+    return usage;
+}
+
 /**
  * @brief Realiza una búsqueda lineal para determinar la existencia de un valor.
+ * Compara por referencia, sin copiar el valor buscado ni el contenido de los nodos.
  * @param data Valor de tipo T a comparar con el contenido de cada nodo.
  * @return true si existe al menos una coincidencia; false si se recorre toda la lista sin éxito.
  */
 template<typename T>
-bool ArrayList<T>::has(T data) {
-    Node<T>* tempNode = this->head;
-    for (int i = 0; i < this->size; i++) {
-        if (data == tempNode->getData()) return true;
-        tempNode = tempNode->getNextNode();
+bool ArrayList<T>::has(const T &data) const {
+    for (Node<T>* tempNode = this->head; tempNode != nullptr; tempNode = tempNode->getNextNode()) {
+        if (data == tempNode->getDataRef()) return true;
     }
     return false;
 }
@@ -344,15 +524,6 @@ bool ArrayList<T>::has(T data) {
  */
 template<typename T>
 ArrayList<T>::~ArrayList() {
-    Node<T> *temp = this->head;
-    while (temp != nullptr) {
-        Node<T> *next = temp->getNextNode();
-        delete temp;
-        temp = next;
-    }
-    this->head = nullptr;
-    this->tail = nullptr;
-    this->current = nullptr;
-    this->size = 0;
+    this->clear();
 }
 #endif
\ No newline at end of file
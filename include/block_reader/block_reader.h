@@ -0,0 +1,428 @@
+#ifndef BLOCK_READER_H
+#define BLOCK_READER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "../instrumentation/instrumentation.h"
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MINI_COMPILER_POSIX_IO 1
+#endif
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define MINI_COMPILER_IO_URING 1
+#endif
+#endif
+
+/**
+ * @brief Mecanismo usado para leer los bloques del archivo.
+ */
+enum class ReadBackend {
+    AUTO,
+    IO_URING,
+    PREAD
+};
+
+/**
+ * @brief Lector secuencial de archivos en bloques grandes y alineados.
+ * * Sustituye a std::getline sobre un ifstream: en lugar de una lectura pequeña y una cadena
+ * por línea, entrega bloques de @c blockSize bytes sobre dos búferes alineados a página.
+ * - Con io_uring (Linux, sin liburing: llamadas al sistema directas) la lectura del bloque
+ * siguiente ya está en curso mientras el consumidor procesa el actual.
+ * - Con pread, posix_fadvise anuncia acceso secuencial y solicita por adelantado el bloque
+ * siguiente al núcleo (WILLNEED), que lo lee en segundo plano.
+ * * El modo AUTO intenta io_uring y recurre a pread si el núcleo no lo admite o lo rechaza.
+ */
+class BlockReader {
+
+    private:
+        static const size_t ALIGNMENT = 4096;
+        int fd = -1;
+        size_t blockSize;
+        long long fileSize = 0;
+        long long nextOffset = 0;
+        char* buffers[2] = {nullptr, nullptr};
+        size_t lengths[2] = {0, 0};
+        bool ready[2] = {false, false};
+        bool inFlight[2] = {false, false};
+        int current = -1;
+        int error = 0;
+        ReadBackend backend = ReadBackend::PREAD;
+#if defined(MINI_COMPILER_IO_URING)
+        int ringFd = -1;
+        void* sqRing = nullptr;
+        void* cqRing = nullptr;
+        size_t sqRingSize = 0;
+        size_t cqRingSize = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqesSize = 0;
+        unsigned* sqTail = nullptr;
+        unsigned* sqMask = nullptr;
+        unsigned* sqArray = nullptr;
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        unsigned* cqMask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        bool setupRing();
+        void closeRing();
+        bool submitRead(int slot);
+        bool reapOne();
+#endif
+        bool readSync(char* buffer, long long offset, size_t &length);
+        bool fail(int code);
+        bool fillSlot(int slot);
+        void release();
+
+    public:
+        explicit BlockReader(const std::string &path, size_t blockSize = 1 << 20,
+                             ReadBackend backend = ReadBackend::AUTO);
+        BlockReader(const BlockReader&) = delete;
+        BlockReader& operator=(const BlockReader&) = delete;
+        ~BlockReader();
+        bool isOpen() const;
+        ReadBackend getBackend() const;
+        long long getFileSize() const;
+        bool next(const char* &data, size_t &length);
+        bool failed() const;
+        int getError() const;
+        static bool dropCache(const std::string &path);
+};
+
+/**
+ * @brief Abre el archivo y prepara los búferes y, si procede, el anillo de io_uring.
+ * @param path Ruta del archivo.
+ * @param blockSize Tamaño de cada lectura; se redondea a múltiplo de 4 KiB.
+ * @param backend Mecanismo de lectura preferido.
+ * @note Si el archivo no puede abrirse, isOpen() devuelve false y next() no entrega bloques.
+ */
+inline BlockReader::BlockReader(const std::string &path, const size_t blockSize, const ReadBackend backend)
+    : blockSize(blockSize < ALIGNMENT ? ALIGNMENT : (blockSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT) {
+#if defined(MINI_COMPILER_POSIX_IO)
+    this->fd = ::open(path.c_str(), O_RDONLY);
+    if (this->fd < 0) return;
+    struct stat info{};
+    if (fstat(this->fd, &info) == 0) this->fileSize = static_cast<long long>(info.st_size);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    posix_fadvise(this->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    for (char* &buffer : this->buffers) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, ALIGNMENT, this->blockSize) != 0) {
+            this->release();
+            return;
+        }
+        buffer = static_cast<char*>(memory);
+    }
+#if defined(MINI_COMPILER_IO_URING)
+    if (backend != ReadBackend::PREAD && this->setupRing()) this->backend = ReadBackend::IO_URING;
+#endif
+#else
+    (void)path;
+#endif
+    (void)backend;
+}
+
+inline BlockReader::~BlockReader() {
+    this->release();
+}
+
+/**
+ * @brief Espera las lecturas pendientes y libera el anillo, los búferes y el descriptor.
+ */
+inline void BlockReader::release() {
+#if defined(MINI_COMPILER_IO_URING)
+    while ((this->inFlight[0] || this->inFlight[1]) && this->reapOne()) {}
+    this->closeRing();
+#endif
+    for (char* &buffer : this->buffers) {
+        std::free(buffer);
+        buffer = nullptr;
+    }
+#if defined(MINI_COMPILER_POSIX_IO)
+    if (this->fd >= 0) ::close(this->fd);
+#endif
+    this->fd = -1;
+}
+
+inline bool BlockReader::isOpen() const {
+    return this->fd >= 0 && this->buffers[1] != nullptr;
+}
+
+/**
+ * @brief Mecanismo efectivamente en uso tras la apertura (nunca AUTO).
+ */
+inline ReadBackend BlockReader::getBackend() const {
+    return this->backend;
+}
+
+inline long long BlockReader::getFileSize() const {
+    return this->fileSize;
+}
+
+/**
+ * @brief Indica si la lectura se interrumpió por un error; next() devuelve entonces false
+ * igual que al final del archivo.
+ */
+inline bool BlockReader::failed() const {
+    return this->error != 0;
+}
+
+/**
+ * @brief Código errno del error de lectura, o 0 si no hubo ninguno.
+ */
+inline int BlockReader::getError() const {
+    return this->error;
+}
+
+/**
+ * @brief Registra un error de lectura; next() deja de entregar bloques.
+ */
+inline bool BlockReader::fail(const int code) {
+    if (this->error == 0) this->error = code != 0 ? code : EIO;
+    return false;
+}
+
+/**
+ * @brief Lectura síncrona de un bloque completo, reintentando lecturas cortas.
+ * @param buffer Búfer destino de @c blockSize bytes.
+ * @param offset Posición del bloque en el archivo.
+ * @param[in,out] length Bytes ya presentes en el búfer; recibe el tamaño final del bloque.
+ * @return false si la lectura falla; el error queda registrado en getError().
+ */
+inline bool BlockReader::readSync(char* buffer, const long long offset, size_t &length) {
+#if defined(MINI_COMPILER_POSIX_IO)
+    while (length < this->blockSize) {
+        const ssize_t read = pread(this->fd, buffer + length, this->blockSize - length,
+                                   static_cast<off_t>(offset + static_cast<long long>(length)));
+        if (read < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+        if (read < 0) return this->fail(errno);
+        if (read == 0) break;
+        length += static_cast<size_t>(read);
+    }
+    return true;
+#else
+    (void)buffer;
+    (void)offset;
+    (void)length;
+    return this->fail(ENOSYS);
+#endif
+}
+
+/**
+ * @brief Deja en @c slot el siguiente bloque del archivo usando pread y pide el posterior por adelantado.
+ */
+inline bool BlockReader::fillSlot(const int slot) {
+    size_t length = 0;
+    if (!this->readSync(this->buffers[slot], this->nextOffset, length)) return false;
+    this->lengths[slot] = length;
+    this->ready[slot] = true;
+    this->nextOffset += static_cast<long long>(length);
+#if defined(MINI_COMPILER_POSIX_IO) && defined(POSIX_FADV_WILLNEED)
+    if (this->nextOffset < this->fileSize) {
+        posix_fadvise(this->fd, static_cast<off_t>(this->nextOffset), static_cast<off_t>(this->blockSize),
+                      POSIX_FADV_WILLNEED);
+    }
+#endif
+    return true;
+}
+
+/**
+ * @brief Entrega el siguiente bloque del archivo.
+ * * El bloque anterior deja de ser válido en cuanto se vuelve a llamar a next(), ya que su
+ * búfer se reutiliza para la lectura por adelantado.
+ * @param[out] data Inicio del bloque.
+ * @param[out] length Bytes válidos del bloque.
+ * @return false al llegar al final del archivo o ante un error de lectura; failed() los distingue.
+ */
+inline bool BlockReader::next(const char* &data, size_t &length) {
+    INSTRUMENT_SCOPE("BlockReader::next");
+    if (!this->isOpen() || this->failed()) return false;
+    const int slot = this->current < 0 ? 0 : 1 - this->current;
+    if (this->current >= 0) this->ready[this->current] = false;
+
+#if defined(MINI_COMPILER_IO_URING)
+    if (this->backend == ReadBackend::IO_URING) {
+        if (!this->ready[slot] && !this->inFlight[slot] && !this->submitRead(slot)) return false;
+        const int other = 1 - slot;
+        if (!this->ready[other] && !this->inFlight[other] && !this->submitRead(other)) return false;
+    }
+    while (this->inFlight[slot]) {
+        if (!this->reapOne()) return false;
+    }
+#endif
+    if (!this->ready[slot] && !this->fillSlot(slot)) return false;
+
+    this->current = slot;
+    if (!this->ready[slot] || this->lengths[slot] == 0) return false;
+    data = this->buffers[slot];
+    length = this->lengths[slot];
+    INSTRUMENT_COUNT(Counter::BYTES_READ, static_cast<long long>(length));
+    return true;
+}
+
+/**
+ * @brief Pide al núcleo que descarte las páginas en caché del archivo (para medir en frío).
+ * @param path Ruta del archivo.
+ * @return false si la plataforma no lo permite o el archivo no existe.
+ */
+inline bool BlockReader::dropCache(const std::string &path) {
+#if defined(MINI_COMPILER_POSIX_IO) && defined(POSIX_FADV_DONTNEED)
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+    fdatasync(file);
+    const bool dropped = posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(file);
+    return dropped;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+#if defined(MINI_COMPILER_IO_URING)
+
+/**
+ * @brief Crea un anillo de io_uring de dos entradas y mapea sus colas.
+ * @return false si el núcleo no admite io_uring (o lo bloquea); el lector usa entonces pread.
+ */
+inline bool BlockReader::setupRing() {
+    io_uring_params params{};
+    this->ringFd = static_cast<int>(syscall(__NR_io_uring_setup, 2, &params));
+    if (this->ringFd < 0) {
+        this->ringFd = -1;
+        return false;
+    }
+
+    this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) this->sqRingSize = this->cqRingSize = std::max(this->sqRingSize, this->cqRingSize);
+
+    this->sqRing = mmap(nullptr, this->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        this->ringFd, IORING_OFF_SQ_RING);
+    if (this->sqRing == MAP_FAILED) {
+        this->sqRing = nullptr;
+        this->closeRing();
+        return false;
+    }
+    if (singleMmap) {
+        this->cqRing = this->sqRing;
+    } else {
+        this->cqRing = mmap(nullptr, this->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            this->ringFd, IORING_OFF_CQ_RING);
+        if (this->cqRing == MAP_FAILED) {
+            this->cqRing = nullptr;
+            this->closeRing();
+            return false;
+        }
+    }
+    this->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* entries = mmap(nullptr, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         this->ringFd, IORING_OFF_SQES);
+    if (entries == MAP_FAILED) {
+        this->closeRing();
+        return false;
+    }
+    this->sqes = static_cast<io_uring_sqe*>(entries);
+
+    char* sq = static_cast<char*>(this->sqRing);
+    char* cq = static_cast<char*>(this->cqRing);
+    this->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    this->sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    this->sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    this->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    this->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    this->cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    this->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+inline void BlockReader::closeRing() {
+    if (this->sqes != nullptr) munmap(this->sqes, this->sqesSize);
+    if (this->cqRing != nullptr && this->cqRing != this->sqRing) munmap(this->cqRing, this->cqRingSize);
+    if (this->sqRing != nullptr) munmap(this->sqRing, this->sqRingSize);
+    if (this->ringFd >= 0) ::close(this->ringFd);
+    this->sqes = nullptr;
+    this->sqRing = this->cqRing = nullptr;
+    this->ringFd = -1;
+}
+
+/**
+ * @brief Encola la lectura asíncrona del siguiente bloque del archivo en @c slot.
+ * * Al llegar al final del archivo no se encola nada y el bloque queda marcado como vacío. Si
+ * el núcleo rechaza el envío, el lector pasa a pread y el bloque se leerá de forma síncrona.
+ */
+inline bool BlockReader::submitRead(const int slot) {
+    this->lengths[slot] = 0;
+    if (this->nextOffset >= this->fileSize) {
+        this->ready[slot] = true;
+        return true;
+    }
+    const unsigned tail = *this->sqTail;
+    const unsigned index = tail & *this->sqMask;
+    io_uring_sqe &entry = this->sqes[index];
+    std::memset(&entry, 0, sizeof(entry));
+    entry.opcode = IORING_OP_READ;
+    entry.fd = this->fd;
+    entry.off = static_cast<unsigned long long>(this->nextOffset);
+    entry.addr = reinterpret_cast<unsigned long long>(this->buffers[slot]);
+    entry.len = static_cast<unsigned>(this->blockSize);
+    entry.user_data = static_cast<unsigned long long>(slot) | static_cast<unsigned long long>(this->nextOffset) << 1;
+    this->sqArray[index] = index;
+    __atomic_store_n(this->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    if (syscall(__NR_io_uring_enter, this->ringFd, 1, 0, 0, nullptr, 0) < 0) {
+        __atomic_store_n(this->sqTail, tail, __ATOMIC_RELEASE);
+        this->backend = ReadBackend::PREAD;
+        return true;
+    }
+    this->inFlight[slot] = true;
+    this->ready[slot] = false;
+    this->nextOffset += static_cast<long long>(this->blockSize);
+    return true;
+}
+
+/**
+ * @brief Espera y procesa una finalización del anillo.
+ * * Una lectura corta que no alcanza el final del archivo se completa con pread, y una lectura
+ * fallida se repite entera con pread, que reintenta EINTR y EAGAIN; si el núcleo rechaza la
+ * operación (p. ej. IORING_OP_READ no disponible), el lector pasa además a usar pread en adelante.
+ * Solo un error de pread, o de la propia espera, se registra como error de lectura.
+ */
+inline bool BlockReader::reapOne() {
+    unsigned head = *this->cqHead;
+    while (head == __atomic_load_n(this->cqTail, __ATOMIC_ACQUIRE)) {
+        if (syscall(__NR_io_uring_enter, this->ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR) {
+            return this->fail(errno);
+        }
+    }
+    const io_uring_cqe &completion = this->cqes[head & *this->cqMask];
+    const int slot = static_cast<int>(completion.user_data & 1);
+    const long long offset = static_cast<long long>(completion.user_data >> 1);
+    const int result = completion.res;
+    __atomic_store_n(this->cqHead, head + 1, __ATOMIC_RELEASE);
+
+    this->inFlight[slot] = false;
+    size_t length = result > 0 ? static_cast<size_t>(result) : 0;
+    if (result == -EINVAL || result == -EOPNOTSUPP) this->backend = ReadBackend::PREAD;
+    if (offset + static_cast<long long>(length) < this->fileSize && length < this->blockSize &&
+        !this->readSync(this->buffers[slot], offset, length)) {
+        return false;
+    }
+    this->lengths[slot] = length;
+    this->ready[slot] = true;
+    return true;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef BUILTIN_FUNCTIONS_H
+#define BUILTIN_FUNCTIONS_H
+
+#include <cmath>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief Función matemática invocable desde una expresión.
+ * @note @c apply recibe los argumentos en orden de aparición.
+ */
+struct BuiltinFunction {
+    const char* name;
+    int arity;
+    double (*apply)(const double* args);
+};
+
+/**
+ * @brief Registro de funciones predefinidas, despachadas por una tabla de punteros a función.
+ * * El índice de una función es estable: los programas compilados lo guardan como operando de
+ * OpCode::CALL y lo usan para llamar a la función sin volver a buscarla por nombre.
+ */
+class BuiltinFunctions {
+
+    private:
+        static const BuiltinFunction* table(size_t &count);
+
+    public:
+        static const int MAX_ARITY = 2;
+        static int find(const std::string &name);
+        static const BuiltinFunction &get(int index);
+        static size_t size();
+};
+
+inline const BuiltinFunction* BuiltinFunctions::table(size_t &count) {
+    static const BuiltinFunction functions[] = {
+        {"sqrt", 1, [](const double* a) { return std::sqrt(a[0]); }},
+        {"abs", 1, [](const double* a) { return std::fabs(a[0]); }},
+        {"floor", 1, [](const double* a) { return std::floor(a[0]); }},
+        {"ceil", 1, [](const double* a) { return std::ceil(a[0]); }},
+        {"round", 1, [](const double* a) { return std::round(a[0]); }},
+        {"exp", 1, [](const double* a) { return std::exp(a[0]); }},
+        {"log", 1, [](const double* a) { return std::log(a[0]); }},
+        {"log10", 1, [](const double* a) { return std::log10(a[0]); }},
+        {"sin", 1, [](const double* a) { return std::sin(a[0]); }},
+        {"cos", 1, [](const double* a) { return std::cos(a[0]); }},
+        {"tan", 1, [](const double* a) { return std::tan(a[0]); }},
+        {"asin", 1, [](const double* a) { return std::asin(a[0]); }},
+        {"acos", 1, [](const double* a) { return std::acos(a[0]); }},
+        {"atan", 1, [](const double* a) { return std::atan(a[0]); }},
+        {"pow", 2, [](const double* a) { return std::pow(a[0], a[1]); }},
+        {"atan2", 2, [](const double* a) { return std::atan2(a[0], a[1]); }},
+        {"hypot", 2, [](const double* a) { return std::hypot(a[0], a[1]); }},
+        {"fmod", 2, [](const double* a) { return std::fmod(a[0], a[1]); }},
+        {"min", 2, [](const double* a) { return a[1] < a[0] ? a[1] : a[0]; }},
+        {"max", 2, [](const double* a) { return a[0] < a[1] ? a[1] : a[0]; }},
+    };
+    count = sizeof(functions) / sizeof(functions[0]);
+    return functions;
+}
+
+/**
+ * @brief Busca una función por nombre.
+ * @return Índice en el registro; -1 si no existe.
+ */
+inline int BuiltinFunctions::find(const std::string &name) {
+    size_t count = 0;
+    const BuiltinFunction* functions = table(count);
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(functions[i].name, name.c_str()) == 0) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/**
+ * @param index Índice devuelto por find(); no se valida.
+ */
+inline const BuiltinFunction &BuiltinFunctions::get(const int index) {
+    size_t count = 0;
+    return table(count)[index];
+}
+
+inline size_t BuiltinFunctions::size() {
+    size_t count = 0;
+    table(count);
+    return count;
+}
+
+#endif
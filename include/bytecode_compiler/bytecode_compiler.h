@@ -0,0 +1,571 @@
+#ifndef BYTECODE_COMPILER_H
+#define BYTECODE_COMPILER_H
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+#include "../instrumentation/instrumentation.h"
+#include "../../interface/bytecode.h"
+
+/**
+ * @brief Traduce un ProgramStruct a código de registros para BytecodeVm.
+ * * Cada variable ocupa la ranura con su índice en ProgramStruct::variables, así que en
+ * ejecución no se busca ningún nombre. Las constantes tienen ranuras propias, cargadas una sola
+ * vez en el marco inicial, y los temporales se asignan como una pila: al terminar una
+ * subexpresión se liberan los de sus hijos. Mientras se compila, las ranuras de constantes y
+ * temporales llevan las marcas CONSTANT y TEMPORARY y al final se reubican tras las variables.
+ * * Los tipos ya los fijó ProgramParser, por lo que cada operación se emite con su variante
+ * INT, DOUBLE o de cadena y las conversiones son explícitas, igual que en IrBuilder.
+ * Las condiciones se compilan a saltos: `&&`, `||` y `!` no calculan un 0 o 1 intermedio y
+ * una comparación entera se funde con su salto. Los bucles evalúan la condición al final del
+ * cuerpo, con un único salto por vuelta.
+ */
+class BytecodeCompiler {
+
+    private:
+        static constexpr uint32_t TEMPORARY = 0x40000000u;
+        static constexpr uint32_t CONSTANT = 0x80000000u;
+        static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+        struct Loop {
+            std::vector<size_t> breaks;
+            std::vector<size_t> continues;
+        };
+
+        const ProgramStruct &program;
+        BytecodeProgram result;
+        std::vector<uint32_t> arrayOf;
+        std::map<std::pair<int, uint64_t>, uint32_t> constants;
+        std::vector<Value> constantValues;
+        std::vector<std::string> constantTexts;
+        std::vector<Loop> loops;
+        uint32_t top = 0;
+        uint32_t maxTemporaries = 0;
+        bool copyVariables = false;
+
+        explicit BytecodeCompiler(const ProgramStruct &program);
+        size_t emit(VmOp op, uint32_t target, uint32_t left = 0, uint32_t right = 0, uint16_t function = 0);
+        void patch(const std::vector<size_t> &jumps, size_t target);
+        uint32_t temporary();
+        uint32_t constant(ValueType type, int64_t integer, double real);
+        uint32_t text(int32_t index);
+        const ExpressionNode &node(int32_t index) const;
+        bool hasStep(int32_t index) const;
+        static VmOp arithmetic(OpCode op, ValueType type);
+        static bool invert(OpCode op, OpCode &inverse);
+        uint32_t convert(uint32_t slot, ValueType from, ValueType to);
+        uint32_t operand(int32_t index, ValueType type);
+        void into(int32_t index, uint32_t slot, ValueType type);
+        uint32_t expression(int32_t index, uint32_t destination = NONE);
+        uint32_t step(const ExpressionNode &node, bool discard);
+        void condition(int32_t index, bool when, std::vector<size_t> &jumps);
+        void statement(int32_t index);
+        void loop(int32_t body, int32_t stepStatement, int32_t expression);
+        void relocate();
+
+    public:
+        static BytecodeProgram compile(const ProgramStruct &program);
+};
+
+inline BytecodeCompiler::BytecodeCompiler(const ProgramStruct &program) : program(program) {}
+
+/**
+ * @brief Compila un programa analizado.
+ * @param program Árbol de ProgramParser::parse().
+ * @return Código, marco inicial y descripción de variables y arreglos.
+ */
+inline BytecodeProgram BytecodeCompiler::compile(const ProgramStruct &program) {
+    INSTRUMENT_SCOPE("compileBytecode");
+    BytecodeCompiler compiler(program);
+    compiler.result.variables = program.variables;
+    compiler.arrayOf.assign(program.variables.size(), NONE);
+    for (size_t i = 0; i < program.variables.size(); i++) {
+        if (!program.variables[i].array) continue;
+        compiler.arrayOf[i] = static_cast<uint32_t>(compiler.result.arrays.size());
+        compiler.result.arrays.push_back(static_cast<int32_t>(i));
+    }
+    if (program.root >= 0) compiler.statement(program.root);
+    compiler.emit(VmOp::RETURN, 0);
+    compiler.relocate();
+    return std::move(compiler.result);
+}
+
+inline size_t BytecodeCompiler::emit(const VmOp op, const uint32_t target, const uint32_t left, const uint32_t right,
+                                     const uint16_t function) {
+    this->result.code.push_back(VmInstruction{op, function, target, left, right});
+    return this->result.code.size() - 1;
+}
+
+/**
+ * @brief Completa el destino de saltos ya emitidos.
+ */
+inline void BytecodeCompiler::patch(const std::vector<size_t> &jumps, const size_t target) {
+    for (const size_t jump : jumps) this->result.code[jump].target = static_cast<uint32_t>(target);
+}
+
+inline uint32_t BytecodeCompiler::temporary() {
+    const uint32_t slot = TEMPORARY | this->top++;
+    if (this->top > this->maxTemporaries) this->maxTemporaries = this->top;
+    return slot;
+}
+
+/**
+ * @brief Ranura de una constante numérica; las repetidas comparten ranura.
+ */
+inline uint32_t BytecodeCompiler::constant(const ValueType type, const int64_t integer, const double real) {
+    uint64_t bits = static_cast<uint64_t>(integer);
+    if (type == ValueType::DOUBLE) std::memcpy(&bits, &real, sizeof(bits));
+    const auto key = std::make_pair(static_cast<int>(type), bits);
+    const auto found = this->constants.find(key);
+    if (found != this->constants.end()) return found->second;
+
+    Value value;
+    value.type = type;
+    if (type == ValueType::DOUBLE) value.real = real;
+    else value.integer = integer;
+    const uint32_t slot = CONSTANT | static_cast<uint32_t>(this->constantValues.size());
+    this->constantValues.push_back(value);
+    this->constantTexts.emplace_back();
+    this->constants.emplace(key, slot);
+    return slot;
+}
+
+/**
+ * @brief Ranura constante con el literal @p index de ProgramStruct::strings; -1 es la cadena vacía.
+ */
+inline uint32_t BytecodeCompiler::text(const int32_t index) {
+    const auto key = std::make_pair(static_cast<int>(ValueType::STRING), static_cast<uint64_t>(static_cast<int64_t>(index)));
+    const auto found = this->constants.find(key);
+    if (found != this->constants.end()) return found->second;
+
+    Value value;
+    value.type = ValueType::STRING;
+    const uint32_t slot = CONSTANT | static_cast<uint32_t>(this->constantValues.size());
+    this->constantValues.push_back(value);
+    this->constantTexts.push_back(index >= 0 ? this->program.strings[static_cast<size_t>(index)] : std::string());
+    this->constants.emplace(key, slot);
+    return slot;
+}
+
+inline const ExpressionNode &BytecodeCompiler::node(const int32_t index) const {
+    return this->program.expressions[static_cast<size_t>(index)];
+}
+
+/**
+ * @brief Indica si la expresión contiene `++` o `--`.
+ * En ese caso las variables se copian a temporales al leerse, para que un incremento posterior
+ * en la misma expresión no cambie un operando ya evaluado.
+ */
+inline bool BytecodeCompiler::hasStep(const int32_t index) const {
+    if (index < 0) return false;
+    const ExpressionNode &expression = this->node(index);
+    if (expression.kind == ExpressionKind::STEP) return true;
+    return this->hasStep(expression.left) || this->hasStep(expression.right) || this->hasStep(expression.extra);
+}
+
+/**
+ * @brief Variante tipada de un operador aritmético o de comparación.
+ * @param type Tipo común de los operandos.
+ */
+inline VmOp BytecodeCompiler::arithmetic(const OpCode op, const ValueType type) {
+    if (type == ValueType::STRING) return op == OpCode::ADD ? VmOp::CONCAT : op == OpCode::EQ ? VmOp::EQ_STRING : VmOp::NE_STRING;
+    const bool integer = type == ValueType::INT;
+    switch (op) {
+        case OpCode::ADD: return integer ? VmOp::ADD_INT : VmOp::ADD_DOUBLE;
+        case OpCode::SUB: return integer ? VmOp::SUB_INT : VmOp::SUB_DOUBLE;
+        case OpCode::MUL: return integer ? VmOp::MUL_INT : VmOp::MUL_DOUBLE;
+        case OpCode::DIV: return integer ? VmOp::DIV_INT : VmOp::DIV_DOUBLE;
+        case OpCode::MOD: return integer ? VmOp::MOD_INT : VmOp::MOD_DOUBLE;
+        case OpCode::EQ: return integer ? VmOp::EQ_INT : VmOp::EQ_DOUBLE;
+        case OpCode::NE: return integer ? VmOp::NE_INT : VmOp::NE_DOUBLE;
+        case OpCode::LT: return integer ? VmOp::LT_INT : VmOp::LT_DOUBLE;
+        case OpCode::GT: return integer ? VmOp::GT_INT : VmOp::GT_DOUBLE;
+        case OpCode::LE: return integer ? VmOp::LE_INT : VmOp::LE_DOUBLE;
+        case OpCode::GE: return integer ? VmOp::GE_INT : VmOp::GE_DOUBLE;
+        default: return VmOp::POW_DOUBLE;
+    }
+}
+
+/**
+ * @brief Comparación contraria (`<` y `>=`, ...), exacta entre enteros.
+ * @return false si @p op no es una comparación.
+ */
+inline bool BytecodeCompiler::invert(const OpCode op, OpCode &inverse) {
+    switch (op) {
+        case OpCode::EQ: inverse = OpCode::NE; return true;
+        case OpCode::NE: inverse = OpCode::EQ; return true;
+        case OpCode::LT: inverse = OpCode::GE; return true;
+        case OpCode::GE: inverse = OpCode::LT; return true;
+        case OpCode::GT: inverse = OpCode::LE; return true;
+        case OpCode::LE: inverse = OpCode::GT; return true;
+        default: return false;
+    }
+}
+
+inline uint32_t BytecodeCompiler::convert(const uint32_t slot, const ValueType from, const ValueType to) {
+    if (from == to || to == ValueType::STRING) return slot;
+    const uint32_t converted = this->temporary();
+    this->emit(to == ValueType::DOUBLE ? VmOp::TO_DOUBLE : VmOp::TO_INT, converted, slot);
+    return converted;
+}
+
+/**
+ * @brief Evalúa una subexpresión y la convierte al tipo de la operación que la usa.
+ */
+inline uint32_t BytecodeCompiler::operand(const int32_t index, const ValueType type) {
+    return this->convert(this->expression(index), this->node(index).type, type);
+}
+
+/**
+ * @brief Evalúa una expresión y deja su valor, convertido a @p type, en @p slot.
+ */
+inline void BytecodeCompiler::into(const int32_t index, const uint32_t slot, const ValueType type) {
+    const ValueType from = this->node(index).type;
+    const uint32_t mark = this->top;
+    const uint32_t value = this->expression(index, from == type && !this->copyVariables ? slot : NONE);
+    if (from != type && type != ValueType::STRING) {
+        this->emit(type == ValueType::DOUBLE ? VmOp::TO_DOUBLE : VmOp::TO_INT, slot, value);
+    } else if (value != slot) {
+        this->emit(type == ValueType::STRING ? VmOp::MOVE_STRING : VmOp::MOVE, slot, value);
+    }
+    this->top = mark;
+}
+
+/**
+ * @brief Compila una expresión.
+ * @param destination Ranura donde dejar el resultado si conviene; NONE para un temporal.
+ * @return Ranura con el resultado: @p destination, un temporal, una constante o una variable.
+ */
+inline uint32_t BytecodeCompiler::expression(const int32_t index, const uint32_t destination) {
+    const ExpressionNode &expression = this->node(index);
+    const uint32_t mark = this->top;
+    const auto output = [this, mark, destination]() {
+        this->top = mark;
+        return destination != NONE ? destination : this->temporary();
+    };
+
+    switch (expression.kind) {
+        case ExpressionKind::NUMBER:
+            return this->constant(expression.type, expression.type == ValueType::INT ? expression.number.integer : 0,
+                                  expression.number.asDouble());
+        case ExpressionKind::STRING:
+            return this->text(expression.symbol);
+        case ExpressionKind::VARIABLE: {
+            const uint32_t slot = static_cast<uint32_t>(expression.symbol);
+            if (!this->copyVariables) return slot;
+            const uint32_t copy = output();
+            this->emit(expression.type == ValueType::STRING ? VmOp::MOVE_STRING : VmOp::MOVE, copy, slot);
+            return copy;
+        }
+        case ExpressionKind::INDEX: {
+            const uint32_t position = this->expression(expression.right);
+            const uint32_t target = output();
+            this->emit(expression.type == ValueType::STRING ? VmOp::ARRAY_LOAD_STRING : VmOp::ARRAY_LOAD, target,
+                       this->arrayOf[static_cast<size_t>(expression.symbol)], position);
+            return target;
+        }
+        case ExpressionKind::UNARY: {
+            const ValueType type = this->node(expression.left).type;
+            const uint32_t value = this->expression(expression.left);
+            const uint32_t target = output();
+            if (expression.op == OpCode::NOT) this->emit(type == ValueType::INT ? VmOp::NOT_INT : VmOp::NOT_DOUBLE, target, value);
+            else this->emit(type == ValueType::INT ? VmOp::NEG_INT : VmOp::NEG_DOUBLE, target, value);
+            return target;
+        }
+        case ExpressionKind::BINARY: {
+            const ValueType leftType = this->node(expression.left).type;
+            const ValueType rightType = this->node(expression.right).type;
+            const bool comparison = expression.op == OpCode::EQ || expression.op == OpCode::NE || expression.op == OpCode::LT ||
+                                    expression.op == OpCode::GT || expression.op == OpCode::LE || expression.op == OpCode::GE;
+            ValueType common = expression.type;
+            if (leftType == ValueType::STRING) common = ValueType::STRING;
+            else if (comparison) common = leftType == ValueType::INT && rightType == ValueType::INT ? ValueType::INT : ValueType::DOUBLE;
+            const uint32_t left = this->operand(expression.left, common);
+            const uint32_t right = this->operand(expression.right, common);
+            const uint32_t target = output();
+            this->emit(arithmetic(expression.op, common), target, left, right);
+            return target;
+        }
+        case ExpressionKind::AND:
+        case ExpressionKind::OR: {
+            const uint32_t target = output();
+            std::vector<size_t> decided;
+            this->condition(index, false, decided);
+            this->emit(VmOp::MOVE, target, this->constant(ValueType::INT, 1, 0));
+            const size_t skip = this->emit(VmOp::JUMP, 0);
+            this->patch(decided, this->result.code.size());
+            this->emit(VmOp::MOVE, target, this->constant(ValueType::INT, 0, 0));
+            this->patch({skip}, this->result.code.size());
+            this->top = target == destination ? mark : mark + 1;
+            return target;
+        }
+        case ExpressionKind::CONDITIONAL: {
+            const uint32_t target = output();
+            std::vector<size_t> otherwise;
+            this->condition(expression.extra, false, otherwise);
+            this->into(expression.left, target, expression.type);
+            const size_t skip = this->emit(VmOp::JUMP, 0);
+            this->patch(otherwise, this->result.code.size());
+            this->into(expression.right, target, expression.type);
+            this->patch({skip}, this->result.code.size());
+            this->top = target == destination ? mark : mark + 1;
+            return target;
+        }
+        case ExpressionKind::CALL: {
+            const uint32_t left = expression.left >= 0 ? this->operand(expression.left, ValueType::DOUBLE) : 0;
+            const uint32_t right = expression.right >= 0 ? this->operand(expression.right, ValueType::DOUBLE) : 0;
+            const uint32_t target = output();
+            this->emit(VmOp::CALL, target, left, right, static_cast<uint16_t>(expression.symbol));
+            return target;
+        }
+        case ExpressionKind::STEP:
+            return this->step(expression, false);
+    }
+    return this->constant(ValueType::INT, 0, 0);
+}
+
+/**
+ * @brief `++` y `--` sobre una variable o un elemento.
+ * @param discard Si el valor no se usa, sobre una variable basta con una suma.
+ * @return Ranura con el valor nuevo (prefijo) o el anterior (sufijo).
+ */
+inline uint32_t BytecodeCompiler::step(const ExpressionNode &node, const bool discard) {
+    const ExpressionNode &target = this->node(node.left);
+    const bool prefix = node.op == OpCode::PRE_INC || node.op == OpCode::PRE_DEC;
+    const VmOp op = node.op == OpCode::PRE_INC || node.op == OpCode::POST_INC
+                    ? (node.type == ValueType::INT ? VmOp::ADD_INT : VmOp::ADD_DOUBLE)
+                    : (node.type == ValueType::INT ? VmOp::SUB_INT : VmOp::SUB_DOUBLE);
+    const uint32_t one = this->constant(node.type, 1, 1.0);
+
+    if (target.kind == ExpressionKind::INDEX) {
+        const uint32_t array = this->arrayOf[static_cast<size_t>(target.symbol)];
+        const uint32_t position = this->expression(target.right);
+        const uint32_t before = this->temporary();
+        const uint32_t after = this->temporary();
+        this->emit(VmOp::ARRAY_LOAD, before, array, position);
+        this->emit(op, after, before, one);
+        this->emit(VmOp::ARRAY_STORE, array, position, after);
+        return prefix ? after : before;
+    }
+
+    const uint32_t slot = static_cast<uint32_t>(target.symbol);
+    if (discard) {
+        this->emit(op, slot, slot, one);
+        return slot;
+    }
+    const uint32_t copy = this->temporary();
+    if (!prefix) this->emit(VmOp::MOVE, copy, slot);
+    this->emit(op, slot, slot, one);
+    if (prefix) this->emit(VmOp::MOVE, copy, slot);
+    return copy;
+}
+
+/**
+ * @brief Compila una condición como saltos.
+ * @param when Valor de verdad con el que se salta.
+ * @param jumps Recibe los saltos emitidos, para completarlos con patch().
+ */
+inline void BytecodeCompiler::condition(const int32_t index, const bool when, std::vector<size_t> &jumps) {
+    const ExpressionNode &expression = this->node(index);
+    const uint32_t mark = this->top;
+    if (expression.kind == ExpressionKind::AND || expression.kind == ExpressionKind::OR) {
+        // a && b salta con falso si cualquiera es falso; con verdadero, solo si a y b lo son.
+        const bool shortValue = expression.kind == ExpressionKind::OR;
+        if (when == shortValue) {
+            this->condition(expression.left, when, jumps);
+            this->condition(expression.right, when, jumps);
+        } else {
+            std::vector<size_t> skip;
+            this->condition(expression.left, shortValue, skip);
+            this->condition(expression.right, when, jumps);
+            this->patch(skip, this->result.code.size());
+        }
+        return;
+    }
+    if (expression.kind == ExpressionKind::UNARY && expression.op == OpCode::NOT) {
+        this->condition(expression.left, !when, jumps);
+        return;
+    }
+
+    OpCode op = expression.op;
+    if (expression.kind == ExpressionKind::BINARY && this->node(expression.left).type == ValueType::INT &&
+        this->node(expression.right).type == ValueType::INT && invert(op, op)) {
+        if (when) op = expression.op;
+        const uint32_t left = this->expression(expression.left);
+        const uint32_t right = this->expression(expression.right);
+        VmOp jump;
+        switch (op) {
+            case OpCode::EQ: jump = VmOp::JUMP_IF_EQ_INT; break;
+            case OpCode::NE: jump = VmOp::JUMP_IF_NE_INT; break;
+            case OpCode::LT: jump = VmOp::JUMP_IF_LT_INT; break;
+            case OpCode::GT: jump = VmOp::JUMP_IF_GT_INT; break;
+            case OpCode::LE: jump = VmOp::JUMP_IF_LE_INT; break;
+            default: jump = VmOp::JUMP_IF_GE_INT; break;
+        }
+        jumps.push_back(this->emit(jump, 0, left, right));
+        this->top = mark;
+        return;
+    }
+
+    const uint32_t value = this->expression(index);
+    const bool integer = expression.type == ValueType::INT;
+    const VmOp jump = when ? (integer ? VmOp::JUMP_IF_TRUE : VmOp::JUMP_IF_TRUE_DOUBLE)
+                           : (integer ? VmOp::JUMP_IF_FALSE : VmOp::JUMP_IF_FALSE_DOUBLE);
+    jumps.push_back(this->emit(jump, 0, value));
+    this->top = mark;
+}
+
+inline void BytecodeCompiler::statement(const int32_t index) {
+    const StatementNode &node = this->program.statements[static_cast<size_t>(index)];
+    this->top = 0;
+    this->copyVariables = this->hasStep(node.value) || this->hasStep(node.index);
+    switch (node.kind) {
+        case StatementKind::DECLARE: {
+            const VariableInfo &variable = this->program.variables[static_cast<size_t>(node.target)];
+            const uint32_t slot = static_cast<uint32_t>(node.target);
+            if (variable.array) {
+                const uint32_t array = this->arrayOf[static_cast<size_t>(node.target)];
+                const uint32_t size = node.index >= 0 ? this->operand(node.index, ValueType::INT)
+                                                      : this->constant(ValueType::INT, node.count, 0);
+                this->emit(VmOp::ARRAY_NEW, array, size);
+                const VmOp store = variable.type == ValueType::STRING ? VmOp::ARRAY_STORE_STRING : VmOp::ARRAY_STORE;
+                for (int32_t i = 0; i < node.count; i++) {
+                    const int32_t item = this->program.items[static_cast<size_t>(node.first + i)];
+                    this->copyVariables = this->hasStep(item);
+                    const uint32_t mark = this->top;
+                    const uint32_t value = this->operand(item, variable.type);
+                    this->emit(store, array, this->constant(ValueType::INT, i, 0), value);
+                    this->top = mark;
+                }
+            } else if (node.value >= 0) {
+                this->into(node.value, slot, variable.type);
+            } else {
+                const uint32_t zero = variable.type == ValueType::STRING ? this->text(-1) : this->constant(variable.type, 0, 0.0);
+                this->emit(variable.type == ValueType::STRING ? VmOp::MOVE_STRING : VmOp::MOVE, slot, zero);
+            }
+            break;
+        }
+        case StatementKind::ASSIGN: {
+            const VariableInfo &variable = this->program.variables[static_cast<size_t>(node.target)];
+            if (node.index >= 0) {
+                const uint32_t position = this->expression(node.index);
+                const uint32_t value = this->operand(node.value, variable.type);
+                this->emit(variable.type == ValueType::STRING ? VmOp::ARRAY_STORE_STRING : VmOp::ARRAY_STORE,
+                           this->arrayOf[static_cast<size_t>(node.target)], position, value);
+            } else {
+                this->into(node.value, static_cast<uint32_t>(node.target), variable.type);
+            }
+            break;
+        }
+        case StatementKind::EXPRESSION: {
+            const ExpressionNode &expression = this->node(node.value);
+            if (expression.kind == ExpressionKind::STEP) this->step(expression, true);
+            else this->expression(node.value);
+            break;
+        }
+        case StatementKind::BLOCK:
+            for (int32_t i = 0; i < node.count; i++) this->statement(this->program.items[static_cast<size_t>(node.first + i)]);
+            break;
+        case StatementKind::IF: {
+            std::vector<size_t> otherwise;
+            this->condition(node.value, false, otherwise);
+            this->statement(node.body);
+            if (node.otherwise >= 0) {
+                const size_t skip = this->emit(VmOp::JUMP, 0);
+                this->patch(otherwise, this->result.code.size());
+                this->statement(node.otherwise);
+                this->patch({skip}, this->result.code.size());
+            } else {
+                this->patch(otherwise, this->result.code.size());
+            }
+            break;
+        }
+        case StatementKind::WHILE:
+            this->loop(node.body, -1, node.value);
+            break;
+        case StatementKind::FOR:
+            if (node.init >= 0) this->statement(node.init);
+            this->loop(node.body, node.step, node.value);
+            break;
+        case StatementKind::BREAK:
+            this->loops.back().breaks.push_back(this->emit(VmOp::JUMP, 0));
+            break;
+        case StatementKind::CONTINUE:
+            this->loops.back().continues.push_back(this->emit(VmOp::JUMP, 0));
+            break;
+        case StatementKind::RETURN:
+            if (node.value >= 0) this->emit(VmOp::RETURN_VALUE, 0, this->expression(node.value));
+            else this->emit(VmOp::RETURN, 0);
+            break;
+    }
+    this->top = 0;
+}
+
+/**
+ * @brief `while` y `for` con la condición al final: salto inicial a la condición, cuerpo,
+ * paso y un salto condicional de vuelta al cuerpo.
+ * @param body Sentencia del cuerpo.
+ * @param stepStatement Paso de un `for`; -1 si no hay.
+ * @param expression Condición; -1 para un bucle sin condición.
+ */
+inline void BytecodeCompiler::loop(const int32_t body, const int32_t stepStatement, const int32_t expression) {
+    const size_t entry = expression >= 0 ? this->emit(VmOp::JUMP, 0) : 0;
+    const size_t start = this->result.code.size();
+    this->loops.emplace_back();
+    this->statement(body);
+    Loop current = std::move(this->loops.back());
+    this->loops.pop_back();
+
+    this->patch(current.continues, this->result.code.size());
+    if (stepStatement >= 0) this->statement(stepStatement);
+    if (expression >= 0) {
+        this->patch({entry}, this->result.code.size());
+        this->copyVariables = this->hasStep(expression);
+        std::vector<size_t> repeat;
+        this->condition(expression, true, repeat);
+        this->patch(repeat, start);
+        this->top = 0;
+    } else {
+        this->emit(VmOp::JUMP, static_cast<uint32_t>(start));
+    }
+    this->patch(current.breaks, this->result.code.size());
+}
+
+/**
+ * @brief Coloca constantes y temporales tras las variables y arma el marco inicial.
+ */
+inline void BytecodeCompiler::relocate() {
+    const uint32_t constantBase = static_cast<uint32_t>(this->program.variables.size());
+    const uint32_t temporaryBase = constantBase + static_cast<uint32_t>(this->constantValues.size());
+    const auto place = [constantBase, temporaryBase](uint32_t &slot) {
+        if (slot & CONSTANT) slot = constantBase + (slot & ~CONSTANT);
+        else if (slot & TEMPORARY) slot = temporaryBase + (slot & ~TEMPORARY);
+    };
+    for (VmInstruction &instruction : this->result.code) {
+        place(instruction.target);
+        place(instruction.left);
+        place(instruction.right);
+    }
+
+    const size_t size = std::max<size_t>(temporaryBase + this->maxTemporaries, 1);
+    this->result.frame.assign(size, Value{});
+    this->result.texts.assign(size, std::string());
+    for (size_t i = 0; i < this->program.variables.size(); i++) {
+        const VariableInfo &variable = this->program.variables[i];
+        this->result.frame[i].type = variable.type;
+        if (variable.array) this->result.frame[i].integer = this->arrayOf[i];
+    }
+    for (size_t i = 0; i < this->constantValues.size(); i++) {
+        this->result.frame[constantBase + i] = this->constantValues[i];
+        this->result.texts[constantBase + i] = std::move(this->constantTexts[i]);
+    }
+    for (size_t i = 0; i < size; i++) {
+        if (this->result.frame[i].type == ValueType::STRING && !(i < constantBase && this->program.variables[i].array)) {
+            this->result.frame[i].integer = static_cast<int64_t>(i);
+        }
+    }
+}
+
+#endif
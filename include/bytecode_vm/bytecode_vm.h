@@ -0,0 +1,272 @@
+#ifndef BYTECODE_VM_H
+#define BYTECODE_VM_H
+
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../instrumentation/instrumentation.h"
+#include "../builtin_functions/builtin_functions.h"
+#include "../../interface/bytecode.h"
+
+/**
+ * @brief Máquina de registros que ejecuta un BytecodeProgram completo.
+ * * El estado es un marco plano de Value (variables, constantes y temporales) más el texto de
+ * cada ranura de cadena y el almacenamiento de cada arreglo. Las instrucciones leen y escriben
+ * ranuras por índice, así que no hay búsqueda de nombres ni recorrido del árbol en ejecución.
+ * * La aritmética entera es de 64 bits con desbordamiento circular. Dividir un entero entre
+ * cero, indexar fuera de rango o declarar un arreglo de tamaño negativo lanzan
+ * std::out_of_range. Convertir a entero un real fuera de rango satura y NaN da 0.
+ */
+class BytecodeVm {
+
+    private:
+        struct ArrayStorage {
+            std::vector<Value> values;
+            std::vector<std::string> texts;
+        };
+
+        const BytecodeProgram* program = nullptr;
+        std::vector<Value> frame;
+        std::vector<std::string> texts;
+        std::vector<ArrayStorage> arrays;
+
+        static int64_t toInteger(double value);
+        static size_t checkIndex(const ArrayStorage &array, int64_t index);
+
+    public:
+        Value run(const BytecodeProgram &program);
+        const Value &slot(uint32_t index) const;
+        const std::string &text(uint32_t index) const;
+        void dump(std::ostream &out) const;
+};
+
+inline int64_t BytecodeVm::toInteger(const double value) {
+    if (std::isnan(value)) return 0;
+    if (value >= 9223372036854775807.0) return INT64_MAX;
+    if (value <= -9223372036854775808.0) return INT64_MIN;
+    return static_cast<int64_t>(value);
+}
+
+inline size_t BytecodeVm::checkIndex(const ArrayStorage &array, const int64_t index) {
+    if (static_cast<uint64_t>(index) >= array.values.size()) throw std::out_of_range("Index out of range");
+    return static_cast<size_t>(index);
+}
+
+/**
+ * @brief Ejecuta el programa desde su marco inicial.
+ * @param program Programa de BytecodeCompiler::compile(); debe seguir vivo mientras se consulte el estado.
+ * @throw std::out_of_range Ante una división entera entre cero, un índice fuera de rango o un tamaño negativo.
+ * @return Valor del `return` ejecutado; INT 0 si el programa termina sin valor.
+ */
+inline Value BytecodeVm::run(const BytecodeProgram &program) {
+    INSTRUMENT_SCOPE("vm.run");
+    this->program = &program;
+    this->frame = program.frame;
+    this->texts = program.texts;
+    this->arrays.assign(program.arrays.size(), ArrayStorage{});
+
+    Value* slots = this->frame.data();
+    std::string* texts = this->texts.data();
+    const VmInstruction* code = program.code.data();
+    const auto integer = [](const uint64_t value) { return static_cast<int64_t>(value); };
+    const auto truth = [](const bool value) { return static_cast<int64_t>(value); };
+    size_t pc = 0;
+
+    while (true) {
+        const VmInstruction &instruction = code[pc++];
+        Value &target = slots[instruction.target];
+        const Value &left = slots[instruction.left];
+        const Value &right = slots[instruction.right];
+        switch (instruction.op) {
+            case VmOp::MOVE:
+                target = left;
+                break;
+            case VmOp::MOVE_STRING:
+                if (instruction.target != instruction.left) texts[instruction.target] = texts[instruction.left];
+                target.integer = instruction.target;
+                target.type = ValueType::STRING;
+                break;
+            case VmOp::TO_DOUBLE:
+                target.real = static_cast<double>(left.integer);
+                target.type = ValueType::DOUBLE;
+                break;
+            case VmOp::TO_INT:
+                target.integer = toInteger(left.real);
+                target.type = ValueType::INT;
+                break;
+            case VmOp::ADD_INT:
+                target.integer = integer(static_cast<uint64_t>(left.integer) + static_cast<uint64_t>(right.integer));
+                target.type = ValueType::INT;
+                break;
+            case VmOp::SUB_INT:
+                target.integer = integer(static_cast<uint64_t>(left.integer) - static_cast<uint64_t>(right.integer));
+                target.type = ValueType::INT;
+                break;
+            case VmOp::MUL_INT:
+                target.integer = integer(static_cast<uint64_t>(left.integer) * static_cast<uint64_t>(right.integer));
+                target.type = ValueType::INT;
+                break;
+            case VmOp::DIV_INT:
+            case VmOp::MOD_INT: {
+                const int64_t x = left.integer;
+                const int64_t y = right.integer;
+                if (y == 0) throw std::out_of_range("Division by zero");
+                if (y == -1) target.integer = instruction.op == VmOp::DIV_INT ? integer(0 - static_cast<uint64_t>(x)) : 0;
+                else target.integer = instruction.op == VmOp::DIV_INT ? x / y : x % y;
+                target.type = ValueType::INT;
+                break;
+            }
+            case VmOp::NEG_INT:
+                target.integer = integer(0 - static_cast<uint64_t>(left.integer));
+                target.type = ValueType::INT;
+                break;
+            case VmOp::NOT_INT:
+                target.integer = truth(left.integer == 0);
+                target.type = ValueType::INT;
+                break;
+            case VmOp::EQ_INT: target.integer = truth(left.integer == right.integer); target.type = ValueType::INT; break;
+            case VmOp::NE_INT: target.integer = truth(left.integer != right.integer); target.type = ValueType::INT; break;
+            case VmOp::LT_INT: target.integer = truth(left.integer < right.integer); target.type = ValueType::INT; break;
+            case VmOp::GT_INT: target.integer = truth(left.integer > right.integer); target.type = ValueType::INT; break;
+            case VmOp::LE_INT: target.integer = truth(left.integer <= right.integer); target.type = ValueType::INT; break;
+            case VmOp::GE_INT: target.integer = truth(left.integer >= right.integer); target.type = ValueType::INT; break;
+            case VmOp::ADD_DOUBLE: target.real = left.real + right.real; target.type = ValueType::DOUBLE; break;
+            case VmOp::SUB_DOUBLE: target.real = left.real - right.real; target.type = ValueType::DOUBLE; break;
+            case VmOp::MUL_DOUBLE: target.real = left.real * right.real; target.type = ValueType::DOUBLE; break;
+            case VmOp::DIV_DOUBLE: target.real = left.real / right.real; target.type = ValueType::DOUBLE; break;
+            case VmOp::MOD_DOUBLE: target.real = std::fmod(left.real, right.real); target.type = ValueType::DOUBLE; break;
+            case VmOp::POW_DOUBLE: target.real = std::pow(left.real, right.real); target.type = ValueType::DOUBLE; break;
+            case VmOp::NEG_DOUBLE: target.real = -left.real; target.type = ValueType::DOUBLE; break;
+            case VmOp::NOT_DOUBLE: target.integer = truth(left.real == 0.0); target.type = ValueType::INT; break;
+            case VmOp::EQ_DOUBLE: target.integer = truth(left.real == right.real); target.type = ValueType::INT; break;
+            case VmOp::NE_DOUBLE: target.integer = truth(left.real != right.real); target.type = ValueType::INT; break;
+            case VmOp::LT_DOUBLE: target.integer = truth(left.real < right.real); target.type = ValueType::INT; break;
+            case VmOp::GT_DOUBLE: target.integer = truth(left.real > right.real); target.type = ValueType::INT; break;
+            case VmOp::LE_DOUBLE: target.integer = truth(left.real <= right.real); target.type = ValueType::INT; break;
+            case VmOp::GE_DOUBLE: target.integer = truth(left.real >= right.real); target.type = ValueType::INT; break;
+            case VmOp::CONCAT: {
+                std::string &out = texts[instruction.target];
+                if (instruction.target == instruction.left && instruction.target != instruction.right) {
+                    out += texts[instruction.right];
+                } else if (instruction.target != instruction.right) {
+                    out.assign(texts[instruction.left]).append(texts[instruction.right]);
+                } else {
+                    out = texts[instruction.left] + texts[instruction.right];
+                }
+                target.integer = instruction.target;
+                target.type = ValueType::STRING;
+                break;
+            }
+            case VmOp::EQ_STRING:
+                target.integer = truth(texts[instruction.left] == texts[instruction.right]);
+                target.type = ValueType::INT;
+                break;
+            case VmOp::NE_STRING:
+                target.integer = truth(texts[instruction.left] != texts[instruction.right]);
+                target.type = ValueType::INT;
+                break;
+            case VmOp::CALL: {
+                const double args[BuiltinFunctions::MAX_ARITY] = {left.real, right.real};
+                target.real = BuiltinFunctions::get(instruction.function).apply(args);
+                target.type = ValueType::DOUBLE;
+                break;
+            }
+            case VmOp::ARRAY_NEW: {
+                if (left.integer < 0) throw std::out_of_range("Invalid array size");
+                ArrayStorage &array = this->arrays[instruction.target];
+                const size_t size = static_cast<size_t>(left.integer);
+                const ValueType type = program.variables[static_cast<size_t>(program.arrays[instruction.target])].type;
+                Value zero;
+                zero.type = type;
+                array.values.assign(size, zero);
+                if (type == ValueType::STRING) array.texts.assign(size, std::string());
+                break;
+            }
+            case VmOp::ARRAY_LOAD: {
+                const ArrayStorage &array = this->arrays[instruction.left];
+                target = array.values[checkIndex(array, right.integer)];
+                break;
+            }
+            case VmOp::ARRAY_LOAD_STRING: {
+                const ArrayStorage &array = this->arrays[instruction.left];
+                texts[instruction.target] = array.texts[checkIndex(array, right.integer)];
+                target.integer = instruction.target;
+                target.type = ValueType::STRING;
+                break;
+            }
+            case VmOp::ARRAY_STORE: {
+                ArrayStorage &array = this->arrays[instruction.target];
+                array.values[checkIndex(array, left.integer)] = right;
+                break;
+            }
+            case VmOp::ARRAY_STORE_STRING: {
+                ArrayStorage &array = this->arrays[instruction.target];
+                array.texts[checkIndex(array, left.integer)] = texts[instruction.right];
+                break;
+            }
+            case VmOp::JUMP:
+                pc = instruction.target;
+                break;
+            case VmOp::JUMP_IF_FALSE: if (left.integer == 0) pc = instruction.target; break;
+            case VmOp::JUMP_IF_TRUE: if (left.integer != 0) pc = instruction.target; break;
+            case VmOp::JUMP_IF_FALSE_DOUBLE: if (left.real == 0.0) pc = instruction.target; break;
+            case VmOp::JUMP_IF_TRUE_DOUBLE: if (left.real != 0.0) pc = instruction.target; break;
+            case VmOp::JUMP_IF_EQ_INT: if (left.integer == right.integer) pc = instruction.target; break;
+            case VmOp::JUMP_IF_NE_INT: if (left.integer != right.integer) pc = instruction.target; break;
+            case VmOp::JUMP_IF_LT_INT: if (left.integer < right.integer) pc = instruction.target; break;
+            case VmOp::JUMP_IF_GT_INT: if (left.integer > right.integer) pc = instruction.target; break;
+            case VmOp::JUMP_IF_LE_INT: if (left.integer <= right.integer) pc = instruction.target; break;
+            case VmOp::JUMP_IF_GE_INT: if (left.integer >= right.integer) pc = instruction.target; break;
+            case VmOp::RETURN:
+                return Value{};
+            case VmOp::RETURN_VALUE:
+                return left;
+        }
+    }
+}
+
+inline const Value &BytecodeVm::slot(const uint32_t index) const {
+    return this->frame[index];
+}
+
+/**
+ * @brief Texto de una ranura de cadena; para un Value de cadena, @c index es su @c integer.
+ */
+inline const std::string &BytecodeVm::text(const uint32_t index) const {
+    return this->texts[index];
+}
+
+/**
+ * @brief Escribe `nombre = valor` por cada variable global tras la última ejecución.
+ * Los arreglos se escriben como `{a, b, ...}`.
+ */
+inline void BytecodeVm::dump(std::ostream &out) const {
+    if (this->program == nullptr) return;
+    const auto write = [&out](const Value &value, const std::string &text) {
+        if (value.type == ValueType::STRING) out << '"' << text << '"';
+        else if (value.type == ValueType::INT) out << value.integer;
+        else out << value.real;
+    };
+    for (size_t i = 0; i < this->program->variables.size(); i++) {
+        const VariableInfo &variable = this->program->variables[i];
+        if (!variable.global) continue;
+        out << variable.name << " = ";
+        if (variable.array) {
+            const ArrayStorage &array = this->arrays[static_cast<size_t>(this->frame[i].integer)];
+            out << '{';
+            for (size_t k = 0; k < array.values.size(); k++) {
+                if (k > 0) out << ", ";
+                write(array.values[k], variable.type == ValueType::STRING ? array.texts[k] : std::string());
+            }
+            out << '}';
+        } else {
+            write(this->frame[i], this->texts[i]);
+        }
+        out << std::endl;
+    }
+}
+
+#endif
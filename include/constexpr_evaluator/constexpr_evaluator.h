@@ -0,0 +1,265 @@
+#ifndef CONSTEXPR_EVALUATOR_H
+#define CONSTEXPR_EVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @brief Token producido por el analizador en tiempo de compilación.
+ * @note @c op vale '\0' para literales numéricos; en otro caso es + - * / ( o ).
+ */
+struct ConstexprToken {
+    char op = '\0';
+    double value = 0.0;
+};
+
+/**
+ * @brief Secuencia de tokens de capacidad fija, utilizable en expresiones constantes.
+ */
+template <size_t Capacity>
+struct ConstexprTokens {
+    ConstexprToken items[Capacity] = {};
+    size_t size = 0;
+};
+
+/**
+ * @brief Analizador léxico y evaluador (shunting-yard) de expresiones aritméticas en tiempo de compilación.
+ * * Sigue a LexicalAnalyzer + OperationsAnalyzer en el subconjunto que acepta: literales enteros
+ * y flotantes (`42`, `5.5`, `20.`, `1e3`), los operadores binarios + - * / con precedencia 2/3 y
+ * asociatividad por la izquierda, y paréntesis. Todo el cálculo se hace en doble precisión, como
+ * en evaluatePostfix(). No es una copia exacta del camino en tiempo de ejecución:
+ * * Cualquier otra construcción (identificadores, operadores no aritméticos, paréntesis sin
+ * pareja, operandos que faltan) lanza una excepción: evaluada en un contexto constante, la
+ * expresión deja de compilar. La división entre cero tampoco es una expresión constante, aunque
+ * OperationsAnalyzer sí la evalúa.
+ * * Los flotantes usan la misma conversión exacta de Clinger que NumberParser solo con mantisa
+ * <= 2^53 y exponente decimal <= 22; fuera de ese rango se escala potencia a potencia, por lo que
+ * el resultado puede diferir en la última cifra del de NumberParser, que recurre a strtod.
+ * * El arnés diferencial compara ambos caminos sobre expresiones aleatorias.
+ */
+class ConstexprEvaluator {
+
+    private:
+        static constexpr bool isDigit(char character);
+        static constexpr bool isSpace(char character);
+        static constexpr bool isOperator(char character);
+        static constexpr int getPrecedence(char op);
+        static constexpr double powerOfTen(int exponent);
+        static constexpr double parseNumber(std::string_view text, size_t &position);
+        static constexpr double apply(char op, double left, double right);
+
+    public:
+        static constexpr size_t MAX_TOKENS = 256;
+        static constexpr ConstexprTokens<MAX_TOKENS> tokenize(std::string_view text);
+        static constexpr double evaluate(const ConstexprTokens<MAX_TOKENS> &tokens);
+        static constexpr double evaluate(std::string_view text);
+};
+
+/**
+ * @brief Evalúa un literal de cadena en tiempo de compilación, también en contextos no constantes.
+ * * Ejemplo: `const double area = CONSTEXPR_EVALUATE("(3 + 4) * 2.5");`
+ */
+#define CONSTEXPR_EVALUATE(text) \
+    ([]() { constexpr double constexprValue = ConstexprEvaluator::evaluate(text); return constexprValue; }())
+
+constexpr bool ConstexprEvaluator::isDigit(const char character) {
+    return character >= '0' && character <= '9';
+}
+
+constexpr bool ConstexprEvaluator::isSpace(const char character) {
+    return character == ' ' || character == '\t' || character == '\n' || character == '\r' ||
+           character == '\v' || character == '\f';
+}
+
+constexpr bool ConstexprEvaluator::isOperator(const char character) {
+    return character == '+' || character == '-' || character == '*' || character == '/';
+}
+
+/**
+ * @brief Mismo orden que OperationsAnalyzer::getPrecedence: + - por debajo de * /.
+ */
+constexpr int ConstexprEvaluator::getPrecedence(const char op) {
+    return op == '+' || op == '-' ? 2 : op == '*' || op == '/' ? 3 : 0;
+}
+
+/**
+ * @brief 10^exponent; exacto para |exponent| <= 22.
+ */
+constexpr double ConstexprEvaluator::powerOfTen(const int exponent) {
+    double result = 1.0;
+    for (int i = 0; i < exponent; i++) result *= 10.0;
+    return result;
+}
+
+/**
+ * @brief Convierte el literal numérico que empieza en @c position y avanza hasta su final.
+ * @throw std::invalid_argument Si el literal está incompleto (p. ej. `1e`).
+ */
+constexpr double ConstexprEvaluator::parseNumber(const std::string_view text, size_t &position) {
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+
+    while (position < text.size() && isDigit(text[position])) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(text[position] - '0');
+            if (mantissa != 0) ++digits;
+        } else {
+            ++exponent;
+        }
+        ++position;
+    }
+    if (position < text.size() && text[position] == '.') {
+        ++position;
+        while (position < text.size() && isDigit(text[position])) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(text[position] - '0');
+                if (mantissa != 0) ++digits;
+                --exponent;
+            }
+            ++position;
+        }
+    }
+    if (position < text.size() && (text[position] == 'e' || text[position] == 'E')) {
+        ++position;
+        bool negative = false;
+        if (position < text.size() && (text[position] == '+' || text[position] == '-')) {
+            negative = text[position++] == '-';
+        }
+        if (position >= text.size() || !isDigit(text[position])) throw std::invalid_argument("Invalid numeric literal");
+        int value = 0;
+        while (position < text.size() && isDigit(text[position])) {
+            if (value < 100000) value = value * 10 + (text[position] - '0');
+            ++position;
+        }
+        exponent += negative ? -value : value;
+    }
+
+    double result = static_cast<double>(mantissa);
+    while (exponent > 22) {
+        result *= 1e22;
+        exponent -= 22;
+    }
+    while (exponent < -22) {
+        result /= 1e22;
+        exponent += 22;
+    }
+    return exponent < 0 ? result / powerOfTen(-exponent) : result * powerOfTen(exponent);
+}
+
+/**
+ * @brief Aplica un operador binario como evaluatePostfix (y ∘ x, con x en la cima).
+ */
+constexpr double ConstexprEvaluator::apply(const char op, const double left, const double right) {
+    if (op == '+') return left + right;
+    if (op == '-') return left - right;
+    if (op == '*') return left * right;
+    return left / right;
+}
+
+/**
+ * @brief Tokeniza una expresión aritmética.
+ * @param text Texto de la expresión.
+ * @throw std::invalid_argument Ante un carácter no admitido o más de MAX_TOKENS tokens.
+ * @return Tokens en orden de aparición.
+ */
+constexpr ConstexprTokens<ConstexprEvaluator::MAX_TOKENS> ConstexprEvaluator::tokenize(const std::string_view text) {
+    ConstexprTokens<MAX_TOKENS> tokens;
+    size_t position = 0;
+
+    while (position < text.size()) {
+        const char character = text[position];
+        if (isSpace(character)) {
+            ++position;
+            continue;
+        }
+        if (tokens.size == MAX_TOKENS) throw std::invalid_argument("Expression has too many tokens");
+
+        ConstexprToken &token = tokens.items[tokens.size++];
+        if (isDigit(character)) {
+            token.value = parseNumber(text, position);
+            if (position < text.size() && !isSpace(text[position]) && !isOperator(text[position]) &&
+                text[position] != '(' && text[position] != ')') {
+                throw std::invalid_argument("Invalid numeric literal");
+            }
+        } else if (isOperator(character) || character == '(' || character == ')') {
+            token.op = character;
+            ++position;
+        } else {
+            throw std::invalid_argument("Unsupported character in constant expression");
+        }
+    }
+    return tokens;
+}
+
+/**
+ * @brief Evalúa una secuencia de tokens con el algoritmo shunting-yard.
+ * * En lugar de materializar la forma postfija, cada operador desapilado se aplica en el acto
+ * sobre la pila de valores, lo que equivale a toPostfix() seguido de evaluatePostfix().
+ * @throw std::out_of_range Si la expresión no es válida.
+ * @return Resultado; 0.0 para una expresión vacía.
+ */
+constexpr double ConstexprEvaluator::evaluate(const ConstexprTokens<MAX_TOKENS> &tokens) {
+    double values[MAX_TOKENS] = {};
+    char operators[MAX_TOKENS] = {};
+    size_t valueCount = 0;
+    size_t operatorCount = 0;
+    bool expectOperand = true;
+
+    if (tokens.size == 0) return 0.0;
+
+    const auto reduce = [&]() {
+        if (valueCount < 2) throw std::out_of_range("Invalid postfix expression");
+        const double right = values[--valueCount];
+        const double left = values[--valueCount];
+        values[valueCount++] = apply(operators[--operatorCount], left, right);
+    };
+
+    for (size_t i = 0; i < tokens.size; i++) {
+        const ConstexprToken &token = tokens.items[i];
+
+        if (token.op == '\0') {
+            if (!expectOperand) throw std::out_of_range("Invalid postfix expression");
+            values[valueCount++] = token.value;
+            expectOperand = false;
+        } else if (token.op == '(') {
+            if (!expectOperand) throw std::out_of_range("Invalid postfix expression");
+            operators[operatorCount++] = token.op;
+        } else if (token.op == ')') {
+            if (expectOperand) throw std::out_of_range("Invalid postfix expression");
+            while (operatorCount > 0 && operators[operatorCount - 1] != '(') reduce();
+            if (operatorCount == 0) throw std::out_of_range("Unbalanced parentheses");
+            --operatorCount;
+        } else {
+            if (expectOperand) throw std::out_of_range("Invalid postfix expression");
+            const int precedence = getPrecedence(token.op);
+            while (operatorCount > 0 && operators[operatorCount - 1] != '(' &&
+                   precedence <= getPrecedence(operators[operatorCount - 1])) {
+                reduce();
+            }
+            operators[operatorCount++] = token.op;
+            expectOperand = true;
+        }
+    }
+
+    if (expectOperand) throw std::out_of_range("Invalid postfix expression");
+    while (operatorCount > 0) {
+        if (operators[operatorCount - 1] == '(') throw std::out_of_range("Unbalanced parentheses");
+        reduce();
+    }
+    return values[0];
+}
+
+/**
+ * @brief Tokeniza y evalúa una expresión; en un contexto constante no deja rastro en tiempo de ejecución.
+ * @param text Texto de la expresión.
+ * @throw std::invalid_argument Si el texto contiene algo distinto de números, + - * / y paréntesis.
+ * @throw std::out_of_range Si la expresión no es válida.
+ */
+constexpr double ConstexprEvaluator::evaluate(const std::string_view text) {
+    return evaluate(tokenize(text));
+}
+
+#endif
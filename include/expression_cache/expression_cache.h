@@ -0,0 +1,220 @@
+#ifndef EXPRESSION_CACHE_H
+#define EXPRESSION_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "../array_list/array_list.h"
+#include "../interface/node_struct.h"
+#include "../interface/compiled_expression.h"
+
+/**
+ * @brief Estadísticas acumuladas de la caché de expresiones.
+ */
+struct CacheStats {
+    long long hits;
+    long long misses;
+    long long evictions;
+    size_t entries;
+
+    double hitRate() const {
+        const long long total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * @brief Caché LRU acotada y segura entre hilos de expresiones compiladas.
+ * * La clave es la secuencia normalizada de tokens (tipo y lexema, sin línea ni posición), de
+ * modo que la misma fórmula escrita en distintas líneas o archivos comparte entrada. Las
+ * búsquedas se indexan por un hash de 64 bits de esa secuencia y se confirman comparando la
+ * clave almacenada con los tokens, sin construir ninguna cadena en los aciertos.
+ * Los valores se comparten mediante shared_ptr para que un hilo pueda seguir usando un programa
+ * aunque otro lo desaloje.
+ */
+class ExpressionCache {
+
+    private:
+        struct Entry {
+            uint64_t hash;
+            std::string key;
+            std::shared_ptr<const CompiledExpression> program;
+        };
+        size_t capacity;
+        std::list<Entry> order;
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+        mutable std::mutex mutex;
+        std::atomic<long long> hits{0};
+        std::atomic<long long> misses{0};
+        std::atomic<long long> evictions{0};
+
+    public:
+        explicit ExpressionCache(size_t capacity = 1024);
+        ExpressionCache(const ExpressionCache&) = delete;
+        ExpressionCache& operator=(const ExpressionCache&) = delete;
+        static ExpressionCache& shared();
+        static std::string keyOf(const ArrayList<NodeStruct> &tokens);
+        static uint64_t hashOf(const ArrayList<NodeStruct> &tokens);
+        static bool matches(const std::string &key, const ArrayList<NodeStruct> &tokens);
+        std::shared_ptr<const CompiledExpression> find(const ArrayList<NodeStruct> &tokens);
+        void insert(const ArrayList<NodeStruct> &tokens, std::shared_ptr<const CompiledExpression> program);
+        CacheStats stats() const;
+        void clear();
+};
+
+/**
+ * @brief Constructor.
+ * @param capacity Número máximo de expresiones retenidas (mínimo 1).
+ */
+inline ExpressionCache::ExpressionCache(const size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+/**
+ * @brief Instancia compartida por defecto del proceso.
+ */
+inline ExpressionCache& ExpressionCache::shared() {
+    static ExpressionCache instance;
+    return instance;
+}
+
+/**
+ * @brief Construye la clave normalizada de una secuencia de tokens.
+ * * Cada token aporta un byte con su tipo seguido del lexema y un separador (0x1F), lo que
+ * hace la clave inequívoca sin depender de línea ni posición.
+ * @param tokens Secuencia de tokens de la expresión.
+ * @return Clave de la caché.
+ */
+inline std::string ExpressionCache::keyOf(const ArrayList<NodeStruct> &tokens) {
+    size_t length = 0;
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        length += node->getDataRef().name.size() + 2;
+    }
+    std::string key(length, '\x1f');
+    size_t position = 0;
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const NodeStruct &token = node->getDataRef();
+        key[position++] = static_cast<char>('A' + static_cast<int>(token.type));
+        key.replace(position, token.name.size(), token.name);
+        position += token.name.size() + 1;
+    }
+    return key;
+}
+
+/**
+ * @brief Hash de 64 bits de la secuencia normalizada de tokens.
+ * * Mezcla por token el tipo, la longitud y el lexema empaquetado en palabras de 8 bytes.
+ * @param tokens Secuencia de tokens de la expresión.
+ */
+inline uint64_t ExpressionCache::hashOf(const ArrayList<NodeStruct> &tokens) {
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const NodeStruct &token = node->getDataRef();
+        hash = (hash ^ (static_cast<uint64_t>(token.type) << 32 | token.name.size())) * multiplier;
+        uint64_t chunk = 0;
+        int shift = 0;
+        for (const char character : token.name) {
+            chunk |= static_cast<uint64_t>(static_cast<unsigned char>(character)) << shift;
+            shift += 8;
+            if (shift == 64) {
+                hash = (hash ^ chunk) * multiplier;
+                chunk = 0;
+                shift = 0;
+            }
+        }
+        hash = (hash ^ chunk) * multiplier;
+        hash ^= hash >> 29;
+    }
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Comprueba que una clave almacenada corresponde exactamente a la secuencia de tokens.
+ */
+inline bool ExpressionCache::matches(const std::string &key, const ArrayList<NodeStruct> &tokens) {
+    size_t position = 0;
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const NodeStruct &token = node->getDataRef();
+        if (position + token.name.size() + 2 > key.size()) return false;
+        if (key[position] != static_cast<char>('A' + static_cast<int>(token.type))) return false;
+        if (key.compare(position + 1, token.name.size(), token.name) != 0) return false;
+        position += token.name.size() + 2;
+    }
+    return position == key.size();
+}
+
+/**
+ * @brief Busca el programa compilado de una expresión y lo marca como el más recientemente usado.
+ * @param tokens Secuencia de tokens de la expresión.
+ * @return Programa compilado; nullptr si no está en la caché.
+ */
+inline std::shared_ptr<const CompiledExpression> ExpressionCache::find(const ArrayList<NodeStruct> &tokens) {
+    const uint64_t hash = hashOf(tokens);
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->index.find(hash);
+    if (found == this->index.end() || !matches(found->second->key, tokens)) {
+        this->misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    this->order.splice(this->order.begin(), this->order, found->second);
+    this->hits.fetch_add(1, std::memory_order_relaxed);
+    return found->second->program;
+}
+
+/**
+ * @brief Inserta (o reemplaza) un programa compilado, desalojando el menos usado si se excede la capacidad.
+ * * Si otra expresión con el mismo hash ocupa la entrada, se reemplaza.
+ * @param tokens Secuencia de tokens de la expresión.
+ * @param program Programa compilado a retener.
+ */
+inline void ExpressionCache::insert(const ArrayList<NodeStruct> &tokens,
+                                    std::shared_ptr<const CompiledExpression> program) {
+    const uint64_t hash = hashOf(tokens);
+    std::string key = keyOf(tokens);
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->index.find(hash);
+    if (found != this->index.end()) {
+        found->second->key = std::move(key);
+        found->second->program = std::move(program);
+        this->order.splice(this->order.begin(), this->order, found->second);
+        return;
+    }
+    this->order.push_front(Entry{hash, std::move(key), std::move(program)});
+    this->index[hash] = this->order.begin();
+    if (this->order.size() > this->capacity) {
+        this->index.erase(this->order.back().hash);
+        this->order.pop_back();
+        this->evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Instantánea de aciertos, fallos, desalojos y entradas actuales.
+ */
+inline CacheStats ExpressionCache::stats() const {
+    CacheStats result{};
+    result.hits = this->hits.load(std::memory_order_relaxed);
+    result.misses = this->misses.load(std::memory_order_relaxed);
+    result.evictions = this->evictions.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(this->mutex);
+    result.entries = this->order.size();
+    return result;
+}
+
+/**
+ * @brief Vacía la caché y reinicia las estadísticas.
+ */
+inline void ExpressionCache::clear() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->order.clear();
+    this->index.clear();
+    this->hits.store(0);
+    this->misses.store(0);
+    this->evictions.store(0);
+}
+
+#endif
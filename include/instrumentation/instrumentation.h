@@ -0,0 +1,348 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
+/**
+ * @brief Contadores globales disponibles en la capa de instrumentación.
+ * @note COUNT no es un contador real, solo marca la cantidad de entradas.
+ */
+enum class Counter {
+    TOKENS_PRODUCED,
+    ALLOCATIONS,
+    BYTES_READ,
+    STACK_DEPTH_MAX,
+    COUNT
+};
+
+/**
+ * @brief Evento de tiempo registrado al cerrar un ScopedTimer.
+ */
+struct PhaseEvent {
+    const char* name;
+    long long startUs;
+    long long wallUs;
+    long long cpuUs;
+    size_t threadId;
+};
+
+class Instrumentation {
+
+    private:
+        struct State {
+            std::atomic<bool> enabled{false};
+            std::atomic<long long> counters[static_cast<int>(Counter::COUNT)];
+            std::atomic<size_t> nextThreadId{1};
+            std::mutex eventsMutex;
+            std::vector<PhaseEvent> events;
+            std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+            State() { for (auto &counter : counters) counter.store(0); }
+        };
+        static State& state();
+        static const char* counterName(Counter counter);
+        static void writeEscaped(std::ostream &out, const char* text);
+
+    public:
+        static const size_t MAX_EVENTS = 1000000;
+        static void enable();
+        static void disable();
+        static bool isEnabled();
+        static void reset();
+        static void add(Counter counter, long long delta);
+        static void max(Counter counter, long long value);
+        static long long get(Counter counter);
+        static long long nowUs();
+        static long long cpuNowUs();
+        static size_t threadId();
+        static void recordPhase(const PhaseEvent &event);
+        static void dumpJson(std::ostream &out);
+        static void dumpChromeTrace(std::ostream &out);
+};
+
+/**
+ * @brief Temporizador RAII que mide el tiempo de pared y de CPU de un ámbito.
+ * Si la instrumentación está deshabilitada en tiempo de ejecución no consulta ningún reloj.
+ */
+class ScopedTimer {
+
+    private:
+        const char* name;
+        long long startUs;
+        long long startCpuUs;
+        bool active;
+
+    public:
+        explicit ScopedTimer(const char* name);
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+        ~ScopedTimer();
+};
+
+/**
+ * @brief Acceso al estado compartido de la instrumentación.
+ * Se usa una variable estática local para mantener la biblioteca como solo-cabeceras.
+ * @return Referencia al estado global único.
+ */
+inline Instrumentation::State& Instrumentation::state() {
+    static State instance;
+    return instance;
+}
+
+/**
+ * @brief Activa la recolección de métricas en tiempo de ejecución.
+ */
+inline void Instrumentation::enable() {
+    state().enabled.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Desactiva la recolección de métricas; los datos ya registrados se conservan.
+ */
+inline void Instrumentation::disable() {
+    state().enabled.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Consulta si la instrumentación está activa.
+ * @return true si se están registrando contadores y tiempos.
+ */
+inline bool Instrumentation::isEnabled() {
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Reinicia todos los contadores y descarta los eventos registrados.
+ */
+inline void Instrumentation::reset() {
+    State &s = state();
+    for (auto &counter : s.counters) counter.store(0, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(s.eventsMutex);
+    s.events.clear();
+    s.origin = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Incrementa un contador acumulativo.
+ * @param counter Contador a modificar.
+ * @param delta Cantidad a sumar.
+ */
+inline void Instrumentation::add(const Counter counter, const long long delta) {
+    if (!isEnabled()) return;
+    state().counters[static_cast<int>(counter)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Actualiza un contador de máximo histórico (high-water mark).
+ * @param counter Contador a modificar.
+ * @param value Valor observado; solo se guarda si supera al registrado.
+ */
+inline void Instrumentation::max(const Counter counter, const long long value) {
+    if (!isEnabled()) return;
+    std::atomic<long long> &slot = state().counters[static_cast<int>(counter)];
+    long long current = slot.load(std::memory_order_relaxed);
+    while (value > current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief Lee el valor actual de un contador.
+ * @param counter Contador a consultar.
+ * @return Valor acumulado desde el último reset().
+ */
+inline long long Instrumentation::get(const Counter counter) {
+    return state().counters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Tiempo de pared en microsegundos desde el origen de la sesión de medición.
+ */
+inline long long Instrumentation::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - state().origin).count();
+}
+
+/**
+ * @brief Tiempo de CPU consumido por el hilo actual en microsegundos.
+ * @note En plataformas sin CLOCK_THREAD_CPUTIME_ID se usa std::clock (tiempo de proceso).
+ */
+inline long long Instrumentation::cpuNowUs() {
+#if defined(__unix__) || defined(__APPLE__)
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000;
+#else
+    return static_cast<long long>(std::clock()) * 1000000LL / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * @brief Identificador del hilo actual en las trazas: 1 para el primer hilo que cierra una fase,
+ * 2 para el siguiente, etc. Es único durante todo el proceso; reset() no lo reinicia.
+ */
+inline size_t Instrumentation::threadId() {
+    thread_local const size_t id = state().nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+/**
+ * @brief Registra el evento de una fase finalizada.
+ * @param event Datos de tiempo de la fase. Se descartan eventos por encima de MAX_EVENTS.
+ */
+inline void Instrumentation::recordPhase(const PhaseEvent &event) {
+    State &s = state();
+    std::lock_guard<std::mutex> lock(s.eventsMutex);
+    if (s.events.size() < MAX_EVENTS) s.events.push_back(event);
+}
+
+/**
+ * @brief Nombre estable de cada contador para la serialización.
+ */
+inline const char* Instrumentation::counterName(const Counter counter) {
+    switch (counter) {
+        case Counter::TOKENS_PRODUCED: return "tokens_produced";
+        case Counter::ALLOCATIONS:     return "allocations";
+        case Counter::BYTES_READ:      return "bytes_read";
+        case Counter::STACK_DEPTH_MAX: return "stack_depth_max";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Escribe una cadena escapando los caracteres reservados de JSON.
+ */
+inline void Instrumentation::writeEscaped(std::ostream &out, const char* text) {
+    for (const char* p = text; *p != '\0'; ++p) {
+        if (*p == '"' || *p == '\\') out << '\\' << *p;
+        else if (static_cast<unsigned char>(*p) < 0x20) out << ' ';
+        else out << *p;
+    }
+}
+
+/**
+ * @brief Serializa contadores y tiempos agregados por fase en formato JSON.
+ * * Cada fase reporta el número de llamadas y la suma de tiempo de pared y de CPU.
+ * @param out Flujo de salida destino.
+ */
+inline void Instrumentation::dumpJson(std::ostream &out) {
+    State &s = state();
+    std::vector<PhaseEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(s.eventsMutex);
+        events = s.events;
+    }
+
+    out << "{\n  \"counters\": {";
+    for (int i = 0; i < static_cast<int>(Counter::COUNT); i++) {
+        out << (i == 0 ? "\n" : ",\n") << "    \"" << counterName(static_cast<Counter>(i)) << "\": "
+            << s.counters[i].load(std::memory_order_relaxed);
+    }
+    out << "\n  },\n  \"phases\": {";
+
+    std::vector<std::string> names;
+    bool first = true;
+    for (const PhaseEvent &event : events) {
+        bool seen = false;
+        for (const std::string &name : names) if (name == event.name) { seen = true; break; }
+        if (seen) continue;
+        names.emplace_back(event.name);
+
+        long long calls = 0, wall = 0, cpu = 0;
+        for (const PhaseEvent &other : events) {
+            if (names.back() != other.name) continue;
+            ++calls;
+            wall += other.wallUs;
+            cpu += other.cpuUs;
+        }
+        out << (first ? "\n" : ",\n") << "    \"";
+        writeEscaped(out, event.name);
+        out << "\": {\"calls\": " << calls << ", \"wall_us\": " << wall << ", \"cpu_us\": " << cpu << "}";
+        first = false;
+    }
+    out << "\n  }\n}\n";
+}
+
+/**
+ * @brief Serializa los eventos en el formato Trace Event de Chrome (chrome://tracing, Perfetto).
+ * * Cada fase se emite como un evento completo ("ph": "X") y los contadores como un evento "C".
+ * @param out Flujo de salida destino.
+ */
+inline void Instrumentation::dumpChromeTrace(std::ostream &out) {
+    State &s = state();
+    std::vector<PhaseEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(s.eventsMutex);
+        events = s.events;
+    }
+
+    out << "{\"traceEvents\": [";
+    bool first = true;
+    long long lastUs = 0;
+    for (const PhaseEvent &event : events) {
+        out << (first ? "\n" : ",\n") << "  {\"name\": \"";
+        writeEscaped(out, event.name);
+        out << "\", \"cat\": \"phase\", \"ph\": \"X\", \"ts\": " << event.startUs
+            << ", \"dur\": " << event.wallUs << ", \"pid\": 1, \"tid\": " << event.threadId
+            << ", \"args\": {\"cpu_us\": " << event.cpuUs << "}}";
+        if (event.startUs + event.wallUs > lastUs) lastUs = event.startUs + event.wallUs;
+        first = false;
+    }
+    out << (first ? "\n" : ",\n") << "  {\"name\": \"counters\", \"ph\": \"C\", \"ts\": " << lastUs
+        << ", \"pid\": 1, \"args\": {";
+    for (int i = 0; i < static_cast<int>(Counter::COUNT); i++) {
+        out << (i == 0 ? "" : ", ") << "\"" << counterName(static_cast<Counter>(i)) << "\": "
+            << s.counters[i].load(std::memory_order_relaxed);
+    }
+    out << "}}\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+/**
+ * @brief Inicia la medición de un ámbito.
+ * @param name Nombre de la fase. Debe tener duración estática (literal de cadena).
+ */
+inline ScopedTimer::ScopedTimer(const char* name) : name(name), startUs(0), startCpuUs(0) {
+    this->active = Instrumentation::isEnabled();
+    if (!this->active) return;
+    this->startUs = Instrumentation::nowUs();
+    this->startCpuUs = Instrumentation::cpuNowUs();
+}
+
+/**
+ * @brief Cierra la medición y registra el evento de la fase.
+ */
+inline ScopedTimer::~ScopedTimer() {
+    if (!this->active) return;
+    PhaseEvent event{};
+    event.name = this->name;
+    event.startUs = this->startUs;
+    event.wallUs = Instrumentation::nowUs() - this->startUs;
+    event.cpuUs = Instrumentation::cpuNowUs() - this->startCpuUs;
+    event.threadId = Instrumentation::threadId();
+    Instrumentation::recordPhase(event);
+}
+
+/*
+ * Macros de instrumentación. Sin MINI_COMPILER_INSTRUMENTATION (opción de CMake
+ * ENABLE_INSTRUMENTATION) se expanden a nada y no dejan rastro en el binario.
+ */
+#define INSTRUMENT_CONCAT_INNER(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_INNER(a, b)
+
+#ifdef MINI_COMPILER_INSTRUMENTATION
+#define INSTRUMENT_SCOPE(name) ScopedTimer INSTRUMENT_CONCAT(instrumentScope, __LINE__)(name)
+#define INSTRUMENT_COUNT(counter, delta) Instrumentation::add(counter, delta)
+#define INSTRUMENT_MAX(counter, value) Instrumentation::max(counter, value)
+#else
+#define INSTRUMENT_SCOPE(name) ((void)0)
+#define INSTRUMENT_COUNT(counter, delta) ((void)0)
+#define INSTRUMENT_MAX(counter, value) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,607 @@
+#ifndef IR_BUILDER_H
+#define IR_BUILDER_H
+
+#include <initializer_list>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../instrumentation/instrumentation.h"
+#include "../builtin_functions/builtin_functions.h"
+#include "../../interface/ir_struct.h"
+
+/**
+ * @brief Construye la representación intermedia SSA de un ProgramStruct.
+ * * Sigue el algoritmo de Braun et al. ("Simple and Efficient Construction of Static Single
+ * Assignment Form"): cada bloque recuerda la última definición de cada variable y una lectura
+ * sin definición local se resuelve en los predecesores, creando φ solo donde se necesitan.
+ * Un bloque se sella cuando ya se conocen todos sus predecesores; hasta entonces sus φ quedan
+ * incompletas. Las φ triviales no se eliminan aquí, sino en IrOptimizer::propagateCopies().
+ * * `&&`, `||` y `?:` se traducen a bloques y φ, por lo que el operando omitido nunca se evalúa.
+ * Antes de cada `return` y al final del programa se emite un EXPORT por cada variable global
+ * declarada: son los valores observables que las pasadas deben conservar.
+ */
+class IrBuilder {
+
+    private:
+        struct Loop {
+            uint32_t next;
+            uint32_t exit;
+        };
+
+        const ProgramStruct &program;
+        IrFunction function;
+        std::vector<std::unordered_map<int32_t, uint32_t>> definitions;
+        std::vector<std::vector<std::pair<int32_t, uint32_t>>> incomplete;
+        std::vector<bool> sealed;
+        std::vector<Loop> loops;
+        std::vector<int32_t> globals;
+        uint32_t undefined[3] = {};
+        uint32_t current = 0;
+
+        explicit IrBuilder(const ProgramStruct &program);
+        uint32_t newBlock();
+        void seal(uint32_t block);
+        void link(uint32_t from, uint32_t to);
+        bool terminated() const;
+        void startUnreachable();
+        uint32_t emit(IrOp op, ValueType type, std::initializer_list<uint32_t> operands, OpCode code = OpCode::PUSH,
+                      int32_t symbol = -1);
+        uint32_t constant(ValueType type, double value);
+        uint32_t newPhi(uint32_t block, ValueType type, size_t count);
+        void jump(uint32_t target);
+        void branch(uint32_t condition, uint32_t whenTrue, uint32_t whenFalse);
+        void write(int32_t variable, uint32_t block, uint32_t value);
+        uint32_t read(int32_t variable, uint32_t block);
+        uint32_t readRecursive(int32_t variable, uint32_t block);
+        void addPhiOperands(int32_t variable, uint32_t phi);
+        uint32_t convert(uint32_t value, ValueType type);
+        uint32_t expression(int32_t index);
+        uint32_t shortCircuit(const ExpressionNode &node);
+        uint32_t conditional(const ExpressionNode &node);
+        uint32_t step(const ExpressionNode &node);
+        void statement(int32_t index);
+        void loop(int32_t body, int32_t stepStatement, int32_t expression);
+        void exit(int32_t value);
+
+    public:
+        static IrFunction build(const ProgramStruct &program);
+        static const char* opName(const IrInstruction &instruction);
+        static void print(const IrFunction &function, std::ostream &out);
+};
+
+inline IrBuilder::IrBuilder(const ProgramStruct &program) : program(program) {
+    this->function.strings = program.strings;
+    this->function.variables = program.variables;
+    this->function.instructions.reserve(program.expressions.size() + program.statements.size());
+}
+
+/**
+ * @brief Traduce un programa analizado a SSA.
+ * @param program Árbol producido por ProgramParser::parse().
+ * @return Función con el bloque 0 como entrada y un RETURN en cada salida.
+ */
+inline IrFunction IrBuilder::build(const ProgramStruct &program) {
+    INSTRUMENT_SCOPE("buildIr");
+    IrBuilder builder(program);
+    builder.current = builder.newBlock();
+    builder.seal(builder.current);
+    builder.undefined[static_cast<int>(ValueType::INT)] = builder.constant(ValueType::INT, 0);
+    builder.undefined[static_cast<int>(ValueType::DOUBLE)] = builder.constant(ValueType::DOUBLE, 0);
+    builder.undefined[static_cast<int>(ValueType::STRING)] = builder.emit(IrOp::STRING, ValueType::STRING, {}, OpCode::PUSH, -1);
+    if (program.root >= 0) builder.statement(program.root);
+    if (!builder.terminated()) builder.exit(-1);
+    return std::move(builder.function);
+}
+
+inline uint32_t IrBuilder::newBlock() {
+    this->function.blocks.emplace_back();
+    this->definitions.emplace_back();
+    this->incomplete.emplace_back();
+    this->sealed.push_back(false);
+    return static_cast<uint32_t>(this->function.blocks.size() - 1);
+}
+
+/**
+ * @brief Marca un bloque como completo y termina sus φ pendientes.
+ */
+inline void IrBuilder::seal(const uint32_t block) {
+    std::vector<std::pair<int32_t, uint32_t>> pending = std::move(this->incomplete[block]);
+    this->incomplete[block].clear();
+    this->sealed[block] = true;
+    for (const auto &phi : pending) this->addPhiOperands(phi.first, phi.second);
+}
+
+inline void IrBuilder::link(const uint32_t from, const uint32_t to) {
+    this->function.blocks[from].successors.push_back(to);
+    this->function.blocks[to].predecessors.push_back(from);
+}
+
+inline bool IrBuilder::terminated() const {
+    const std::vector<uint32_t> &code = this->function.blocks[this->current].code;
+    if (code.empty()) return false;
+    const IrOp op = this->function.instructions[code.back()].op;
+    return op == IrOp::JUMP || op == IrOp::BRANCH || op == IrOp::RETURN;
+}
+
+/**
+ * @brief Continúa en un bloque sin predecesores tras `break`, `continue` o `return`.
+ * Lo que se emita ahí es inalcanzable y lo elimina IrOptimizer::propagateConstants().
+ */
+inline void IrBuilder::startUnreachable() {
+    this->current = this->newBlock();
+    this->seal(this->current);
+}
+
+/**
+ * @brief Añade una instrucción al final del bloque actual.
+ * @return Valor (índice) de la instrucción.
+ */
+inline uint32_t IrBuilder::emit(const IrOp op, const ValueType type, const std::initializer_list<uint32_t> operands,
+                                const OpCode code, const int32_t symbol) {
+    const uint32_t id = static_cast<uint32_t>(this->function.instructions.size());
+    const uint32_t first = static_cast<uint32_t>(this->function.operands.size());
+    this->function.operands.insert(this->function.operands.end(), operands.begin(), operands.end());
+    this->function.instructions.push_back(IrInstruction{op, type, code, this->current, first,
+                                                        static_cast<uint32_t>(operands.size()), symbol, {}});
+    this->function.blocks[this->current].code.push_back(id);
+    return id;
+}
+
+inline uint32_t IrBuilder::constant(const ValueType type, const double value) {
+    const uint32_t id = this->emit(IrOp::CONST, type, {});
+    NumberValue &number = this->function.instructions[id].constant;
+    number.kind = type == ValueType::INT ? NumberKind::INTEGER : NumberKind::FLOAT;
+    if (type == ValueType::INT) number.integer = static_cast<int64_t>(value);
+    else number.real = value;
+    return id;
+}
+
+/**
+ * @brief Crea una φ al inicio de @p block con @p count operandos reservados.
+ */
+inline uint32_t IrBuilder::newPhi(const uint32_t block, const ValueType type, const size_t count) {
+    const uint32_t id = static_cast<uint32_t>(this->function.instructions.size());
+    const uint32_t first = static_cast<uint32_t>(this->function.operands.size());
+    this->function.operands.resize(this->function.operands.size() + count);
+    this->function.instructions.push_back(IrInstruction{IrOp::PHI, type, OpCode::PUSH, block, first,
+                                                        static_cast<uint32_t>(count), -1, {}});
+    this->function.blocks[block].phis.push_back(id);
+    return id;
+}
+
+inline void IrBuilder::jump(const uint32_t target) {
+    this->emit(IrOp::JUMP, ValueType::INT, {});
+    this->link(this->current, target);
+}
+
+inline void IrBuilder::branch(const uint32_t condition, const uint32_t whenTrue, const uint32_t whenFalse) {
+    this->emit(IrOp::BRANCH, ValueType::INT, {condition});
+    this->link(this->current, whenTrue);
+    this->link(this->current, whenFalse);
+}
+
+inline void IrBuilder::write(const int32_t variable, const uint32_t block, const uint32_t value) {
+    this->definitions[block][variable] = value;
+}
+
+inline uint32_t IrBuilder::read(const int32_t variable, const uint32_t block) {
+    const auto found = this->definitions[block].find(variable);
+    if (found != this->definitions[block].end()) return found->second;
+    return this->readRecursive(variable, block);
+}
+
+/**
+ * @brief Busca la definición de una variable en los predecesores de un bloque.
+ * * En un bloque sin sellar crea una φ incompleta; con un único predecesor sigue la búsqueda
+ * sin φ. La φ se registra antes de buscar sus operandos para cortar los ciclos de los bucles.
+ */
+inline uint32_t IrBuilder::readRecursive(const int32_t variable, const uint32_t block) {
+    const ValueType type = this->program.variables[static_cast<size_t>(variable)].type;
+    const std::vector<uint32_t> &predecessors = this->function.blocks[block].predecessors;
+    uint32_t value;
+    if (!this->sealed[block]) {
+        value = this->newPhi(block, type, 0);
+        this->incomplete[block].emplace_back(variable, value);
+    } else if (predecessors.empty()) {
+        value = this->undefined[static_cast<int>(type)];
+    } else if (predecessors.size() == 1) {
+        value = this->read(variable, predecessors[0]);
+    } else {
+        value = this->newPhi(block, type, 0);
+        this->write(variable, block, value);
+        this->addPhiOperands(variable, value);
+    }
+    this->write(variable, block, value);
+    return value;
+}
+
+/**
+ * @brief Completa una φ con la definición que llega desde cada predecesor.
+ */
+inline void IrBuilder::addPhiOperands(const int32_t variable, const uint32_t phi) {
+    const uint32_t block = this->function.instructions[phi].block;
+    const size_t count = this->function.blocks[block].predecessors.size();
+    const uint32_t first = static_cast<uint32_t>(this->function.operands.size());
+    this->function.operands.resize(this->function.operands.size() + count);
+    this->function.instructions[phi].first = first;
+    this->function.instructions[phi].count = static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t value = this->read(variable, this->function.blocks[block].predecessors[i]);
+        this->function.operands[first + i] = value;
+    }
+}
+
+/**
+ * @brief Convierte un valor numérico al tipo indicado; no emite nada si ya lo tiene.
+ */
+inline uint32_t IrBuilder::convert(const uint32_t value, const ValueType type) {
+    if (this->function.instructions[value].type == type) return value;
+    return this->emit(IrOp::CONVERT, type, {value});
+}
+
+inline uint32_t IrBuilder::expression(const int32_t index) {
+    const ExpressionNode &node = this->program.expressions[static_cast<size_t>(index)];
+    switch (node.kind) {
+        case ExpressionKind::NUMBER: {
+            const uint32_t id = this->emit(IrOp::CONST, node.type, {});
+            this->function.instructions[id].constant = node.number;
+            return id;
+        }
+        case ExpressionKind::STRING:
+            return this->emit(IrOp::STRING, ValueType::STRING, {}, OpCode::PUSH, node.symbol);
+        case ExpressionKind::VARIABLE:
+            return this->read(node.symbol, this->current);
+        case ExpressionKind::INDEX: {
+            const uint32_t array = this->read(node.symbol, this->current);
+            const uint32_t position = this->expression(node.right);
+            return this->emit(IrOp::ARRAY_LOAD, node.type, {array, position});
+        }
+        case ExpressionKind::UNARY: {
+            const uint32_t operand = this->expression(node.left);
+            return this->emit(IrOp::UNARY, node.type, {operand}, node.op);
+        }
+        case ExpressionKind::BINARY: {
+            uint32_t left = this->expression(node.left);
+            uint32_t right = this->expression(node.right);
+            const ValueType leftType = this->function.instructions[left].type;
+            const ValueType rightType = this->function.instructions[right].type;
+            if (leftType != ValueType::STRING) {
+                const bool comparison = node.op == OpCode::EQ || node.op == OpCode::NE || node.op == OpCode::LT ||
+                                        node.op == OpCode::GT || node.op == OpCode::LE || node.op == OpCode::GE;
+                ValueType common = node.type;
+                if (comparison) {
+                    common = leftType == ValueType::INT && rightType == ValueType::INT ? ValueType::INT : ValueType::DOUBLE;
+                }
+                left = this->convert(left, common);
+                right = this->convert(right, common);
+            }
+            return this->emit(IrOp::BINARY, node.type, {left, right}, node.op);
+        }
+        case ExpressionKind::AND:
+        case ExpressionKind::OR:
+            return this->shortCircuit(node);
+        case ExpressionKind::CONDITIONAL:
+            return this->conditional(node);
+        case ExpressionKind::CALL: {
+            const uint32_t left = node.left >= 0 ? this->convert(this->expression(node.left), ValueType::DOUBLE) : 0;
+            if (node.right < 0) {
+                return node.left >= 0 ? this->emit(IrOp::CALL, ValueType::DOUBLE, {left}, OpCode::CALL, node.symbol)
+                                      : this->emit(IrOp::CALL, ValueType::DOUBLE, {}, OpCode::CALL, node.symbol);
+            }
+            const uint32_t right = this->convert(this->expression(node.right), ValueType::DOUBLE);
+            return this->emit(IrOp::CALL, ValueType::DOUBLE, {left, right}, OpCode::CALL, node.symbol);
+        }
+        case ExpressionKind::STEP:
+            return this->step(node);
+    }
+    return this->undefined[static_cast<int>(ValueType::INT)];
+}
+
+/**
+ * @brief `a && b` y `a || b`: el operando derecho vive en su propio bloque y el resultado,
+ * 0 o 1, se une con una φ.
+ */
+inline uint32_t IrBuilder::shortCircuit(const ExpressionNode &node) {
+    const bool conjunction = node.kind == ExpressionKind::AND;
+    const uint32_t left = this->expression(node.left);
+    const uint32_t decided = this->constant(ValueType::INT, conjunction ? 0 : 1);
+    const uint32_t rightBlock = this->newBlock();
+    const uint32_t join = this->newBlock();
+    if (conjunction) this->branch(left, rightBlock, join);
+    else this->branch(left, join, rightBlock);
+    this->seal(rightBlock);
+
+    this->current = rightBlock;
+    const uint32_t right = this->expression(node.right);
+    const uint32_t zero = this->constant(this->function.instructions[right].type, 0);
+    const uint32_t truth = this->emit(IrOp::BINARY, ValueType::INT, {right, zero}, OpCode::NE);
+    this->jump(join);
+    this->seal(join);
+
+    this->current = join;
+    const uint32_t phi = this->newPhi(join, ValueType::INT, 2);
+    this->function.operands[this->function.instructions[phi].first] = decided;
+    this->function.operands[this->function.instructions[phi].first + 1] = truth;
+    return phi;
+}
+
+/**
+ * @brief `c ? a : b`: cada rama en su bloque y el resultado unido con una φ.
+ */
+inline uint32_t IrBuilder::conditional(const ExpressionNode &node) {
+    const uint32_t condition = this->expression(node.extra);
+    const uint32_t thenBlock = this->newBlock();
+    const uint32_t elseBlock = this->newBlock();
+    const uint32_t join = this->newBlock();
+    this->branch(condition, thenBlock, elseBlock);
+    this->seal(thenBlock);
+    this->seal(elseBlock);
+
+    this->current = thenBlock;
+    const uint32_t whenTrue = this->convert(this->expression(node.left), node.type);
+    this->jump(join);
+    this->current = elseBlock;
+    const uint32_t whenFalse = this->convert(this->expression(node.right), node.type);
+    this->jump(join);
+    this->seal(join);
+
+    this->current = join;
+    const uint32_t phi = this->newPhi(join, node.type, 2);
+    this->function.operands[this->function.instructions[phi].first] = whenTrue;
+    this->function.operands[this->function.instructions[phi].first + 1] = whenFalse;
+    return phi;
+}
+
+/**
+ * @brief `++` y `--`: redefine la variable (o guarda el elemento) y devuelve el valor nuevo o el anterior.
+ */
+inline uint32_t IrBuilder::step(const ExpressionNode &node) {
+    const ExpressionNode &target = this->program.expressions[static_cast<size_t>(node.left)];
+    const bool increment = node.op == OpCode::PRE_INC || node.op == OpCode::POST_INC;
+    const bool prefix = node.op == OpCode::PRE_INC || node.op == OpCode::PRE_DEC;
+    uint32_t array = 0;
+    uint32_t position = 0;
+    uint32_t before;
+    if (target.kind == ExpressionKind::INDEX) {
+        array = this->read(target.symbol, this->current);
+        position = this->expression(target.right);
+        before = this->emit(IrOp::ARRAY_LOAD, node.type, {array, position});
+    } else {
+        before = this->read(target.symbol, this->current);
+    }
+    const uint32_t one = this->constant(node.type, 1);
+    const uint32_t after = this->emit(IrOp::BINARY, node.type, {before, one}, increment ? OpCode::ADD : OpCode::SUB);
+    if (target.kind == ExpressionKind::INDEX) this->emit(IrOp::ARRAY_STORE, node.type, {array, position, after});
+    else this->write(target.symbol, this->current, after);
+    return prefix ? after : before;
+}
+
+inline void IrBuilder::statement(const int32_t index) {
+    const StatementNode &node = this->program.statements[static_cast<size_t>(index)];
+    switch (node.kind) {
+        case StatementKind::DECLARE: {
+            const VariableInfo &variable = this->program.variables[static_cast<size_t>(node.target)];
+            uint32_t value;
+            if (variable.array) {
+                const uint32_t size = node.index >= 0 ? this->expression(node.index)
+                                                      : this->constant(ValueType::INT, node.count);
+                value = this->emit(IrOp::ARRAY_NEW, variable.type, {size}, OpCode::PUSH, node.target);
+                for (int32_t i = 0; i < node.count; i++) {
+                    const uint32_t position = this->constant(ValueType::INT, i);
+                    const uint32_t element = this->expression(this->program.items[static_cast<size_t>(node.first + i)]);
+                    const uint32_t stored = variable.type == ValueType::STRING ? element : this->convert(element, variable.type);
+                    this->emit(IrOp::ARRAY_STORE, variable.type, {value, position, stored});
+                }
+            } else if (node.value >= 0) {
+                const uint32_t initial = this->expression(node.value);
+                value = variable.type == ValueType::STRING ? initial : this->convert(initial, variable.type);
+            } else {
+                value = this->undefined[static_cast<int>(variable.type)];
+            }
+            this->write(node.target, this->current, value);
+            if (variable.global) this->globals.push_back(node.target);
+            break;
+        }
+        case StatementKind::ASSIGN: {
+            const VariableInfo &variable = this->program.variables[static_cast<size_t>(node.target)];
+            if (node.index >= 0) {
+                const uint32_t array = this->read(node.target, this->current);
+                const uint32_t position = this->expression(node.index);
+                const uint32_t value = this->expression(node.value);
+                const uint32_t stored = variable.type == ValueType::STRING ? value : this->convert(value, variable.type);
+                this->emit(IrOp::ARRAY_STORE, variable.type, {array, position, stored});
+            } else {
+                const uint32_t value = this->expression(node.value);
+                const uint32_t stored = variable.type == ValueType::STRING ? value : this->convert(value, variable.type);
+                this->write(node.target, this->current, stored);
+            }
+            break;
+        }
+        case StatementKind::EXPRESSION:
+            this->expression(node.value);
+            break;
+        case StatementKind::BLOCK:
+            for (int32_t i = 0; i < node.count; i++) this->statement(this->program.items[static_cast<size_t>(node.first + i)]);
+            break;
+        case StatementKind::IF: {
+            const uint32_t condition = this->expression(node.value);
+            const uint32_t thenBlock = this->newBlock();
+            const uint32_t elseBlock = node.otherwise >= 0 ? this->newBlock() : 0;
+            const uint32_t join = this->newBlock();
+            this->branch(condition, thenBlock, node.otherwise >= 0 ? elseBlock : join);
+            this->seal(thenBlock);
+            this->current = thenBlock;
+            this->statement(node.body);
+            if (!this->terminated()) this->jump(join);
+            if (node.otherwise >= 0) {
+                this->seal(elseBlock);
+                this->current = elseBlock;
+                this->statement(node.otherwise);
+                if (!this->terminated()) this->jump(join);
+            }
+            this->seal(join);
+            this->current = join;
+            break;
+        }
+        case StatementKind::WHILE:
+            this->loop(node.body, -1, node.value);
+            break;
+        case StatementKind::FOR:
+            if (node.init >= 0) this->statement(node.init);
+            this->loop(node.body, node.step, node.value);
+            break;
+        case StatementKind::BREAK:
+            this->jump(this->loops.back().exit);
+            this->startUnreachable();
+            break;
+        case StatementKind::CONTINUE:
+            this->jump(this->loops.back().next);
+            this->startUnreachable();
+            break;
+        case StatementKind::RETURN:
+            this->exit(node.value);
+            this->startUnreachable();
+            break;
+    }
+}
+
+/**
+ * @brief `while` y `for`: preencabezado, encabezado con la condición, cuerpo, paso y salida.
+ * * El preencabezado es un bloque propio con un único sucesor, donde
+ * IrOptimizer::hoistLoopInvariants() deposita el código invariante. El encabezado, el paso y
+ * la salida se sellan cuando el cuerpo ya no puede añadirles predecesores.
+ * @param body Sentencia del cuerpo.
+ * @param stepStatement Paso de un `for`; -1 si no hay.
+ * @param expression Condición; -1 para un bucle sin condición.
+ */
+inline void IrBuilder::loop(const int32_t body, const int32_t stepStatement, const int32_t expression) {
+    const uint32_t preheader = this->newBlock();
+    this->jump(preheader);
+    this->seal(preheader);
+    const uint32_t header = this->newBlock();
+    this->current = preheader;
+    this->jump(header);
+
+    const uint32_t bodyBlock = this->newBlock();
+    const uint32_t stepBlock = stepStatement >= 0 ? this->newBlock() : header;
+    const uint32_t exitBlock = this->newBlock();
+    this->current = header;
+    if (expression >= 0) this->branch(this->expression(expression), bodyBlock, exitBlock);
+    else this->jump(bodyBlock);
+    this->seal(bodyBlock);
+
+    this->loops.push_back(Loop{stepBlock, exitBlock});
+    this->current = bodyBlock;
+    this->statement(body);
+    if (!this->terminated()) this->jump(stepBlock);
+    this->loops.pop_back();
+
+    if (stepStatement >= 0) {
+        this->seal(stepBlock);
+        this->current = stepBlock;
+        this->statement(stepStatement);
+        this->jump(header);
+    }
+    this->seal(header);
+    this->seal(exitBlock);
+    this->current = exitBlock;
+}
+
+/**
+ * @brief Exporta las variables globales declaradas hasta aquí y termina con RETURN.
+ * @param value Expresión devuelta; -1 si no hay.
+ */
+inline void IrBuilder::exit(const int32_t value) {
+    const uint32_t result = value >= 0 ? this->expression(value) : 0;
+    for (const int32_t variable : this->globals) {
+        this->emit(IrOp::EXPORT, this->program.variables[static_cast<size_t>(variable)].type,
+                   {this->read(variable, this->current)}, OpCode::PUSH, variable);
+    }
+    if (value >= 0) this->emit(IrOp::RETURN, this->function.instructions[result].type, {result});
+    else this->emit(IrOp::RETURN, ValueType::INT, {});
+}
+
+inline const char* IrBuilder::opName(const IrInstruction &instruction) {
+    switch (instruction.op) {
+        case IrOp::CONST: return "const";
+        case IrOp::STRING: return "string";
+        case IrOp::PHI: return "phi";
+        case IrOp::CONVERT: return "convert";
+        case IrOp::CALL: return "call";
+        case IrOp::ARRAY_NEW: return "array.new";
+        case IrOp::ARRAY_LOAD: return "array.load";
+        case IrOp::ARRAY_STORE: return "array.store";
+        case IrOp::EXPORT: return "export";
+        case IrOp::JUMP: return "jump";
+        case IrOp::BRANCH: return "branch";
+        case IrOp::RETURN: return "return";
+        case IrOp::UNARY: return instruction.code == OpCode::NEG ? "neg" : "not";
+        case IrOp::BINARY: break;
+    }
+    switch (instruction.code) {
+        case OpCode::ADD: return "add";
+        case OpCode::SUB: return "sub";
+        case OpCode::MUL: return "mul";
+        case OpCode::DIV: return "div";
+        case OpCode::MOD: return "mod";
+        case OpCode::POW: return "pow";
+        case OpCode::EQ: return "eq";
+        case OpCode::NE: return "ne";
+        case OpCode::LT: return "lt";
+        case OpCode::GT: return "gt";
+        case OpCode::LE: return "le";
+        case OpCode::GE: return "ge";
+        default: return "?";
+    }
+}
+
+/**
+ * @brief Escribe la función en texto, un bloque por etiqueta y una instrucción por línea.
+ */
+inline void IrBuilder::print(const IrFunction &function, std::ostream &out) {
+    static const char* const types[] = {"int", "double", "string"};
+    for (size_t b = 0; b < function.blocks.size(); b++) {
+        const IrBlock &block = function.blocks[b];
+        if (block.code.empty()) continue;
+        out << "b" << b << ":";
+        if (!block.predecessors.empty()) {
+            out << "  ; preds";
+            for (const uint32_t predecessor : block.predecessors) out << " b" << predecessor;
+        }
+        out << "\n";
+        for (const std::vector<uint32_t>* list : {&block.phis, &block.code}) {
+            for (const uint32_t id : *list) {
+                const IrInstruction &instruction = function.instructions[id];
+                const bool value = instruction.op != IrOp::ARRAY_STORE && instruction.op != IrOp::EXPORT &&
+                                   instruction.op != IrOp::JUMP && instruction.op != IrOp::BRANCH &&
+                                   instruction.op != IrOp::RETURN;
+                out << "  ";
+                if (value) out << "%" << id << " = ";
+                out << opName(instruction);
+                if (value) out << " " << types[static_cast<int>(instruction.type)];
+                if (instruction.op == IrOp::CONST) {
+                    if (instruction.type == ValueType::INT) out << " " << instruction.constant.integer;
+                    else out << " " << instruction.constant.real;
+                } else if (instruction.op == IrOp::STRING) {
+                    out << " \"" << (instruction.symbol >= 0 ? function.strings[static_cast<size_t>(instruction.symbol)] : "") << "\"";
+                } else if (instruction.op == IrOp::CALL) {
+                    out << " " << BuiltinFunctions::get(instruction.symbol).name;
+                } else if (instruction.op == IrOp::EXPORT || instruction.op == IrOp::ARRAY_NEW) {
+                    out << " " << function.variables[static_cast<size_t>(instruction.symbol)].name;
+                }
+                for (uint32_t i = 0; i < instruction.count; i++) {
+                    out << (i == 0 ? " " : ", ") << "%" << function.operands[instruction.first + i];
+                    if (instruction.op == IrOp::PHI) out << " b" << block.predecessors[i];
+                }
+                for (size_t i = 0; instruction.op == IrOp::JUMP || instruction.op == IrOp::BRANCH; i++) {
+                    if (i >= block.successors.size()) break;
+                    out << (i == 0 && instruction.count == 0 ? " " : ", ") << "b" << block.successors[i];
+                }
+                out << "\n";
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,614 @@
+#ifndef IR_OPTIMIZER_H
+#define IR_OPTIMIZER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../instrumentation/instrumentation.h"
+#include "../builtin_functions/builtin_functions.h"
+#include "../../interface/ir_struct.h"
+
+/**
+ * @brief Resultado de una pasada: instrucciones antes y después, y duración.
+ */
+struct IrPassStats {
+    std::string name;
+    size_t before;
+    size_t after;
+    double microseconds;
+};
+
+/**
+ * @brief Pasadas de optimización sobre la representación SSA de IrBuilder.
+ * * Las pasadas no cambian el valor exportado ni el orden de los efectos (ARRAY_STORE, EXPORT y
+ * RETURN). La aritmética entera se pliega con la misma semántica que la ejecución: suma, resta
+ * y producto envuelven en 64 bits; la división y el resto por cero no se pliegan ni se mueven.
+ */
+class IrOptimizer {
+
+    private:
+        static bool isConstant(const IrFunction &function, uint32_t value);
+        static bool sameConstant(const IrInstruction &left, const IrInstruction &right);
+        static double asDouble(const IrInstruction &instruction);
+        static bool mayTrap(const IrFunction &function, const IrInstruction &instruction);
+        static bool isRoot(const IrFunction &function, const IrInstruction &instruction);
+        static bool fold(const IrFunction &function, const IrInstruction &instruction, NumberValue &result);
+        static void removeEdge(IrFunction &function, uint32_t from, uint32_t to);
+        static void removeUnreachable(IrFunction &function);
+        static void compact(IrFunction &function, const std::vector<bool> &removed);
+        static std::vector<uint32_t> reversePostorder(const IrFunction &function);
+        static std::vector<uint32_t> dominators(const IrFunction &function, const std::vector<uint32_t> &order);
+        static bool dominates(const std::vector<uint32_t> &idom, const std::vector<uint32_t> &rank, uint32_t a, uint32_t b);
+
+    public:
+        static void propagateConstants(IrFunction &function);
+        static void propagateCopies(IrFunction &function);
+        static void hoistLoopInvariants(IrFunction &function);
+        static void eliminateDeadCode(IrFunction &function);
+        static std::vector<IrPassStats> optimize(IrFunction &function);
+};
+
+inline bool IrOptimizer::isConstant(const IrFunction &function, const uint32_t value) {
+    return function.instructions[value].op == IrOp::CONST;
+}
+
+inline bool IrOptimizer::sameConstant(const IrInstruction &left, const IrInstruction &right) {
+    if (left.op != IrOp::CONST || right.op != IrOp::CONST || left.type != right.type) return false;
+    if (left.type == ValueType::INT) return left.constant.integer == right.constant.integer;
+    return left.constant.real == right.constant.real || (std::isnan(left.constant.real) && std::isnan(right.constant.real));
+}
+
+inline double IrOptimizer::asDouble(const IrInstruction &instruction) {
+    return instruction.type == ValueType::INT ? static_cast<double>(instruction.constant.integer) : instruction.constant.real;
+}
+
+/**
+ * @brief División o resto enteros cuyo divisor no es una constante distinta de cero.
+ * No se pliegan ni se adelantan, porque fallan al ejecutarse con divisor cero.
+ */
+inline bool IrOptimizer::mayTrap(const IrFunction &function, const IrInstruction &instruction) {
+    if (instruction.op != IrOp::BINARY || instruction.type != ValueType::INT) return false;
+    if (instruction.code != OpCode::DIV && instruction.code != OpCode::MOD) return false;
+    const IrInstruction &divisor = function.instructions[function.operands[instruction.first + 1]];
+    return divisor.op != IrOp::CONST || divisor.constant.integer == 0;
+}
+
+/**
+ * @brief Calcula el resultado de una instrucción numérica cuyos operandos son constantes.
+ * @return false si algún operando no es constante o la instrucción no se puede plegar.
+ */
+inline bool IrOptimizer::fold(const IrFunction &function, const IrInstruction &instruction, NumberValue &result) {
+    if (instruction.type == ValueType::STRING || instruction.count == 0 || instruction.count > 2) return false;
+    if (instruction.op != IrOp::CONVERT && instruction.op != IrOp::UNARY && instruction.op != IrOp::BINARY &&
+        instruction.op != IrOp::CALL) return false;
+    for (uint32_t i = 0; i < instruction.count; i++) {
+        if (!isConstant(function, function.operands[instruction.first + i])) return false;
+    }
+    const IrInstruction &a = function.instructions[function.operands[instruction.first]];
+    const IrInstruction &b = function.instructions[function.operands[instruction.first + instruction.count - 1]];
+    if (a.type == ValueType::STRING || b.type == ValueType::STRING || mayTrap(function, instruction)) return false;
+
+    const bool integer = instruction.type == ValueType::INT;
+    result.kind = integer ? NumberKind::INTEGER : NumberKind::FLOAT;
+    const auto wrap = [](const uint64_t value) { return static_cast<int64_t>(value); };
+
+    if (instruction.op == IrOp::CALL) {
+        const double args[BuiltinFunctions::MAX_ARITY] = {asDouble(a), asDouble(b)};
+        result.real = BuiltinFunctions::get(instruction.symbol).apply(args);
+    } else if (instruction.op == IrOp::CONVERT) {
+        if (!integer) result.real = asDouble(a);
+        else if (!std::isfinite(a.constant.real) || std::fabs(a.constant.real) >= 9.2e18) return false;
+        else result.integer = static_cast<int64_t>(a.constant.real);
+    } else if (instruction.op == IrOp::UNARY) {
+        if (instruction.code == OpCode::NOT) result.integer = asDouble(a) == 0.0 ? 1 : 0;
+        else if (integer) result.integer = wrap(0 - static_cast<uint64_t>(a.constant.integer));
+        else result.real = -a.constant.real;
+    } else if (a.type == ValueType::INT && b.type == ValueType::INT) {
+        const int64_t x = a.constant.integer;
+        const int64_t y = b.constant.integer;
+        switch (instruction.code) {
+            case OpCode::ADD: result.integer = wrap(static_cast<uint64_t>(x) + static_cast<uint64_t>(y)); break;
+            case OpCode::SUB: result.integer = wrap(static_cast<uint64_t>(x) - static_cast<uint64_t>(y)); break;
+            case OpCode::MUL: result.integer = wrap(static_cast<uint64_t>(x) * static_cast<uint64_t>(y)); break;
+            case OpCode::DIV:
+                if (x == INT64_MIN && y == -1) return false;
+                result.integer = x / y;
+                break;
+            case OpCode::MOD:
+                if (x == INT64_MIN && y == -1) return false;
+                result.integer = x % y;
+                break;
+            case OpCode::EQ: result.integer = x == y; break;
+            case OpCode::NE: result.integer = x != y; break;
+            case OpCode::LT: result.integer = x < y; break;
+            case OpCode::GT: result.integer = x > y; break;
+            case OpCode::LE: result.integer = x <= y; break;
+            case OpCode::GE: result.integer = x >= y; break;
+            default: return false;
+        }
+    } else {
+        const double x = asDouble(a);
+        const double y = asDouble(b);
+        double value;
+        switch (instruction.code) {
+            case OpCode::ADD: value = x + y; break;
+            case OpCode::SUB: value = x - y; break;
+            case OpCode::MUL: value = x * y; break;
+            case OpCode::DIV: value = x / y; break;
+            case OpCode::MOD: value = std::fmod(x, y); break;
+            case OpCode::POW: value = std::pow(x, y); break;
+            case OpCode::EQ: value = x == y; break;
+            case OpCode::NE: value = x != y; break;
+            case OpCode::LT: value = x < y; break;
+            case OpCode::GT: value = x > y; break;
+            case OpCode::LE: value = x <= y; break;
+            case OpCode::GE: value = x >= y; break;
+            default: return false;
+        }
+        if (integer) result.integer = static_cast<int64_t>(value);
+        else result.real = value;
+    }
+    return true;
+}
+
+/**
+ * @brief Quita la arista @p from → @p to junto con el operando correspondiente de cada φ de @p to.
+ */
+inline void IrOptimizer::removeEdge(IrFunction &function, const uint32_t from, const uint32_t to) {
+    std::vector<uint32_t> &successors = function.blocks[from].successors;
+    successors.erase(std::find(successors.begin(), successors.end(), to));
+    std::vector<uint32_t> &predecessors = function.blocks[to].predecessors;
+    const size_t index = static_cast<size_t>(std::find(predecessors.begin(), predecessors.end(), from) - predecessors.begin());
+    predecessors.erase(predecessors.begin() + static_cast<std::ptrdiff_t>(index));
+    for (const uint32_t phi : function.blocks[to].phis) {
+        IrInstruction &instruction = function.instructions[phi];
+        if (instruction.op != IrOp::PHI) continue;
+        const auto begin = function.operands.begin() + instruction.first;
+        std::rotate(begin + static_cast<std::ptrdiff_t>(index), begin + static_cast<std::ptrdiff_t>(index) + 1,
+                    begin + instruction.count);
+        --instruction.count;
+    }
+}
+
+/**
+ * @brief Vacía los bloques a los que no se llega desde la entrada.
+ */
+inline void IrOptimizer::removeUnreachable(IrFunction &function) {
+    std::vector<bool> reachable(function.blocks.size(), false);
+    std::vector<uint32_t> worklist{0};
+    reachable[0] = true;
+    while (!worklist.empty()) {
+        const uint32_t block = worklist.back();
+        worklist.pop_back();
+        for (const uint32_t successor : function.blocks[block].successors) {
+            if (!reachable[successor]) {
+                reachable[successor] = true;
+                worklist.push_back(successor);
+            }
+        }
+    }
+    for (uint32_t b = 0; b < function.blocks.size(); b++) {
+        if (reachable[b]) continue;
+        IrBlock &block = function.blocks[b];
+        while (!block.successors.empty()) {
+            if (reachable[block.successors.back()]) removeEdge(function, b, block.successors.back());
+            else block.successors.pop_back();
+        }
+        block.phis.clear();
+        block.code.clear();
+        block.predecessors.clear();
+    }
+}
+
+/**
+ * @brief Quita de los bloques las instrucciones marcadas, conservando el orden del resto.
+ */
+inline void IrOptimizer::compact(IrFunction &function, const std::vector<bool> &removed) {
+    const auto erase = [&removed](std::vector<uint32_t> &list) {
+        list.erase(std::remove_if(list.begin(), list.end(), [&removed](const uint32_t id) { return removed[id]; }),
+                   list.end());
+    };
+    for (IrBlock &block : function.blocks) {
+        erase(block.phis);
+        erase(block.code);
+    }
+}
+
+/**
+ * @brief Bloques alcanzables en orden posterior inverso desde la entrada.
+ */
+inline std::vector<uint32_t> IrOptimizer::reversePostorder(const IrFunction &function) {
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> state(function.blocks.size(), 0);
+    std::vector<std::pair<uint32_t, size_t>> stack{{0, 0}};
+    state[0] = 1;
+    while (!stack.empty()) {
+        auto &top = stack.back();
+        const std::vector<uint32_t> &successors = function.blocks[top.first].successors;
+        if (top.second < successors.size()) {
+            const uint32_t next = successors[top.second++];
+            if (state[next] == 0) {
+                state[next] = 1;
+                stack.emplace_back(next, 0);
+            }
+            continue;
+        }
+        order.push_back(top.first);
+        stack.pop_back();
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/**
+ * @brief Dominador inmediato de cada bloque (Cooper, Harvey y Kennedy).
+ * @param order Bloques en orden posterior inverso.
+ * @return idom[b]; la entrada es su propio dominador y los bloques inalcanzables quedan en UINT32_MAX.
+ */
+inline std::vector<uint32_t> IrOptimizer::dominators(const IrFunction &function, const std::vector<uint32_t> &order) {
+    std::vector<uint32_t> rank(function.blocks.size(), UINT32_MAX);
+    for (size_t i = 0; i < order.size(); i++) rank[order[i]] = static_cast<uint32_t>(i);
+    std::vector<uint32_t> idom(function.blocks.size(), UINT32_MAX);
+    idom[0] = 0;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < order.size(); i++) {
+            const uint32_t block = order[i];
+            uint32_t candidate = UINT32_MAX;
+            for (const uint32_t predecessor : function.blocks[block].predecessors) {
+                if (idom[predecessor] == UINT32_MAX) continue;
+                if (candidate == UINT32_MAX) {
+                    candidate = predecessor;
+                    continue;
+                }
+                uint32_t a = predecessor;
+                uint32_t b = candidate;
+                while (a != b) {
+                    while (rank[a] > rank[b]) a = idom[a];
+                    while (rank[b] > rank[a]) b = idom[b];
+                }
+                candidate = a;
+            }
+            if (candidate != idom[block]) {
+                idom[block] = candidate;
+                changed = true;
+            }
+        }
+    }
+    return idom;
+}
+
+/**
+ * @brief Indica si el bloque @p a domina al bloque @p b.
+ */
+inline bool IrOptimizer::dominates(const std::vector<uint32_t> &idom, const std::vector<uint32_t> &rank,
+                                   const uint32_t a, uint32_t b) {
+    while (rank[b] > rank[a]) b = idom[b];
+    return a == b;
+}
+
+/**
+ * @brief Propagación de constantes con plegado y eliminación de ramas constantes.
+ * * Recorre los bloques hasta un punto fijo: una instrucción numérica con operandos
+ * constantes y una φ cuyos operandos son la misma constante pasan a ser CONST en su lugar, de
+ * modo que sus usos no cambian. Un BRANCH con condición constante se convierte en JUMP y los
+ * bloques que dejan de ser alcanzables se eliminan.
+ */
+inline void IrOptimizer::propagateConstants(IrFunction &function) {
+    INSTRUMENT_SCOPE("ir.constants");
+    removeUnreachable(function);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t b = 0; b < function.blocks.size(); b++) {
+            IrBlock &block = function.blocks[b];
+            for (const uint32_t id : block.phis) {
+                IrInstruction &phi = function.instructions[id];
+                if (phi.op != IrOp::PHI || phi.count == 0) continue;
+                const IrInstruction &first = function.instructions[function.operands[phi.first]];
+                bool same = first.op == IrOp::CONST;
+                for (uint32_t i = 1; i < phi.count && same; i++) {
+                    same = sameConstant(first, function.instructions[function.operands[phi.first + i]]);
+                }
+                if (!same) continue;
+                phi.constant = first.constant;
+                phi.op = IrOp::CONST;
+                phi.count = 0;
+                changed = true;
+            }
+
+            for (const uint32_t id : block.code) {
+                IrInstruction &instruction = function.instructions[id];
+                NumberValue value;
+                if (fold(function, instruction, value)) {
+                    instruction.op = IrOp::CONST;
+                    instruction.constant = value;
+                    instruction.count = 0;
+                    changed = true;
+                }
+            }
+
+            if (block.code.empty()) continue;
+            IrInstruction &terminator = function.instructions[block.code.back()];
+            if (terminator.op != IrOp::BRANCH || !isConstant(function, function.operands[terminator.first])) continue;
+            const bool taken = asDouble(function.instructions[function.operands[terminator.first]]) != 0.0;
+            const uint32_t dropped = block.successors[taken ? 1 : 0];
+            terminator.op = IrOp::JUMP;
+            terminator.count = 0;
+            removeEdge(function, b, dropped);
+            changed = true;
+        }
+        if (changed) removeUnreachable(function);
+    }
+
+    std::vector<bool> removed(function.instructions.size(), false);
+    for (const IrBlock &block : function.blocks) {
+        for (const uint32_t id : block.phis) {
+            if (function.instructions[id].op != IrOp::CONST) continue;
+            removed[id] = true;
+        }
+    }
+    // Una φ plegada deja de ser φ: se reinserta como constante al inicio del código del bloque.
+    for (IrBlock &block : function.blocks) {
+        std::vector<uint32_t> folded;
+        for (const uint32_t id : block.phis) {
+            if (removed[id]) folded.push_back(id);
+        }
+        if (folded.empty()) continue;
+        block.phis.erase(std::remove_if(block.phis.begin(), block.phis.end(),
+                                        [&removed](const uint32_t id) { return removed[id]; }), block.phis.end());
+        block.code.insert(block.code.begin(), folded.begin(), folded.end());
+    }
+}
+
+/**
+ * @brief Propagación de copias: sustituye cada copia por su origen en todos los usos.
+ * * En SSA las copias son las φ triviales (todos sus operandos son el mismo valor o la propia
+ * φ) y las conversiones a un tipo que el operando ya tiene. Eliminar una φ puede volver
+ * trivial a otra, así que se repite hasta un punto fijo antes de reescribir los operandos.
+ */
+inline void IrOptimizer::propagateCopies(IrFunction &function) {
+    INSTRUMENT_SCOPE("ir.copies");
+    std::vector<uint32_t> replacement(function.instructions.size());
+    for (uint32_t i = 0; i < replacement.size(); i++) replacement[i] = i;
+    const auto resolve = [&replacement](uint32_t value) {
+        while (replacement[value] != value) value = replacement[value] = replacement[replacement[value]];
+        return value;
+    };
+
+    std::vector<bool> removed(function.instructions.size(), false);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const IrBlock &block : function.blocks) {
+            for (const uint32_t id : block.phis) {
+                if (removed[id]) continue;
+                const IrInstruction &phi = function.instructions[id];
+                uint32_t unique = UINT32_MAX;
+                bool trivial = true;
+                for (uint32_t i = 0; i < phi.count && trivial; i++) {
+                    const uint32_t operand = resolve(function.operands[phi.first + i]);
+                    if (operand == id || operand == unique) continue;
+                    trivial = unique == UINT32_MAX;
+                    unique = operand;
+                }
+                if (!trivial || unique == UINT32_MAX) continue;
+                replacement[id] = unique;
+                removed[id] = true;
+                changed = true;
+            }
+            for (const uint32_t id : block.code) {
+                const IrInstruction &instruction = function.instructions[id];
+                if (removed[id] || instruction.op != IrOp::CONVERT) continue;
+                const uint32_t operand = resolve(function.operands[instruction.first]);
+                if (function.instructions[operand].type != instruction.type) continue;
+                replacement[id] = operand;
+                removed[id] = true;
+                changed = true;
+            }
+        }
+    }
+
+    for (const IrBlock &block : function.blocks) {
+        for (const std::vector<uint32_t>* list : {&block.phis, &block.code}) {
+            for (const uint32_t id : *list) {
+                const IrInstruction &instruction = function.instructions[id];
+                for (uint32_t i = 0; i < instruction.count; i++) {
+                    function.operands[instruction.first + i] = resolve(function.operands[instruction.first + i]);
+                }
+            }
+        }
+    }
+    compact(function, removed);
+}
+
+/**
+ * @brief Saca de los bucles el código invariante.
+ * * Un bucle natural es el conjunto de bloques que llegan a una arista de retorno t → h sin
+ * pasar por h, con h dominando a t. Se procesan de menor a mayor tamaño, para que lo que sale
+ * de un bucle interno pueda salir también del externo. Se mueven al final del preencabezado
+ * (el único predecesor externo de h, con h como único sucesor) las instrucciones puras cuyos
+ * operandos se definen fuera del bucle, recorriendo el cuerpo en orden posterior inverso.
+ * ARRAY_LOAD solo sale del encabezado, que se ejecuta siempre que se entra al bucle, y si el
+ * bucle no escribe en ese arreglo; las divisiones enteras que pueden fallar no se mueven.
+ */
+inline void IrOptimizer::hoistLoopInvariants(IrFunction &function) {
+    INSTRUMENT_SCOPE("ir.licm");
+    const std::vector<uint32_t> order = reversePostorder(function);
+    const std::vector<uint32_t> idom = dominators(function, order);
+    std::vector<uint32_t> rank(function.blocks.size(), UINT32_MAX);
+    for (size_t i = 0; i < order.size(); i++) rank[order[i]] = static_cast<uint32_t>(i);
+
+    struct Loop {
+        uint32_t header;
+        std::vector<uint32_t> latches;
+        std::vector<uint32_t> body;
+    };
+    std::vector<Loop> loops;
+    std::vector<bool> inside(function.blocks.size(), false);
+    for (const uint32_t header : order) {
+        Loop loop{header, {}, {header}};
+        for (const uint32_t predecessor : function.blocks[header].predecessors) {
+            if (rank[predecessor] != UINT32_MAX && dominates(idom, rank, header, predecessor)) loop.latches.push_back(predecessor);
+        }
+        if (loop.latches.empty()) continue;
+        inside[header] = true;
+        std::vector<uint32_t> worklist = loop.latches;
+        while (!worklist.empty()) {
+            const uint32_t block = worklist.back();
+            worklist.pop_back();
+            if (inside[block] || rank[block] == UINT32_MAX) continue;
+            inside[block] = true;
+            loop.body.push_back(block);
+            for (const uint32_t predecessor : function.blocks[block].predecessors) worklist.push_back(predecessor);
+        }
+        for (const uint32_t block : loop.body) inside[block] = false;
+        std::sort(loop.body.begin(), loop.body.end(), [&rank](const uint32_t a, const uint32_t b) { return rank[a] < rank[b]; });
+        loops.push_back(std::move(loop));
+    }
+    std::stable_sort(loops.begin(), loops.end(), [](const Loop &a, const Loop &b) { return a.body.size() < b.body.size(); });
+
+    std::vector<bool> inLoop(function.blocks.size(), false);
+    std::vector<bool> hoisted(function.instructions.size(), false);
+    for (const Loop &loop : loops) {
+        uint32_t preheader = UINT32_MAX;
+        for (const uint32_t block : loop.body) inLoop[block] = true;
+        for (const uint32_t predecessor : function.blocks[loop.header].predecessors) {
+            if (inLoop[predecessor]) continue;
+            preheader = preheader == UINT32_MAX ? predecessor : UINT32_MAX - 1;
+        }
+
+        std::vector<uint32_t> stored;
+        for (const uint32_t block : loop.body) {
+            for (const uint32_t id : function.blocks[block].code) {
+                const IrInstruction &instruction = function.instructions[id];
+                if (instruction.op == IrOp::ARRAY_STORE) stored.push_back(function.operands[instruction.first]);
+            }
+        }
+
+        const bool usable = preheader < UINT32_MAX - 1 && function.blocks[preheader].successors.size() == 1;
+        for (const uint32_t block : loop.body) {
+            if (!usable) break;
+            std::vector<uint32_t> &code = function.blocks[block].code;
+            std::vector<uint32_t> moved;
+            for (const uint32_t id : code) {
+                IrInstruction &instruction = function.instructions[id];
+                bool pure = instruction.op == IrOp::CONST || instruction.op == IrOp::STRING || instruction.op == IrOp::CONVERT ||
+                            instruction.op == IrOp::UNARY || instruction.op == IrOp::BINARY || instruction.op == IrOp::CALL;
+                if (instruction.op == IrOp::ARRAY_LOAD) {
+                    const uint32_t array = function.operands[instruction.first];
+                    pure = block == loop.header && std::find(stored.begin(), stored.end(), array) == stored.end();
+                }
+                if (!pure || mayTrap(function, instruction)) continue;
+                bool invariant = true;
+                for (uint32_t i = 0; i < instruction.count && invariant; i++) {
+                    invariant = !inLoop[function.instructions[function.operands[instruction.first + i]].block];
+                }
+                if (!invariant) continue;
+                instruction.block = preheader;
+                hoisted[id] = true;
+                moved.push_back(id);
+            }
+            if (moved.empty()) continue;
+            code.erase(std::remove_if(code.begin(), code.end(), [&hoisted](const uint32_t id) { return hoisted[id]; }),
+                       code.end());
+            std::vector<uint32_t> &target = function.blocks[preheader].code;
+            target.insert(target.end() - 1, moved.begin(), moved.end());
+            for (const uint32_t id : moved) hoisted[id] = false;
+        }
+        for (const uint32_t block : loop.body) inLoop[block] = false;
+    }
+}
+
+/**
+ * @brief Instrucción que no puede eliminarse aunque su valor no se use: un efecto (ARRAY_STORE,
+ * EXPORT), un terminador o una operación que puede fallar al ejecutarse (véase mayTrap()), ya
+ * que el error es un resultado observable.
+ */
+inline bool IrOptimizer::isRoot(const IrFunction &function, const IrInstruction &instruction) {
+    switch (instruction.op) {
+        case IrOp::ARRAY_STORE:
+        case IrOp::EXPORT:
+        case IrOp::JUMP:
+        case IrOp::BRANCH:
+        case IrOp::RETURN:
+        case IrOp::ARRAY_LOAD: return true;
+        case IrOp::ARRAY_NEW: {
+            const IrInstruction &size = function.instructions[function.operands[instruction.first]];
+            return size.op != IrOp::CONST || size.type != ValueType::INT || size.constant.integer < 0;
+        }
+        default: return mayTrap(function, instruction);
+    }
+}
+
+/**
+ * @brief Eliminación de código muerto por marcado desde los efectos observables.
+ * * Las raíces son las instrucciones de isRoot(): efectos, terminadores y operaciones que pueden
+ * fallar (lecturas de arreglos, divisiones enteras por un divisor no constante, tamaños de
+ * arreglo no constantes). Se marca todo lo que alcanzan sus operandos y se elimina el resto,
+ * incluidas las φ que solo se usan entre sí.
+ */
+inline void IrOptimizer::eliminateDeadCode(IrFunction &function) {
+    INSTRUMENT_SCOPE("ir.dce");
+    std::vector<bool> live(function.instructions.size(), false);
+    std::vector<uint32_t> worklist;
+    for (const IrBlock &block : function.blocks) {
+        for (const uint32_t id : block.code) {
+            if (isRoot(function, function.instructions[id])) {
+                live[id] = true;
+                worklist.push_back(id);
+            }
+        }
+    }
+    while (!worklist.empty()) {
+        const IrInstruction &instruction = function.instructions[worklist.back()];
+        worklist.pop_back();
+        for (uint32_t i = 0; i < instruction.count; i++) {
+            const uint32_t operand = function.operands[instruction.first + i];
+            if (live[operand]) continue;
+            live[operand] = true;
+            worklist.push_back(operand);
+        }
+    }
+
+    std::vector<bool> removed(function.instructions.size(), false);
+    for (size_t i = 0; i < removed.size(); i++) removed[i] = !live[i];
+    compact(function, removed);
+}
+
+/**
+ * @brief Ejecuta todas las pasadas en orden y mide cada una.
+ * * Las copias se propagan antes y después de las constantes: las φ que quedan con un solo
+ * operando al eliminar ramas son copias nuevas.
+ * @return Una entrada por pasada, con el número de instrucciones antes y después.
+ */
+inline std::vector<IrPassStats> IrOptimizer::optimize(IrFunction &function) {
+    INSTRUMENT_SCOPE("optimizeIr");
+    struct Pass {
+        const char* name;
+        void (*run)(IrFunction &);
+    };
+    static const Pass passes[] = {
+        {"copy-propagation", propagateCopies},
+        {"constant-propagation", propagateConstants},
+        {"copy-propagation", propagateCopies},
+        {"loop-invariant-code-motion", hoistLoopInvariants},
+        {"dead-code-elimination", eliminateDeadCode},
+    };
+
+    std::vector<IrPassStats> stats;
+    for (const Pass &pass : passes) {
+        const size_t before = function.instructionCount();
+        const auto start = std::chrono::steady_clock::now();
+        pass.run(function);
+        const double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        stats.push_back(IrPassStats{pass.name, before, function.instructionCount(), elapsed});
+    }
+    return stats;
+}
+
+#endif
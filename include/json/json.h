@@ -0,0 +1,448 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../number_parser/number_parser.h"
+
+/**
+ * @brief Valor JSON (RFC 8259) con lectura y escritura compacta, para los mensajes JSON-RPC.
+ * * Los objetos guardan sus miembros en orden de inserción en dos vectores paralelos; los
+ * mensajes del protocolo tienen pocas claves, así que la búsqueda lineal es más barata que un
+ * mapa. Las cadenas se guardan en UTF-8 y los números como double, leídos con NumberParser para
+ * no depender del locale.
+ */
+class JsonValue {
+
+    public:
+        enum class Kind : uint8_t {
+            NUL,
+            BOOLEAN,
+            NUMBER,
+            STRING,
+            ARRAY,
+            OBJECT
+        };
+
+    private:
+        Kind kind = Kind::NUL;
+        bool boolean = false;
+        double number = 0;
+        std::string text;
+        std::vector<std::string> keys;
+        std::vector<JsonValue> values;
+
+        static void skipSpace(const std::string &source, size_t &position);
+        static void fail(const char* message, size_t position);
+        static JsonValue parseValue(const std::string &source, size_t &position, int depth);
+        static std::string parseString(const std::string &source, size_t &position);
+        static void appendCodePoint(std::string &out, uint32_t codePoint);
+        static void writeString(std::string &out, const std::string &value);
+
+    public:
+        static const int MAX_DEPTH = 256;
+
+        JsonValue() = default;
+        JsonValue(bool value);
+        JsonValue(int value);
+        JsonValue(uint32_t value);
+        JsonValue(int64_t value);
+        JsonValue(size_t value);
+        JsonValue(double value);
+        JsonValue(const char* value);
+        JsonValue(std::string value);
+        static JsonValue array();
+        static JsonValue object();
+        static JsonValue parse(const std::string &source);
+
+        Kind getKind() const;
+        bool isNull() const;
+        bool asBool() const;
+        double asNumber() const;
+        int64_t asInteger() const;
+        const std::string &asString() const;
+        size_t size() const;
+        const JsonValue &operator[](size_t index) const;
+        const JsonValue &get(const std::string &key) const;
+        bool has(const std::string &key) const;
+
+        JsonValue &set(const std::string &key, JsonValue value);
+        JsonValue &push(JsonValue value);
+        void reserve(size_t count);
+        void write(std::string &out) const;
+        std::string dump() const;
+};
+
+inline JsonValue::JsonValue(const bool value) : kind(Kind::BOOLEAN), boolean(value) {}
+
+inline JsonValue::JsonValue(const int value) : kind(Kind::NUMBER), number(value) {}
+
+inline JsonValue::JsonValue(const uint32_t value) : kind(Kind::NUMBER), number(value) {}
+
+inline JsonValue::JsonValue(const int64_t value) : kind(Kind::NUMBER), number(static_cast<double>(value)) {}
+
+inline JsonValue::JsonValue(const size_t value) : kind(Kind::NUMBER), number(static_cast<double>(value)) {}
+
+inline JsonValue::JsonValue(const double value) : kind(Kind::NUMBER), number(value) {}
+
+inline JsonValue::JsonValue(const char* value) : kind(Kind::STRING), text(value) {}
+
+inline JsonValue::JsonValue(std::string value) : kind(Kind::STRING), text(std::move(value)) {}
+
+inline JsonValue JsonValue::array() {
+    JsonValue value;
+    value.kind = Kind::ARRAY;
+    return value;
+}
+
+inline JsonValue JsonValue::object() {
+    JsonValue value;
+    value.kind = Kind::OBJECT;
+    return value;
+}
+
+inline void JsonValue::fail(const char* message, const size_t position) {
+    throw std::out_of_range(std::string(message) + " at offset " + std::to_string(position));
+}
+
+inline void JsonValue::skipSpace(const std::string &source, size_t &position) {
+    while (position < source.size() && (source[position] == ' ' || source[position] == '\t' ||
+                                        source[position] == '\n' || source[position] == '\r')) {
+        ++position;
+    }
+}
+
+/**
+ * @brief Analiza un documento JSON completo.
+ * @throw std::out_of_range Si el texto no es JSON válido o anida más de MAX_DEPTH niveles.
+ */
+inline JsonValue JsonValue::parse(const std::string &source) {
+    size_t position = 0;
+    JsonValue value = parseValue(source, position, 0);
+    skipSpace(source, position);
+    if (position != source.size()) fail("Unexpected data after JSON value", position);
+    return value;
+}
+
+inline JsonValue JsonValue::parseValue(const std::string &source, size_t &position, const int depth) {
+    if (depth > MAX_DEPTH) fail("JSON nested too deeply", position);
+    skipSpace(source, position);
+    if (position >= source.size()) fail("Unexpected end of JSON", position);
+    const char c = source[position];
+    if (c == '{' || c == '[') {
+        const bool isObject = c == '{';
+        const char close = isObject ? '}' : ']';
+        JsonValue value = isObject ? object() : array();
+        ++position;
+        skipSpace(source, position);
+        if (position < source.size() && source[position] == close) {
+            ++position;
+            return value;
+        }
+        while (true) {
+            skipSpace(source, position);
+            if (isObject) {
+                if (position >= source.size() || source[position] != '"') fail("Expected string key", position);
+                value.keys.push_back(parseString(source, position));
+                skipSpace(source, position);
+                if (position >= source.size() || source[position] != ':') fail("Expected ':'", position);
+                ++position;
+            }
+            value.values.push_back(parseValue(source, position, depth + 1));
+            skipSpace(source, position);
+            if (position < source.size() && source[position] == ',') {
+                ++position;
+                continue;
+            }
+            if (position < source.size() && source[position] == close) {
+                ++position;
+                return value;
+            }
+            fail(isObject ? "Expected ',' or '}'" : "Expected ',' or ']'", position);
+        }
+    }
+    if (c == '"') return JsonValue(parseString(source, position));
+    if (source.compare(position, 4, "true") == 0) {
+        position += 4;
+        return JsonValue(true);
+    }
+    if (source.compare(position, 5, "false") == 0) {
+        position += 5;
+        return JsonValue(false);
+    }
+    if (source.compare(position, 4, "null") == 0) {
+        position += 4;
+        return JsonValue();
+    }
+    const size_t start = position;
+    if (position < source.size() && source[position] == '-') ++position;
+    const auto digits = [&] {
+        const size_t first = position;
+        while (position < source.size() && source[position] >= '0' && source[position] <= '9') ++position;
+        return position > first;
+    };
+    if (!digits()) fail("Invalid JSON value", start);
+    if (position < source.size() && source[position] == '.') {
+        ++position;
+        if (!digits()) fail("Invalid number", start);
+    }
+    if (position < source.size() && (source[position] == 'e' || source[position] == 'E')) {
+        ++position;
+        if (position < source.size() && (source[position] == '+' || source[position] == '-')) ++position;
+        if (!digits()) fail("Invalid number", start);
+    }
+    NumberValue value;
+    const char* first = source.data() + start + (source[start] == '-' ? 1 : 0);
+    if (!NumberParser::parse(first, source.data() + position, value)) fail("Invalid number", start);
+    return JsonValue(source[start] == '-' ? -value.asDouble() : value.asDouble());
+}
+
+inline void JsonValue::appendCodePoint(std::string &out, const uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+/**
+ * @brief Lee una cadena entre comillas desde @c position, decodificando los escapes; los pares
+ * sustitutos de UTF-16 se unen en un único carácter UTF-8 y uno suelto se cambia por U+FFFD.
+ */
+inline std::string JsonValue::parseString(const std::string &source, size_t &position) {
+    const size_t start = position++;
+    std::string out;
+    const auto hex = [&](uint32_t &code) {
+        if (position + 4 > source.size()) fail("Invalid \\u escape", position);
+        code = 0;
+        for (int k = 0; k < 4; k++) {
+            const char digit = source[position++];
+            code <<= 4;
+            if (digit >= '0' && digit <= '9') code |= static_cast<uint32_t>(digit - '0');
+            else if ((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f') code |= static_cast<uint32_t>((digit | 0x20) - 'a' + 10);
+            else fail("Invalid \\u escape", position - 1);
+        }
+    };
+    while (true) {
+        const size_t run = source.find_first_of("\"\\", position);
+        if (run == std::string::npos) fail("Unterminated string", start);
+        out.append(source, position, run - position);
+        position = run + 1;
+        if (source[run] == '"') return out;
+        if (position >= source.size()) fail("Unterminated string", start);
+        const char escape = source[position++];
+        switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t code = 0;
+                hex(code);
+                if (code >= 0xD800 && code <= 0xDBFF && source.compare(position, 2, "\\u") == 0) {
+                    const size_t save = position;
+                    position += 2;
+                    uint32_t low = 0;
+                    hex(low);
+                    if (low >= 0xDC00 && low <= 0xDFFF) code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    else position = save;
+                }
+                appendCodePoint(out, code >= 0xD800 && code <= 0xDFFF ? 0xFFFD : code);
+                break;
+            }
+            default: fail("Invalid escape", position - 1);
+        }
+    }
+}
+
+inline JsonValue::Kind JsonValue::getKind() const {
+    return this->kind;
+}
+
+inline bool JsonValue::isNull() const {
+    return this->kind == Kind::NUL;
+}
+
+inline bool JsonValue::asBool() const {
+    return this->kind == Kind::BOOLEAN && this->boolean;
+}
+
+/**
+ * @return El número; 0 si el valor no es un número.
+ */
+inline double JsonValue::asNumber() const {
+    return this->kind == Kind::NUMBER ? this->number : 0;
+}
+
+inline int64_t JsonValue::asInteger() const {
+    return static_cast<int64_t>(this->asNumber());
+}
+
+/**
+ * @return La cadena; vacía si el valor no es una cadena.
+ */
+inline const std::string &JsonValue::asString() const {
+    static const std::string empty;
+    return this->kind == Kind::STRING ? this->text : empty;
+}
+
+/**
+ * @brief Elementos de un arreglo o miembros de un objeto; 0 para los demás valores.
+ */
+inline size_t JsonValue::size() const {
+    return this->values.size();
+}
+
+/**
+ * @return El elemento; un valor nulo si el índice no existe.
+ */
+inline const JsonValue &JsonValue::operator[](const size_t index) const {
+    static const JsonValue missing;
+    return index < this->values.size() ? this->values[index] : missing;
+}
+
+/**
+ * @return El miembro @c key de un objeto; un valor nulo si no existe o el valor no es un objeto.
+ */
+inline const JsonValue &JsonValue::get(const std::string &key) const {
+    static const JsonValue missing;
+    for (size_t i = 0; i < this->keys.size(); i++) {
+        if (this->keys[i] == key) return this->values[i];
+    }
+    return missing;
+}
+
+inline bool JsonValue::has(const std::string &key) const {
+    for (const std::string &candidate : this->keys) {
+        if (candidate == key) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Añade o reemplaza un miembro; convierte un valor nulo en objeto.
+ * @return El propio objeto, para encadenar llamadas.
+ */
+inline JsonValue &JsonValue::set(const std::string &key, JsonValue value) {
+    if (this->kind == Kind::NUL) this->kind = Kind::OBJECT;
+    for (size_t i = 0; i < this->keys.size(); i++) {
+        if (this->keys[i] == key) {
+            this->values[i] = std::move(value);
+            return *this;
+        }
+    }
+    this->keys.push_back(key);
+    this->values.push_back(std::move(value));
+    return *this;
+}
+
+/**
+ * @brief Añade un elemento al final; convierte un valor nulo en arreglo.
+ */
+inline JsonValue &JsonValue::push(JsonValue value) {
+    if (this->kind == Kind::NUL) this->kind = Kind::ARRAY;
+    this->values.push_back(std::move(value));
+    return *this;
+}
+
+inline void JsonValue::reserve(const size_t count) {
+    this->values.reserve(count);
+}
+
+inline void JsonValue::writeString(std::string &out, const std::string &value) {
+    out += '"';
+    for (const char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief Escribe el valor en JSON compacto, en una sola línea. Los enteros exactos se escriben
+ * sin decimales y los números no finitos como null.
+ */
+inline void JsonValue::write(std::string &out) const {
+    switch (this->kind) {
+        case Kind::NUL: out += "null"; break;
+        case Kind::BOOLEAN: out += this->boolean ? "true" : "false"; break;
+        case Kind::NUMBER: {
+            if (!std::isfinite(this->number)) {
+                out += "null";
+            } else if (this->number == std::floor(this->number) && std::fabs(this->number) < 9007199254740992.0) {
+                char buffer[24];
+                out.append(buffer, static_cast<size_t>(std::to_chars(buffer, buffer + sizeof(buffer),
+                                                                     static_cast<long long>(this->number)).ptr - buffer));
+            } else {
+                std::ostringstream stream;
+                stream.imbue(std::locale::classic());
+                stream.precision(17);
+                stream << this->number;
+                out += stream.str();
+            }
+            break;
+        }
+        case Kind::STRING: writeString(out, this->text); break;
+        case Kind::ARRAY:
+            out += '[';
+            for (size_t i = 0; i < this->values.size(); i++) {
+                if (i > 0) out += ',';
+                this->values[i].write(out);
+            }
+            out += ']';
+            break;
+        case Kind::OBJECT:
+            out += '{';
+            for (size_t i = 0; i < this->keys.size(); i++) {
+                if (i > 0) out += ',';
+                writeString(out, this->keys[i]);
+                out += ':';
+                this->values[i].write(out);
+            }
+            out += '}';
+            break;
+    }
+}
+
+inline std::string JsonValue::dump() const {
+    std::string out;
+    this->write(out);
+    return out;
+}
+
+#endif
@@ -0,0 +1,487 @@
+#ifndef DOCUMENT_INDEX_H
+#define DOCUMENT_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../lexical_analyzer/lexical_analyzer.h"
+#include "../program_parser/program_parser.h"
+#include "../builtin_functions/builtin_functions.h"
+#include "../utf8/utf8.h"
+
+/**
+ * @brief Unidad en la que el cliente LSP cuenta las columnas: bytes UTF-8 o unidades UTF-16.
+ */
+enum class PositionEncoding : uint8_t {
+    UTF8,
+    UTF16
+};
+
+/**
+ * @brief Error de un documento, en bytes del texto.
+ */
+struct DocumentDiagnostic {
+    uint32_t offset;
+    uint32_t length;
+    std::string message;
+};
+
+enum class SemanticTokenType : uint8_t {
+    KEYWORD,
+    VARIABLE,
+    FUNCTION,
+    NUMBER,
+    STRING,
+    OPERATOR
+};
+
+/**
+ * @brief Token coloreable; @c declaration marca el nombre de una declaración.
+ */
+struct SemanticToken {
+    uint32_t offset;
+    uint32_t length;
+    SemanticTokenType type;
+    bool declaration;
+};
+
+/**
+ * @brief Índice en memoria de un documento abierto: texto, inicios de línea y tokens por línea.
+ * * Una edición vuelve a tokenizar desde la primera línea afectada con el LexerState guardado a su
+ * entrada y se detiene en cuanto el estado al comienzo de una línea posterior coincide con el que
+ * esa línea tenía antes de la edición; de ahí en adelante los tokens se reutilizan desplazando sus
+ * offsets. Una edición dentro de una línea vuelve a tokenizar esa línea y nada más, salvo que
+ * abra o cierre una cadena o un comentario de bloque, o caiga dentro de una cadena de varias
+ * líneas, que se vuelve a tokenizar hasta su comilla de cierre.
+ * * El árbol sintáctico, los diagnósticos y las definiciones se recalculan con ProgramParser
+ * sobre los tokens ya indexados, y solo cuando se piden después de un cambio.
+ */
+class DocumentIndex {
+
+    private:
+        struct LineTokens {
+            LexerState entry;
+            std::vector<NodeStruct> tokens;
+        };
+
+        LexicalAnalyzer lexer;
+        std::string text;
+        std::vector<uint32_t> lineStarts;
+        std::vector<LineTokens> lines;
+        LexerState exit;
+        std::vector<NodeStruct> tail;
+        ArrayList<NodeStruct> scratch;
+        size_t relexedLines = 0;
+        bool analyzed = false;
+        bool parsed = false;
+        std::vector<DocumentDiagnostic> diagnostics;
+        std::unordered_map<uint32_t, int32_t> uses;
+        std::vector<uint32_t> declarations;
+
+        size_t lineOf(size_t offset) const;
+        size_t lineEnd(size_t line) const;
+        void tokenizeLine(size_t line, LexerState &state, std::vector<NodeStruct> &tokens);
+        static size_t shift(size_t offset, size_t end, int64_t delta);
+        static void shiftState(LexerState &state, size_t end, int64_t delta);
+        static bool sameState(const LexerState &current, const LexerState &previous, size_t end, int64_t delta);
+        void finish();
+        std::vector<const NodeStruct*> allTokens() const;
+        void analyze();
+
+    public:
+        DocumentIndex(std::shared_ptr<const TokenProvider> provider, std::string text);
+        void setText(std::string text);
+        void replace(size_t start, size_t end, const std::string &replacement);
+        const std::string &getText() const;
+        size_t getLineCount() const;
+        size_t getLineStart(size_t line) const;
+        size_t getTokenCount() const;
+        size_t getRelexedLines() const;
+        size_t units(size_t from, size_t to, PositionEncoding encoding) const;
+        size_t offsetAt(size_t line, size_t character, PositionEncoding encoding) const;
+        void positionOf(size_t offset, PositionEncoding encoding, size_t &line, size_t &character) const;
+        const NodeStruct* tokenAt(size_t offset) const;
+        const std::vector<DocumentDiagnostic> &getDiagnostics();
+        bool findDefinition(size_t offset, size_t &declaration, size_t &length);
+        std::vector<SemanticToken> semanticTokens() const;
+};
+
+/**
+ * @param provider Configuración léxica compartida; no se vuelve a cargar por documento.
+ * @param text Contenido inicial del documento.
+ */
+inline DocumentIndex::DocumentIndex(std::shared_ptr<const TokenProvider> provider, std::string text)
+    : lexer(std::move(provider)) {
+    this->setText(std::move(text));
+}
+
+/**
+ * @brief Reemplaza todo el contenido y lo tokeniza desde cero.
+ */
+inline void DocumentIndex::setText(std::string text) {
+    this->text = std::move(text);
+    this->lineStarts.assign(1, 0);
+    for (const char* p = this->text.data(), *end = p + this->text.size();
+         (p = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)))) != nullptr; ++p) {
+        this->lineStarts.push_back(static_cast<uint32_t>(p - this->text.data()) + 1);
+    }
+    this->lines.assign(this->lineStarts.size(), LineTokens());
+    LexerState state;
+    for (size_t line = 0; line < this->lines.size(); line++) {
+        this->lines[line].entry = state;
+        this->tokenizeLine(line, state, this->lines[line].tokens);
+    }
+    this->exit = state;
+    this->relexedLines = this->lines.size();
+    this->finish();
+}
+
+inline size_t DocumentIndex::lineOf(const size_t offset) const {
+    return static_cast<size_t>(std::upper_bound(this->lineStarts.begin(), this->lineStarts.end(),
+                                                static_cast<uint32_t>(offset)) - this->lineStarts.begin()) - 1;
+}
+
+/**
+ * @brief Desplazamiento del final de una línea, sin el salto.
+ */
+inline size_t DocumentIndex::lineEnd(const size_t line) const {
+    return line + 1 < this->lineStarts.size() ? this->lineStarts[line + 1] - 1 : this->text.size();
+}
+
+/**
+ * @brief Tokeniza una línea del texto actual a partir de @c state, que queda como estado de salida.
+ * * La línea vacía que sigue a un salto final no se analiza, igual que en tokenize(std::ifstream&),
+ * que no la ve.
+ */
+inline void DocumentIndex::tokenizeLine(const size_t line, LexerState &state, std::vector<NodeStruct> &tokens) {
+    tokens.clear();
+    const size_t start = this->lineStarts[line];
+    const size_t length = this->lineEnd(line) - start;
+    if (length == 0 && line > 0 && line + 1 == this->lineStarts.size()) return;
+    this->lexer.tokenizeLine(this->text.data() + start, length, start, this->scratch, state);
+    tokens.reserve(static_cast<size_t>(this->scratch.getSize()));
+    for (Node<NodeStruct>* node = this->scratch.getFirst(); node != nullptr; node = node->getNextNode()) {
+        tokens.push_back(node->getDataRef());
+    }
+    this->scratch.clear();
+}
+
+/**
+ * @brief Traslada un desplazamiento anterior a una edición que terminaba en @c end: lo que
+ * estaba antes de la edición no se mueve.
+ */
+inline size_t DocumentIndex::shift(const size_t offset, const size_t end, const int64_t delta) {
+    return offset < end ? offset : static_cast<size_t>(static_cast<int64_t>(offset) + delta);
+}
+
+inline void DocumentIndex::shiftState(LexerState &state, const size_t end, const int64_t delta) {
+    state.stringOffset = shift(state.stringOffset, end, delta);
+    state.lineOffset = shift(state.lineOffset, end, delta);
+    state.lineEnd = shift(state.lineEnd, end, delta);
+}
+
+/**
+ * @brief Compara el estado obtenido al volver a tokenizar con el que tenía la línea antes de la
+ * edición, cuyos offsets todavía no están trasladados.
+ * * Una cadena abierta antes del final de la edición nunca coincide: la edición pudo cambiar su
+ * extensión en el código (p. ej. al escapar una comilla) sin cambiar el cuerpo decodificado, y el
+ * token que la cierra debe volver a emitirse con su desplazamiento y longitud nuevos.
+ */
+inline bool DocumentIndex::sameState(const LexerState &current, const LexerState &previous, const size_t end,
+                                     const int64_t delta) {
+    if (current.blockComment != previous.blockComment || current.inString != previous.inString) return false;
+    if (current.inString && previous.stringOffset < end) return false;
+    return !current.inString || (current.quoteChar == previous.quoteChar &&
+                                 current.pendingString == previous.pendingString &&
+                                 current.stringOffset == shift(previous.stringOffset, end, delta));
+}
+
+/**
+ * @brief Emite, como tokenize(), la cadena que sigue abierta al final del texto.
+ */
+inline void DocumentIndex::finish() {
+    LexerState state = this->exit;
+    LexicalAnalyzer::finishState(this->scratch, state);
+    this->tail.clear();
+    for (Node<NodeStruct>* node = this->scratch.getFirst(); node != nullptr; node = node->getNextNode()) {
+        this->tail.push_back(node->getDataRef());
+    }
+    this->scratch.clear();
+    this->analyzed = false;
+}
+
+/**
+ * @brief Reemplaza el rango de bytes [start, end) y actualiza los tokens de forma incremental.
+ * @throw std::out_of_range Si el rango no está dentro del texto.
+ */
+inline void DocumentIndex::replace(const size_t start, const size_t end, const std::string &replacement) {
+    if (start > end || end > this->text.size()) throw std::out_of_range("Invalid edit range");
+    const size_t first = this->lineOf(start);
+    const size_t oldLast = this->lineOf(end);
+    const int64_t delta = static_cast<int64_t>(replacement.size()) - static_cast<int64_t>(end - start);
+    this->text.replace(start, end - start, replacement);
+
+    std::vector<uint32_t> inserted;
+    for (size_t i = 0; i < replacement.size(); i++) {
+        if (replacement[i] == '\n') inserted.push_back(static_cast<uint32_t>(start + i + 1));
+    }
+    this->lineStarts.erase(this->lineStarts.begin() + static_cast<std::ptrdiff_t>(first + 1),
+                           this->lineStarts.begin() + static_cast<std::ptrdiff_t>(oldLast + 1));
+    for (size_t k = first + 1; k < this->lineStarts.size(); k++) {
+        this->lineStarts[k] = static_cast<uint32_t>(static_cast<int64_t>(this->lineStarts[k]) + delta);
+    }
+    this->lineStarts.insert(this->lineStarts.begin() + static_cast<std::ptrdiff_t>(first + 1), inserted.begin(), inserted.end());
+    const size_t newLast = first + inserted.size();
+
+    LexerState state = this->lines[first].entry;
+    std::vector<LineTokens> fresh;
+    size_t line = first;
+    size_t old = oldLast + 1;
+    while (line <= newLast || (old < this->lines.size() && !sameState(state, this->lines[old].entry, end, delta))) {
+        LineTokens tokens;
+        tokens.entry = state;
+        this->tokenizeLine(line, state, tokens.tokens);
+        fresh.push_back(std::move(tokens));
+        if (line++ > newLast) ++old;
+    }
+
+    const size_t reused = this->lines.size() - old;
+    this->lines.erase(this->lines.begin() + static_cast<std::ptrdiff_t>(first), this->lines.begin() + static_cast<std::ptrdiff_t>(old));
+    this->lines.insert(this->lines.begin() + static_cast<std::ptrdiff_t>(first),
+                       std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()));
+    if (reused == 0) {
+        this->exit = state;
+    } else if (delta != 0) {
+        for (size_t k = this->lines.size() - reused; k < this->lines.size(); k++) {
+            shiftState(this->lines[k].entry, end, delta);
+            for (NodeStruct &token : this->lines[k].tokens) token.offset = static_cast<uint32_t>(shift(token.offset, end, delta));
+        }
+        shiftState(this->exit, end, delta);
+    }
+    this->relexedLines = fresh.size();
+    this->finish();
+}
+
+inline const std::string &DocumentIndex::getText() const {
+    return this->text;
+}
+
+inline size_t DocumentIndex::getLineCount() const {
+    return this->lines.size();
+}
+
+inline size_t DocumentIndex::getLineStart(const size_t line) const {
+    return this->lineStarts[line];
+}
+
+inline size_t DocumentIndex::getTokenCount() const {
+    size_t count = this->tail.size();
+    for (const LineTokens &line : this->lines) count += line.tokens.size();
+    return count;
+}
+
+/**
+ * @brief Líneas que la última edición volvió a tokenizar.
+ */
+inline size_t DocumentIndex::getRelexedLines() const {
+    return this->relexedLines;
+}
+
+/**
+ * @brief Columnas que ocupa el texto [from, to) en la codificación del cliente. Los caracteres
+ * fuera del plano básico cuentan dos unidades UTF-16; los tramos ASCII se saltan con asciiPrefix().
+ */
+inline size_t DocumentIndex::units(size_t from, const size_t to, const PositionEncoding encoding) const {
+    if (encoding == PositionEncoding::UTF8) return to - from;
+    size_t count = 0;
+    while (from < to) {
+        const size_t ascii = Utf8::asciiPrefix(this->text.data() + from, to - from);
+        from += ascii;
+        count += ascii;
+        if (from >= to) break;
+        const unsigned char byte = static_cast<unsigned char>(this->text[from++]);
+        if ((byte & 0xC0) != 0x80) count += byte >= 0xF0 ? 2 : 1;
+    }
+    return count;
+}
+
+/**
+ * @brief Traduce una posición LSP (línea y columna desde 0) a desplazamiento en bytes. Una
+ * columna más allá del final de la línea se ajusta al final y una línea inexistente, al final del texto.
+ */
+inline size_t DocumentIndex::offsetAt(const size_t line, const size_t character, const PositionEncoding encoding) const {
+    if (line >= this->lineStarts.size()) return this->text.size();
+    size_t offset = this->lineStarts[line];
+    const size_t end = this->lineEnd(line);
+    if (encoding == PositionEncoding::UTF8) return std::min(offset + character, end);
+    size_t count = 0;
+    while (offset < end && count < character) {
+        const size_t ascii = Utf8::asciiPrefix(this->text.data() + offset, std::min(end - offset, character - count));
+        offset += ascii;
+        count += ascii;
+        if (offset >= end || count >= character) break;
+        uint32_t codePoint = 0;
+        const size_t size = Utf8::decode(this->text.data() + offset, this->text.data() + end, codePoint);
+        count += size == 4 ? 2 : 1;
+        offset += size != 0 ? size : 1;
+    }
+    return offset;
+}
+
+inline void DocumentIndex::positionOf(const size_t offset, const PositionEncoding encoding, size_t &line,
+                                      size_t &character) const {
+    const size_t clamped = std::min(offset, this->text.size());
+    line = this->lineOf(clamped);
+    character = this->units(this->lineStarts[line], clamped, encoding);
+}
+
+/**
+ * @brief Token que contiene el byte @c offset, o que termina justo en él (el cursor tras un nombre).
+ * @return nullptr si no hay ninguno.
+ */
+inline const NodeStruct* DocumentIndex::tokenAt(const size_t offset) const {
+    const NodeStruct* touching = nullptr;
+    for (const NodeStruct &token : this->lines[this->lineOf(std::min(offset, this->text.size()))].tokens) {
+        if (offset >= token.offset && offset < token.offset + token.length) return &token;
+        if (offset == token.offset + token.length) touching = &token;
+    }
+    return touching;
+}
+
+inline std::vector<const NodeStruct*> DocumentIndex::allTokens() const {
+    std::vector<const NodeStruct*> tokens;
+    tokens.reserve(this->getTokenCount());
+    for (const LineTokens &line : this->lines) {
+        for (const NodeStruct &token : line.tokens) tokens.push_back(&token);
+    }
+    for (const NodeStruct &token : this->tail) tokens.push_back(&token);
+    return tokens;
+}
+
+/**
+ * @brief Recalcula diagnósticos y definiciones: un error por token UNKNOWN (la cadena sin cerrar
+ * del final, si la hay, es el único token de @c tail) y el primer error de ProgramParser, salvo
+ * que caiga sobre uno de esos tokens.
+ */
+inline void DocumentIndex::analyze() {
+    if (this->analyzed) return;
+    this->analyzed = true;
+    this->diagnostics.clear();
+    this->uses.clear();
+    this->declarations.clear();
+    std::vector<const NodeStruct*> tokens = this->allTokens();
+    for (const NodeStruct* token : tokens) {
+        if (token->type != TokenType::UNKNOWN) continue;
+        std::string message = "Unknown token '" + token->name + "'";
+        if (!this->tail.empty() && token == &this->tail.front()) message = "Unterminated string literal";
+        else if (this->lexer.getTokenProvider()->isTextDelimiter(this->text[token->offset])) message = "Invalid UTF-8 in string literal";
+        this->diagnostics.push_back(DocumentDiagnostic{token->offset, token->length, message});
+    }
+
+    try {
+        const ProgramStruct program = ProgramParser::parse(std::move(tokens));
+        for (const ExpressionNode &expression : program.expressions) {
+            if (expression.kind == ExpressionKind::VARIABLE) this->uses[expression.offset] = expression.symbol;
+        }
+        for (size_t slot = 0; slot < program.variables.size(); slot++) {
+            this->declarations.push_back(program.variables[slot].offset);
+            this->uses[program.variables[slot].offset] = static_cast<int32_t>(slot);
+        }
+        this->parsed = true;
+    } catch (const std::exception &e) {
+        this->parsed = false;
+        std::string message = e.what();
+        size_t offset = this->text.size();
+        const size_t at = message.rfind(" at offset ");
+        if (at != std::string::npos) {
+            offset = std::min(static_cast<size_t>(std::strtoull(message.c_str() + at + 11, nullptr, 10)), this->text.size());
+            message.erase(at);
+        }
+        bool duplicate = false;
+        for (const DocumentDiagnostic &diagnostic : this->diagnostics) duplicate = duplicate || diagnostic.offset == offset;
+        const NodeStruct* token = this->tokenAt(offset);
+        const size_t length = token != nullptr && token->offset == offset ? token->length : 0;
+        if (!duplicate) this->diagnostics.push_back(DocumentDiagnostic{static_cast<uint32_t>(offset), static_cast<uint32_t>(length), message});
+    }
+}
+
+inline const std::vector<DocumentDiagnostic> &DocumentIndex::getDiagnostics() {
+    this->analyze();
+    return this->diagnostics;
+}
+
+/**
+ * @brief Declaración de la variable bajo @c offset.
+ * * Si el programa analiza sin errores usa los nombres resueltos por ProgramParser, que respetan
+ * los ámbitos; si no, busca hacia atrás la declaración `tipo nombre` más cercana con el mismo nombre.
+ * @param[out] declaration Desplazamiento del nombre en la declaración.
+ * @param[out] length Bytes del nombre.
+ * @return false si bajo @c offset no hay una variable con declaración conocida.
+ */
+inline bool DocumentIndex::findDefinition(const size_t offset, size_t &declaration, size_t &length) {
+    const NodeStruct* token = this->tokenAt(offset);
+    if (token == nullptr || token->type != TokenType::IDENTIFIER) return false;
+    this->analyze();
+    length = token->name.size();
+    if (this->parsed) {
+        const auto found = this->uses.find(token->offset);
+        if (found == this->uses.end()) return false;
+        declaration = this->declarations[static_cast<size_t>(found->second)];
+        return true;
+    }
+    const std::vector<const NodeStruct*> tokens = this->allTokens();
+    size_t index = static_cast<size_t>(std::find(tokens.begin(), tokens.end(), token) - tokens.begin());
+    while (index-- > 1) {
+        const NodeStruct* candidate = tokens[index];
+        const NodeStruct* type = tokens[index - 1];
+        if (candidate->type == TokenType::IDENTIFIER && candidate->name == token->name && type->type == TokenType::KEYWORD &&
+            (type->name == "int" || type->name == "float" || type->name == "double" || type->name == "string")) {
+            declaration = candidate->offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Tokens coloreables en orden: palabras clave, variables, llamadas a funciones
+ * predefinidas, números, cadenas y operadores. Los delimitadores no se colorean.
+ */
+inline std::vector<SemanticToken> DocumentIndex::semanticTokens() const {
+    const std::vector<const NodeStruct*> tokens = this->allTokens();
+    std::vector<SemanticToken> out;
+    out.reserve(tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const NodeStruct &token = *tokens[i];
+        SemanticToken semantic{token.offset, token.length, SemanticTokenType::OPERATOR, false};
+        switch (token.type) {
+            case TokenType::KEYWORD: semantic.type = SemanticTokenType::KEYWORD; break;
+            case TokenType::VALUE:
+                semantic.type = this->lexer.getTokenProvider()->isTextDelimiter(this->text[token.offset])
+                                ? SemanticTokenType::STRING : SemanticTokenType::NUMBER;
+                break;
+            case TokenType::IDENTIFIER: {
+                const bool call = i + 1 < tokens.size() && tokens[i + 1]->name == "(" && BuiltinFunctions::find(token.name) >= 0;
+                const NodeStruct* previous = i > 0 ? tokens[i - 1] : nullptr;
+                semantic.type = call ? SemanticTokenType::FUNCTION : SemanticTokenType::VARIABLE;
+                semantic.declaration = previous != nullptr && previous->type == TokenType::KEYWORD &&
+                                       (previous->name == "int" || previous->name == "float" ||
+                                        previous->name == "double" || previous->name == "string");
+                break;
+            }
+            case TokenType::OPERATOR:
+            case TokenType::ASSIGNMENT: break;
+            default: continue;
+        }
+        out.push_back(semantic);
+    }
+    return out;
+}
+
+#endif
@@ -0,0 +1,459 @@
+#ifndef LANGUAGE_SERVER_H
+#define LANGUAGE_SERVER_H
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "document_index.h"
+#include "../json/json.h"
+
+/**
+ * @brief Servidor del Language Server Protocol sobre JSON-RPC.
+ * * Mantiene en memoria un DocumentIndex por documento abierto, actualizado con las ediciones
+ * incrementales de didChange, y responde textDocument/definition, textDocument/semanticTokens/full
+ * y textDocument/diagnostic. Si el cliente no pide los diagnósticos, se publican tras cada cambio.
+ * * Cada mensaje se cronometra; los que superan el presupuesto de latencia se cuentan en
+ * getSlowRequests() y se avisan al cliente con window/logMessage.
+ */
+class LanguageServer {
+
+    private:
+        struct OpenDocument {
+            DocumentIndex index;
+            int64_t version;
+        };
+
+        std::shared_ptr<const TokenProvider> provider;
+        std::unordered_map<std::string, OpenDocument> documents;
+        PositionEncoding encoding = PositionEncoding::UTF16;
+        double latencyBudgetMs;
+        size_t slowRequests = 0;
+        bool initialized = false;
+        bool pullDiagnostics = false;
+        bool shutdownRequested = false;
+        bool exitRequested = false;
+
+        static std::string response(const JsonValue &id, JsonValue result);
+        static std::string rawResponse(const JsonValue &id, const std::string &result);
+        static std::string error(const JsonValue &id, int code, const std::string &message);
+        static std::string notification(const char* method, JsonValue params);
+        OpenDocument &document(const JsonValue &params);
+        JsonValue position(const DocumentIndex &index, size_t offset) const;
+        JsonValue range(const DocumentIndex &index, size_t start, size_t end) const;
+        size_t offsetOf(const DocumentIndex &index, const JsonValue &position) const;
+        JsonValue diagnostics(DocumentIndex &index) const;
+        std::string publishDiagnostics(const std::string &uri, OpenDocument &document) const;
+        JsonValue initialize(const JsonValue &params);
+        JsonValue definition(const JsonValue &params);
+        std::string semanticTokens(const JsonValue &params);
+        void didChange(const JsonValue &params);
+        void dispatch(const std::string &method, const JsonValue &message, std::vector<std::string> &out);
+
+    public:
+        static const int PARSE_ERROR = -32700;
+        static const int INVALID_REQUEST = -32600;
+        static const int METHOD_NOT_FOUND = -32601;
+        static const int INVALID_PARAMS = -32602;
+        static const int INTERNAL_ERROR = -32603;
+        static const int SERVER_NOT_INITIALIZED = -32002;
+
+        explicit LanguageServer(std::shared_ptr<const TokenProvider> provider, double latencyBudgetMs = 50.0);
+        void handle(const std::string &body, std::vector<std::string> &out);
+        int serve(std::istream &in, std::ostream &out, std::ostream* record = nullptr);
+        bool isExitRequested() const;
+        size_t getSlowRequests() const;
+        size_t getDocumentCount() const;
+        static bool readMessage(std::istream &in, std::string &body);
+        static void writeMessage(std::ostream &out, const std::string &body);
+};
+
+/**
+ * @param provider Configuración léxica compartida por todos los documentos.
+ * @param latencyBudgetMs Tiempo máximo esperado por mensaje; los más lentos se avisan.
+ */
+inline LanguageServer::LanguageServer(std::shared_ptr<const TokenProvider> provider, const double latencyBudgetMs)
+    : provider(std::move(provider)), latencyBudgetMs(latencyBudgetMs) {}
+
+inline std::string LanguageServer::response(const JsonValue &id, JsonValue result) {
+    JsonValue message = JsonValue::object();
+    message.set("jsonrpc", "2.0").set("id", id).set("result", std::move(result));
+    return message.dump();
+}
+
+/**
+ * @brief Respuesta cuyo resultado ya está escrito como JSON.
+ */
+inline std::string LanguageServer::rawResponse(const JsonValue &id, const std::string &result) {
+    std::string reply = "{\"jsonrpc\":\"2.0\",\"id\":";
+    id.write(reply);
+    reply += ",\"result\":";
+    reply += result;
+    reply += '}';
+    return reply;
+}
+
+inline std::string LanguageServer::error(const JsonValue &id, const int code, const std::string &message) {
+    JsonValue detail = JsonValue::object();
+    detail.set("code", code).set("message", message);
+    JsonValue reply = JsonValue::object();
+    reply.set("jsonrpc", "2.0").set("id", id).set("error", std::move(detail));
+    return reply.dump();
+}
+
+inline std::string LanguageServer::notification(const char* method, JsonValue params) {
+    JsonValue message = JsonValue::object();
+    message.set("jsonrpc", "2.0").set("method", method).set("params", std::move(params));
+    return message.dump();
+}
+
+/**
+ * @throw std::out_of_range Si el documento de params.textDocument.uri no está abierto.
+ */
+inline LanguageServer::OpenDocument &LanguageServer::document(const JsonValue &params) {
+    const std::string &uri = params.get("textDocument").get("uri").asString();
+    const auto found = this->documents.find(uri);
+    if (found == this->documents.end()) throw std::out_of_range("Unknown document " + uri);
+    return found->second;
+}
+
+inline JsonValue LanguageServer::position(const DocumentIndex &index, const size_t offset) const {
+    size_t line = 0;
+    size_t character = 0;
+    index.positionOf(offset, this->encoding, line, character);
+    JsonValue value = JsonValue::object();
+    value.set("line", line).set("character", character);
+    return value;
+}
+
+inline JsonValue LanguageServer::range(const DocumentIndex &index, const size_t start, const size_t end) const {
+    JsonValue value = JsonValue::object();
+    value.set("start", this->position(index, start)).set("end", this->position(index, end));
+    return value;
+}
+
+inline size_t LanguageServer::offsetOf(const DocumentIndex &index, const JsonValue &position) const {
+    const int64_t line = position.get("line").asInteger();
+    const int64_t character = position.get("character").asInteger();
+    return index.offsetAt(static_cast<size_t>(std::max<int64_t>(line, 0)), static_cast<size_t>(std::max<int64_t>(character, 0)),
+                          this->encoding);
+}
+
+inline JsonValue LanguageServer::diagnostics(DocumentIndex &index) const {
+    const std::vector<DocumentDiagnostic> &found = index.getDiagnostics();
+    JsonValue items = JsonValue::array();
+    items.reserve(found.size());
+    for (const DocumentDiagnostic &diagnostic : found) {
+        JsonValue item = JsonValue::object();
+        item.set("range", this->range(index, diagnostic.offset, diagnostic.offset + diagnostic.length))
+            .set("severity", 1).set("source", "proyectos").set("message", diagnostic.message);
+        items.push(std::move(item));
+    }
+    return items;
+}
+
+inline std::string LanguageServer::publishDiagnostics(const std::string &uri, OpenDocument &document) const {
+    JsonValue params = JsonValue::object();
+    params.set("uri", uri).set("version", document.version).set("diagnostics", this->diagnostics(document.index));
+    return notification("textDocument/publishDiagnostics", std::move(params));
+}
+
+/**
+ * @brief Negocia la codificación de posiciones (UTF-8 si el cliente la ofrece, si no UTF-16) y
+ * anuncia las capacidades del servidor.
+ */
+inline JsonValue LanguageServer::initialize(const JsonValue &params) {
+    const JsonValue &capabilities = params.get("capabilities");
+    const JsonValue &encodings = capabilities.get("general").get("positionEncodings");
+    this->encoding = PositionEncoding::UTF16;
+    for (size_t i = 0; i < encodings.size(); i++) {
+        if (encodings[i].getKind() == JsonValue::Kind::STRING && encodings[i].asString() == "utf-8") {
+            this->encoding = PositionEncoding::UTF8;
+        }
+    }
+    this->pullDiagnostics = capabilities.get("textDocument").has("diagnostic");
+    this->initialized = true;
+
+    JsonValue sync = JsonValue::object();
+    sync.set("openClose", true).set("change", 2);
+    JsonValue tokenTypes = JsonValue::array();
+    for (const char* type : {"keyword", "variable", "function", "number", "string", "operator"}) tokenTypes.push(type);
+    JsonValue legend = JsonValue::object();
+    legend.set("tokenTypes", std::move(tokenTypes)).set("tokenModifiers", JsonValue::array().push("declaration"));
+    JsonValue semantic = JsonValue::object();
+    semantic.set("legend", std::move(legend)).set("full", true);
+
+    JsonValue server = JsonValue::object();
+    server.set("positionEncoding", this->encoding == PositionEncoding::UTF8 ? "utf-8" : "utf-16")
+          .set("textDocumentSync", std::move(sync))
+          .set("definitionProvider", true)
+          .set("semanticTokensProvider", std::move(semantic));
+    if (this->pullDiagnostics) {
+        JsonValue diagnostic = JsonValue::object();
+        diagnostic.set("interFileDependencies", false).set("workspaceDiagnostics", false);
+        server.set("diagnosticProvider", std::move(diagnostic));
+    }
+    JsonValue info = JsonValue::object();
+    info.set("name", "proyectos");
+    JsonValue result = JsonValue::object();
+    result.set("capabilities", std::move(server)).set("serverInfo", std::move(info));
+    return result;
+}
+
+inline JsonValue LanguageServer::definition(const JsonValue &params) {
+    OpenDocument &open = this->document(params);
+    size_t declaration = 0;
+    size_t length = 0;
+    if (!open.index.findDefinition(this->offsetOf(open.index, params.get("position")), declaration, length)) return JsonValue();
+    JsonValue location = JsonValue::object();
+    location.set("uri", params.get("textDocument").get("uri"))
+            .set("range", this->range(open.index, declaration, declaration + length));
+    return location;
+}
+
+/**
+ * @brief Codifica los tokens como quíntuplas relativas (línea, columna, longitud, tipo,
+ * modificadores); un token de varias líneas se recorta al final de la primera. Las posiciones
+ * se calculan avanzando de token en token, sin volver a contar cada línea desde el comienzo.
+ * * El arreglo se escribe directamente como texto: es la única respuesta que crece con el
+ * documento y un JsonValue por entero multiplicaría su memoria y su tiempo.
+ * @return Resultado en JSON, para rawResponse().
+ */
+inline std::string LanguageServer::semanticTokens(const JsonValue &params) {
+    const DocumentIndex &index = this->document(params).index;
+    const std::vector<SemanticToken> tokens = index.semanticTokens();
+    const std::string &text = index.getText();
+    std::string result = "{\"data\":[";
+    result.reserve(result.size() + tokens.size() * 16 + 2);
+    const auto append = [&result](const size_t value) {
+        char buffer[24];
+        result.append(buffer, static_cast<size_t>(std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer));
+        result += ',';
+    };
+    size_t previousLine = 0;
+    size_t previousCharacter = 0;
+    size_t line = 0;
+    size_t character = 0;
+    size_t cursor = 0;
+    for (const SemanticToken &token : tokens) {
+        while (line + 1 < index.getLineCount() && index.getLineStart(line + 1) <= token.offset) {
+            cursor = index.getLineStart(++line);
+            character = 0;
+        }
+        character += index.units(cursor, token.offset, this->encoding);
+        cursor = token.offset;
+        const char* newline = static_cast<const char*>(std::memchr(text.data() + token.offset, '\n', token.length));
+        const size_t end = newline != nullptr ? static_cast<size_t>(newline - text.data()) : token.offset + token.length;
+        append(line - previousLine);
+        append(line == previousLine ? character - previousCharacter : character);
+        append(index.units(token.offset, end, this->encoding));
+        append(static_cast<size_t>(token.type));
+        append(token.declaration ? 1 : 0);
+        previousLine = line;
+        previousCharacter = character;
+    }
+    if (!tokens.empty()) result.pop_back();
+    result += "]}";
+    return result;
+}
+
+/**
+ * @brief Aplica los cambios en orden: con rango se reemplaza ese tramo y sin rango, todo el texto.
+ */
+inline void LanguageServer::didChange(const JsonValue &params) {
+    OpenDocument &open = this->document(params);
+    const JsonValue &changes = params.get("contentChanges");
+    for (size_t i = 0; i < changes.size(); i++) {
+        const JsonValue &change = changes[i];
+        if (!change.has("range")) {
+            open.index.setText(change.get("text").asString());
+            continue;
+        }
+        const JsonValue &edit = change.get("range");
+        const size_t start = this->offsetOf(open.index, edit.get("start"));
+        const size_t end = this->offsetOf(open.index, edit.get("end"));
+        open.index.replace(std::min(start, end), std::max(start, end), change.get("text").asString());
+    }
+    open.version = params.get("textDocument").get("version").asInteger();
+}
+
+inline void LanguageServer::dispatch(const std::string &method, const JsonValue &message, std::vector<std::string> &out) {
+    const JsonValue &params = message.get("params");
+    const bool request = message.has("id");
+    const JsonValue &id = message.get("id");
+
+    if (method == "exit") {
+        this->exitRequested = true;
+        return;
+    }
+    if (this->shutdownRequested) {
+        if (request) out.push_back(error(id, INVALID_REQUEST, "Server is shutting down"));
+        return;
+    }
+    if (method == "initialize") {
+        out.push_back(response(id, this->initialize(params)));
+        return;
+    }
+    if (!this->initialized) {
+        if (request) out.push_back(error(id, SERVER_NOT_INITIALIZED, "Server not initialized"));
+        return;
+    }
+
+    if (method == "shutdown") {
+        this->shutdownRequested = true;
+        this->documents.clear();
+        out.push_back(response(id, JsonValue()));
+    } else if (method == "textDocument/didOpen") {
+        const JsonValue &item = params.get("textDocument");
+        const std::string &uri = item.get("uri").asString();
+        this->documents.erase(uri);
+        OpenDocument &open = this->documents.emplace(uri, OpenDocument{DocumentIndex(this->provider, item.get("text").asString()),
+                                                                       item.get("version").asInteger()}).first->second;
+        if (!this->pullDiagnostics) out.push_back(this->publishDiagnostics(uri, open));
+    } else if (method == "textDocument/didChange") {
+        this->didChange(params);
+        const std::string &uri = params.get("textDocument").get("uri").asString();
+        if (!this->pullDiagnostics) out.push_back(this->publishDiagnostics(uri, this->documents.at(uri)));
+    } else if (method == "textDocument/didClose") {
+        const std::string &uri = params.get("textDocument").get("uri").asString();
+        this->documents.erase(uri);
+        if (!this->pullDiagnostics) {
+            JsonValue cleared = JsonValue::object();
+            cleared.set("uri", uri).set("diagnostics", JsonValue::array());
+            out.push_back(notification("textDocument/publishDiagnostics", std::move(cleared)));
+        }
+    } else if (method == "textDocument/definition") {
+        out.push_back(response(id, this->definition(params)));
+    } else if (method == "textDocument/semanticTokens/full") {
+        out.push_back(rawResponse(id, this->semanticTokens(params)));
+    } else if (method == "textDocument/diagnostic") {
+        JsonValue report = JsonValue::object();
+        report.set("kind", "full").set("items", this->diagnostics(this->document(params).index));
+        out.push_back(response(id, std::move(report)));
+    } else if (request) {
+        out.push_back(error(id, METHOD_NOT_FOUND, "Method not found: " + method));
+    }
+}
+
+/**
+ * @brief Procesa un mensaje y agrega a @c out las respuestas y notificaciones que genera.
+ * * Las notificaciones desconocidas (p. ej. $/cancelRequest o initialized) se ignoran y las
+ * respuestas del cliente no se procesan. Un error dentro de una notificación se descarta, como
+ * indica el protocolo.
+ */
+inline void LanguageServer::handle(const std::string &body, std::vector<std::string> &out) {
+    const auto start = std::chrono::steady_clock::now();
+    JsonValue message;
+    try {
+        message = JsonValue::parse(body);
+    } catch (const std::exception &e) {
+        out.push_back(error(JsonValue(), PARSE_ERROR, e.what()));
+        return;
+    }
+    const JsonValue &method = message.get("method");
+    if (method.getKind() != JsonValue::Kind::STRING) {
+        if (!message.has("id")) out.push_back(error(JsonValue(), INVALID_REQUEST, "Missing method"));
+        return;
+    }
+
+    try {
+        this->dispatch(method.asString(), message, out);
+    } catch (const std::out_of_range &e) {
+        if (message.has("id")) out.push_back(error(message.get("id"), INVALID_PARAMS, e.what()));
+    } catch (const std::exception &e) {
+        if (message.has("id")) out.push_back(error(message.get("id"), INTERNAL_ERROR, e.what()));
+    }
+
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (elapsedMs > this->latencyBudgetMs) {
+        ++this->slowRequests;
+        std::ostringstream text;
+        text << method.asString() << " took " << elapsedMs << " ms (budget " << this->latencyBudgetMs << " ms)";
+        JsonValue params = JsonValue::object();
+        params.set("type", 2).set("message", text.str());
+        out.push_back(notification("window/logMessage", std::move(params)));
+    }
+}
+
+/**
+ * @brief Atiende mensajes de @c in hasta recibir exit o llegar al final de la entrada.
+ * @param record Si no es nulo, recibe cada mensaje en una línea para reproducir la sesión
+ * con bench_lsp.
+ * @return 0 si exit llegó después de shutdown; 1 en otro caso.
+ */
+inline int LanguageServer::serve(std::istream &in, std::ostream &out, std::ostream* record) {
+    std::string body;
+    std::vector<std::string> replies;
+    while (!this->exitRequested && readMessage(in, body)) {
+        if (record != nullptr) {
+            std::string line = body;
+            for (char &c : line) {
+                if (c == '\n' || c == '\r') c = ' ';
+            }
+            *record << line << '\n';
+        }
+        replies.clear();
+        this->handle(body, replies);
+        for (const std::string &reply : replies) writeMessage(out, reply);
+        out.flush();
+    }
+    return this->exitRequested && this->shutdownRequested ? 0 : 1;
+}
+
+inline bool LanguageServer::isExitRequested() const {
+    return this->exitRequested;
+}
+
+/**
+ * @brief Mensajes que superaron el presupuesto de latencia.
+ */
+inline size_t LanguageServer::getSlowRequests() const {
+    return this->slowRequests;
+}
+
+inline size_t LanguageServer::getDocumentCount() const {
+    return this->documents.size();
+}
+
+/**
+ * @brief Lee un mensaje con encabezados `Content-Length`.
+ * @return false al final de la entrada o si falta el encabezado.
+ */
+inline bool LanguageServer::readMessage(std::istream &in, std::string &body) {
+    std::string header;
+    size_t length = 0;
+    bool found = false;
+    while (std::getline(in, header)) {
+        if (!header.empty() && header.back() == '\r') header.pop_back();
+        if (header.empty()) {
+            if (!found) continue;
+            body.resize(length);
+            in.read(&body[0], static_cast<std::streamsize>(length));
+            return static_cast<size_t>(in.gcount()) == length;
+        }
+        const size_t colon = header.find(':');
+        std::string name = header.substr(0, colon);
+        for (char &c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (colon != std::string::npos && name == "content-length") {
+            length = static_cast<size_t>(std::strtoull(header.c_str() + colon + 1, nullptr, 10));
+            found = true;
+        }
+    }
+    return false;
+}
+
+inline void LanguageServer::writeMessage(std::ostream &out, const std::string &body) {
+    out << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+}
+
+#endif
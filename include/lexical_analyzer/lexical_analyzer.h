@@ -5,35 +5,162 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
 #include "../interface/node_struct.h"
 #include "../array_list/array_list.h"
 #include "../token_provider/token_provider.h"
+#include "../number_parser/number_parser.h"
+#include "../instrumentation/instrumentation.h"
+#include "../block_reader/block_reader.h"
+#include "../source_map/source_map.h"
+#include "../utf8/utf8.h"
 
+/**
+ * @brief Estado del análisis que se arrastra de una línea a la siguiente.
+ * @note @c blockComment es el índice (basado en 1) de la sintaxis de comentario de bloque abierta; 0 si no hay ninguna.
+ * @note Mientras @c inString es verdadero, @c pendingString guarda el cuerpo ya decodificado de una cadena
+ * que continúa en la línea siguiente y @c stringOffset el desplazamiento de su comilla de apertura.
+ * @note @c lineOffset y @c lineEnd delimitan, en bytes del código fuente, la línea en análisis.
+ */
+struct LexerState {
+    size_t blockComment = 0;
+    bool inString = false;
+    char quoteChar = '\0';
+    std::string pendingString;
+    size_t stringOffset = 0;
+    size_t lineOffset = 0;
+    size_t lineEnd = 0;
+};
+
+/**
+ * @brief Valor de cada byte como dígito hexadecimal de un escape `\uXXXX`; 0xFF si no lo es.
+ * Como la tabla CharClass, no depende del locale ni del signo de @c char.
+ */
+struct HexDigitTable {
+    uint8_t values[256];
+
+    constexpr HexDigitTable() : values() {
+        for (int c = 0; c < 256; c++) values[c] = 0xFF;
+        for (int c = 0; c < 10; c++) values['0' + c] = static_cast<uint8_t>(c);
+        for (int c = 0; c < 6; c++) {
+            values['a' + c] = static_cast<uint8_t>(10 + c);
+            values['A' + c] = static_cast<uint8_t>(10 + c);
+        }
+    }
+};
+
+static constexpr HexDigitTable HEX_DIGITS{};
+
+/**
+ * @brief Analizador léxico.
+ * * La configuración de tokens (TokenProvider) es inmutable tras la carga y puede compartirse
+ * entre instancias e hilos; todo el estado de un análisis (líneas y tokens) vive en la pila de
+ * la llamada a tokenize(), por lo que una misma instancia puede tokenizar varios archivos,
+ * incluso de forma concurrente, sin que los resultados se acumulen.
+ */
 class LexicalAnalyzer {
 
     private:
-        ArrayList<std::string> arrayLines;
-        ArrayList<NodeStruct> dictionary;
+        std::shared_ptr<const TokenProvider> tokenProvider;
+        bool releaseSource = false;
+        bool nextLine(ArrayList<std::string> &arrayLines) const;
         TokenType wordAnalyzer(const std::string& word) const;
         TokenType letterAnalyzer(const std::string& letter) const;
-        void splitLine(std::ifstream &code);
-        void addToken(const std::string& name, TokenType type, double value, int line, int word);
+        static void splitLine(std::ifstream &code, ArrayList<std::string> &arrayLines);
+        NumberValue numberAnalyzer(const std::string& word, TokenType type) const;
+        static void addToken(ArrayList<NodeStruct> &dictionary, std::string name, TokenType type,
+                             const NumberValue& value, size_t offset, size_t length);
+        static size_t decodeEscape(const char* escape, const char* end, std::string &out);
+        static bool hexQuad(const char* digits, unsigned &code);
+        static TokenType stringType(const char* body, size_t length);
+        size_t scanString(const char* line, size_t length, size_t position, LexerState &state,
+                          ArrayList<NodeStruct> &dictionary) const;
+        void addWord(ArrayList<NodeStruct> &dictionary, const std::string& word, size_t offset) const;
         bool isOperator(char character) const;
+        static const char* findTerminator(const char* first, const char* last, const std::string &terminator);
+        bool startsWith(const char* text, size_t length, const std::string &prefix) const;
+        size_t commentEnd(const char* line, size_t length, size_t position, LexerState &state) const;
+        void tokenizeBlock(const char* data, size_t length, std::string &carry, size_t &lineOffset,
+                           ArrayList<NodeStruct> &dictionary, LexerState &state, SourceMap* sourceMap) const;
 
     public:
         explicit LexicalAnalyzer(std::ifstream &config_file);
-        TokenProvider tokenProvider;
-        ArrayList<NodeStruct> tokenize(std::ifstream &code);
+        explicit LexicalAnalyzer(std::shared_ptr<const TokenProvider> provider);
+        static std::shared_ptr<const TokenProvider> loadProvider(std::ifstream &config_file);
+        const std::shared_ptr<const TokenProvider>& getTokenProvider() const;
+        void tokenizeLine(const char* line, size_t length, size_t lineOffset, ArrayList<NodeStruct> &dictionary,
+                          LexerState &state) const;
+        void tokenizeLine(const std::string &line, size_t lineOffset, ArrayList<NodeStruct> &dictionary,
+                          LexerState &state) const;
+        void tokenizeLine(const std::string &line, size_t lineOffset, ArrayList<NodeStruct> &dictionary) const;
+        static void finishState(ArrayList<NodeStruct> &dictionary, LexerState &state);
+        ArrayList<NodeStruct> tokenize(std::ifstream &code, MemoryFootprint* retainedUsage = nullptr,
+                                       SourceMap* sourceMap = nullptr) const;
+        ArrayList<NodeStruct> tokenize(BlockReader &reader, SourceMap* sourceMap = nullptr) const;
+        void setReleaseSource(bool release);
 };
 
 /**
  * @brief Constructor de la clase LexicalAnalyzer.
  * * Inicializa el analizador léxico y delega la carga de la configuración de tokens
- * al objeto tokenProvider interno utilizando el archivo proporcionado.
+ * a un TokenProvider propio utilizando el archivo proporcionado.
  * * @param config_file Referencia al flujo del archivo (.csv/.txt) con la gramática de tokens.
  */
-inline LexicalAnalyzer::LexicalAnalyzer(std::ifstream &config_file) {
-    LexicalAnalyzer::tokenProvider.loadConfig(config_file);
+inline LexicalAnalyzer::LexicalAnalyzer(std::ifstream &config_file)
+    : tokenProvider(loadProvider(config_file)) {}
+
+/**
+ * @brief Construye un analizador sobre una configuración ya cargada.
+ * * Crear analizadores así es barato (solo copia un shared_ptr), lo que permite compartir una
+ * única carga de lexical_config.csv entre muchos análisis o hilos.
+ * @param provider Configuración de tokens compartida e inmutable.
+ */
+inline LexicalAnalyzer::LexicalAnalyzer(std::shared_ptr<const TokenProvider> provider)
+    : tokenProvider(std::move(provider)) {}
+
+/**
+ * @brief Carga una configuración de tokens lista para compartirse.
+ * @param config_file Flujo del archivo de configuración.
+ * @return Proveedor inmutable de tokens.
+ */
+inline std::shared_ptr<const TokenProvider> LexicalAnalyzer::loadProvider(std::ifstream &config_file) {
+    std::shared_ptr<TokenProvider> provider = std::make_shared<TokenProvider>();
+    provider->loadConfig(config_file);
+    return provider;
+}
+
+/**
+ * @brief Configuración de tokens usada por el analizador.
+ */
+inline const std::shared_ptr<const TokenProvider>& LexicalAnalyzer::getTokenProvider() const {
+    return this->tokenProvider;
+}
+
+/**
+ * @brief Activa la liberación temprana de los datos intermedios del análisis.
+ * * Con la opción activa, cada línea se libera en cuanto se tokeniza, de modo que las líneas
+ * del código y la lista de tokens nunca coexisten completas en memoria.
+ * @param release true para liberar los datos intermedios lo antes posible.
+ */
+inline void LexicalAnalyzer::setReleaseSource(const bool release) {
+    this->releaseSource = release;
+}
+
+/**
+ * @brief Avanza a la siguiente línea del código fuente.
+ * * Si la liberación temprana está activa, la línea ya procesada se elimina de @c arrayLines.
+ * @param arrayLines Líneas del análisis en curso.
+ * @return true si queda una línea por procesar.
+ */
+inline bool LexicalAnalyzer::nextLine(ArrayList<std::string> &arrayLines) const {
+    if (!this->releaseSource) return arrayLines.currentNext();
+    delete arrayLines.removeFirst();
+    return !arrayLines.isEmpty();
 }
 
 /**
@@ -41,13 +168,16 @@ inline LexicalAnalyzer::LexicalAnalyzer(std::ifstream &config_file) {
  * * Lee el archivo de entrada línea por línea y las almacena en la estructura @c arrayLines.
  * Al finalizar la lectura o si ocurre un error, se cierra el flujo del archivo.
  * * @param[in,out] code Referencia al flujo del archivo de código fuente a procesar.
+ * @param[out] arrayLines Lista que recibe las líneas leídas.
  * @note Si el archivo no es válido o no está abierto, se enviará un error a la salida estándar.
  */
-inline void LexicalAnalyzer::splitLine(std::ifstream &code) {
+inline void LexicalAnalyzer::splitLine(std::ifstream &code, ArrayList<std::string> &arrayLines) {
+    INSTRUMENT_SCOPE("splitLine");
     if (code.is_open()) {
         std::string line;
         while (std::getline(code, line)) {
-            this->arrayLines.addLast(line);
+            INSTRUMENT_COUNT(Counter::BYTES_READ, static_cast<long long>(line.length()) + 1);
+            arrayLines.addLast(line);
         }
         code.close();
     } else std::cout << "Error: Unable to open file" << std::endl;
@@ -58,22 +188,24 @@ inline void LexicalAnalyzer::splitLine(std::ifstream &code) {
  * * La lógica de clasificación sigue esta jerarquía de prioridad:
  * 1. Coincidencia exacta con palabras reservadas, operadores o delimitadores en @c tokenProvider.
  * 2. Valores numéricos (literales de tipo VALUE).
- * 3. Identificadores válidos (comienzan con letra o guion bajo).
+ * 3. Identificadores válidos (comienzan con letra, guion bajo o un carácter XID_Start; tokenizeLine
+ * solo empieza una palabra con un byte ≥ 0x80 si decodifica a uno de estos).
  * * @param word Cadena de texto extraída del buffer.
  * @return TypeToken Categoría del token identificada; @c TypeToken::UNKNOWN si no hay coincidencia.
  */
 inline TokenType LexicalAnalyzer::wordAnalyzer(const std::string& word) const {
     if (word.empty()) return TokenType::UNKNOWN;
 
-    if (this->tokenProvider.isToken(word)) {
-        return this->tokenProvider.getToken(word);
+    if (this->tokenProvider->isToken(word)) {
+        return this->tokenProvider->getToken(word);
     }
 
-    if (isdigit(word[0])) {
+    const uint8_t kind = this->tokenProvider->charClass(word[0]);
+    if (kind & CharClass::DIGIT) {
         return TokenType::VALUE;
     }
 
-    if (isalpha(word[0]) || word[0] == '_') {
+    if (kind & (CharClass::IDENT_START | CharClass::NON_ASCII)) {
         return TokenType::IDENTIFIER;
     }
 
@@ -87,8 +219,8 @@ inline TokenType LexicalAnalyzer::wordAnalyzer(const std::string& word) const {
  * @return TypeToken Tipo de token correspondiente o @c TypeToken::UNKNOWN.
  */
 inline TokenType LexicalAnalyzer::letterAnalyzer(const std::string& letter) const {
-    if (this->tokenProvider.isToken(letter)) {
-        return this->tokenProvider.getToken(letter);
+    if (this->tokenProvider->isToken(letter)) {
+        return this->tokenProvider->getToken(letter);
     }
     return TokenType::UNKNOWN;
 }
@@ -96,127 +228,562 @@ inline TokenType LexicalAnalyzer::letterAnalyzer(const std::string& letter) cons
 /**
  * @brief Valida si un carácter debe tratarse como un operador o delimitador.
  * * Un carácter se considera operador si no es un espacio en blanco, no es un punto decimal
- * (para soportar números flotantes) y está registrado como token o no es alfanumérico.
+ * (para soportar números flotantes) y está registrado como token o no es letra, dígito ni '_'.
+ * Se resuelve con la bandera CharClass::OPERATOR de la tabla de TokenProvider.
  * * @param character Carácter individual extraído de la línea.
  * @return true Si el carácter rompe el buffer actual y debe procesarse como operador/delimitador.
- * @return false Si el carácter es alfanumérico, un espacio o un punto decimal.
+ * @return false Si el carácter es alfanumérico, '_', un espacio o un punto decimal.
  */
 inline bool LexicalAnalyzer::isOperator(const char character) const {
-    if (isspace(character)) return false;
-    if (character == '.') return false;
-    std::string s(1, character);
-    if (this->tokenProvider.isToken(s)) return true;
-    return !isalnum(character);
+    return (this->tokenProvider->charClass(character) & CharClass::OPERATOR) != 0;
+}
+
+/**
+ * @brief Obtiene el valor numérico tipado de un literal.
+ * * Solo los tokens VALUE que comienzan con dígito se convierten; el resultado queda en el token
+ * para que las fases posteriores no vuelvan a interpretar el texto.
+ * @param word Lexema del token.
+ * @param type Categoría ya asignada al lexema.
+ * @return Valor INTEGER o FLOAT; @c NumberKind::NONE si el lexema no es un número válido.
+ */
+inline NumberValue LexicalAnalyzer::numberAnalyzer(const std::string& word, const TokenType type) const {
+    NumberValue value;
+    if (type != TokenType::VALUE || word.empty() || !(this->tokenProvider->charClass(word[0]) & CharClass::DIGIT)) return value;
+    if (!NumberParser::parse(word, value)) value = NumberValue();
+    return value;
 }
 
 /**
  * @brief Registra un nuevo token en el diccionario de resultados.
  * * Encapsula la información del token en una estructura @c NodeStruct y la añade al final
  * de la lista de tokens identificados.
- * * @param value Valor textual (lexema) del token.
+ * * @param dictionary Lista de tokens del análisis en curso.
+ * @param name Valor textual (lexema) del token.
  * @param type Categoría gramatical identificada.
- * @param line Número de línea en el código fuente (basado en 1).
- * @param word Índice secuencial del token dentro de su línea.
+ * @param value Valor numérico ya convertido (NONE para tokens no numéricos).
+ * @param offset Desplazamiento en bytes del lexema en el código fuente.
+ * @param length Bytes que ocupa el lexema en el código fuente (comillas incluidas en las cadenas).
+ * @throw std::out_of_range Si el desplazamiento supera NodeStruct::MAX_OFFSET.
  */
-inline void LexicalAnalyzer::addToken(const std::string& name, TokenType type, double value, int line, int word) {
+inline void LexicalAnalyzer::addToken(ArrayList<NodeStruct> &dictionary, std::string name, TokenType type,
+                                      const NumberValue& value, const size_t offset, const size_t length) {
+    if (offset > NodeStruct::MAX_OFFSET) {
+        throw std::out_of_range("Source larger than 4 GiB at offset " + std::to_string(offset));
+    }
     NodeStruct node;
-    node.name = name;
+    node.name = std::move(name);
     node.type = type;
     node.value = value;
-    node.line = line;
-    node.word = word;
-    this->dictionary.addLast(node);
+    node.offset = static_cast<uint32_t>(offset);
+    node.length = static_cast<uint32_t>(length < NodeStruct::MAX_LENGTH ? length : NodeStruct::MAX_LENGTH);
+    dictionary.addLast(std::move(node));
+    INSTRUMENT_COUNT(Counter::TOKENS_PRODUCED, 1);
 }
 
 /**
- * @brief Ejecuta el análisis léxico completo sobre el código fuente.
+ * @brief Clasifica una palabra acumulada en el buffer y la registra como token.
+ * * Una palabra que empieza con dígito pero no es un número válido (p. ej. `1e` o `12abc`) se
+ * registra como UNKNOWN, de modo que ninguna fase posterior la interprete como literal.
+ * @param dictionary Lista de tokens del análisis en curso.
+ * @param word Lexema a registrar.
+ * @param offset Desplazamiento en bytes del primer carácter de la palabra.
+ */
+inline void LexicalAnalyzer::addWord(ArrayList<NodeStruct> &dictionary, const std::string& word,
+                                     const size_t offset) const {
+    TokenType type = this->wordAnalyzer(word);
+    const NumberValue value = numberAnalyzer(word, type);
+    if (type == TokenType::VALUE && value.kind == NumberKind::NONE) type = TokenType::UNKNOWN;
+    addToken(dictionary, word, type, value, offset, word.size());
+}
+
+/**
+ * @brief Busca la primera aparición de @c terminator en [first, last).
+ * * Salta con memchr hasta cada aparición del primer carácter del terminador y solo entonces
+ * compara el resto, de modo que el cuerpo de un comentario se recorre a velocidad de memchr.
+ * @return Puntero al inicio del terminador; nullptr si no aparece.
+ */
+inline const char* LexicalAnalyzer::findTerminator(const char* first, const char* last, const std::string &terminator) {
+    const size_t size = terminator.size();
+    while (static_cast<size_t>(last - first) >= size) {
+        first = static_cast<const char*>(std::memchr(first, terminator[0], static_cast<size_t>(last - first) - size + 1));
+        if (first == nullptr) return nullptr;
+        if (std::memcmp(first, terminator.data(), size) == 0) return first;
+        ++first;
+    }
+    return nullptr;
+}
+
+inline bool LexicalAnalyzer::startsWith(const char* text, const size_t length, const std::string &prefix) const {
+    return prefix.size() <= length && std::memcmp(text, prefix.data(), prefix.size()) == 0;
+}
+
+/**
+ * @brief Reconoce un comentario que empieza en @c position.
+ * * Un comentario de línea consume el resto de la línea. Uno de bloque sin cierre en la misma
+ * línea queda abierto en @c state y consume también el resto de la línea.
+ * @param line Inicio de la línea.
+ * @param length Longitud de la línea.
+ * @param position Posición del posible inicio de comentario.
+ * @param[in,out] state Estado del análisis.
+ * @return Posición siguiente al comentario; std::string::npos si no empieza ningún comentario.
+ */
+inline size_t LexicalAnalyzer::commentEnd(const char* line, const size_t length, const size_t position,
+                                          LexerState &state) const {
+    const char* start = line + position;
+    const size_t remaining = length - position;
+    for (const std::string &prefix : this->tokenProvider->getLineComments()) {
+        if (this->startsWith(start, remaining, prefix)) return length;
+    }
+    const std::vector<BlockComment> &blocks = this->tokenProvider->getBlockComments();
+    for (size_t index = 0; index < blocks.size(); index++) {
+        if (!this->startsWith(start, remaining, blocks[index].open)) continue;
+        const char* close = findTerminator(start + blocks[index].open.size(), line + length, blocks[index].close);
+        if (close == nullptr) {
+            state.blockComment = index + 1;
+            return length;
+        }
+        return static_cast<size_t>(close - line) + blocks[index].close.size();
+    }
+    return std::string::npos;
+}
+
+/**
+ * @brief Decodifica la secuencia de escape que empieza en @c escape (una barra invertida).
+ * * Admite `\n`, `\t`, `\r`, `\0`, `\\`, `\"`, `\'` y `\uXXXX` (codificado en UTF-8). Cualquier otra
+ * secuencia se conserva literalmente.
+ * * Un sustituto alto seguido de `\uXXXX` con un sustituto bajo forma un único carácter
+ * suplementario (U+10000 a U+10FFFF) de cuatro bytes. Un sustituto suelto no es un carácter: se
+ * rechaza dejándolo con su forma de tres bytes (ED A0 80 a ED BF BF), que no es UTF-8 válido, de
+ * modo que stringType() emite la cadena como UNKNOWN.
+ * @param escape Posición de la barra invertida; debe ir seguida de al menos un carácter.
+ * @param end Fin de la línea.
+ * @param[out] out Cadena a la que se añade el carácter decodificado.
+ * @return Número de caracteres consumidos.
+ */
+inline size_t LexicalAnalyzer::decodeEscape(const char* escape, const char* end, std::string &out) {
+    switch (escape[1]) {
+        case 'n': out += '\n'; return 2;
+        case 't': out += '\t'; return 2;
+        case 'r': out += '\r'; return 2;
+        case '0': out += '\0'; return 2;
+        case '\\':
+        case '"':
+        case '\'': out += escape[1]; return 2;
+        case 'u': {
+            unsigned code = 0;
+            if (end - escape < 6 || !hexQuad(escape + 2, code)) break;
+            size_t consumed = 6;
+            unsigned low = 0;
+            if (code >= 0xD800 && code <= 0xDBFF && end - escape >= 12 && escape[6] == '\\' && escape[7] == 'u' &&
+                hexQuad(escape + 8, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                consumed = 12;
+            }
+            if (code < 0x80) {
+                out += static_cast<char>(code);
+            } else if (code < 0x800) {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            return consumed;
+        }
+        default: break;
+    }
+    out.append(escape, 2);
+    return 2;
+}
+
+/**
+ * @brief Lee cuatro dígitos hexadecimales.
+ * @param digits Primer dígito; deben quedar al menos cuatro caracteres.
+ * @param[out] code Valor leído.
+ * @return false si alguno de los cuatro caracteres no es un dígito hexadecimal (según HEX_DIGITS).
+ */
+inline bool LexicalAnalyzer::hexQuad(const char* digits, unsigned &code) {
+    code = 0;
+    for (int k = 0; k < 4; k++) {
+        const uint8_t digit = HEX_DIGITS.values[static_cast<unsigned char>(digits[k])];
+        if (digit == 0xFF) return false;
+        code = code * 16 + digit;
+    }
+    return true;
+}
+
+/**
+ * @brief Categoría de una cadena literal ya decodificada: VALUE si es UTF-8 válido y UNKNOWN si
+ * no, para que las fases siguientes la rechacen como cualquier otro token desconocido.
+ */
+inline TokenType LexicalAnalyzer::stringType(const char* body, const size_t length) {
+    return Utf8::isValid(body, length) ? TokenType::VALUE : TokenType::UNKNOWN;
+}
+
+/**
+ * @brief Consume el cuerpo de una cadena literal desde @c position.
+ * * Busca la comilla de cierre con memchr y copia el cuerpo de una sola vez como un tramo del
+ * código; solo si el tramo contiene barras invertidas se decodifica por partes. Si la línea
+ * termina sin cerrar la cadena, el cuerpo se acumula en @c state junto con el salto de línea
+ * (salvo que la línea acabe en barra invertida, que une ambas líneas). El cuerpo se valida como
+ * UTF-8 al emitir el token (véase stringType()).
+ * @param line Inicio de la línea.
+ * @param length Longitud de la línea.
+ * @param position Primera posición del cuerpo.
+ * @param[in,out] state Estado con la comilla de apertura y el cuerpo pendiente.
+ * @param[out] dictionary Lista que recibe el token al cerrarse la cadena.
+ * @return Posición siguiente a la comilla de cierre; @c length si la cadena sigue abierta.
+ */
+inline size_t LexicalAnalyzer::scanString(const char* line, const size_t length, const size_t position,
+                                          LexerState &state, ArrayList<NodeStruct> &dictionary) const {
+    const char* p = line + position;
+    const char* end = line + length;
+    const char* close = static_cast<const char*>(std::memchr(p, state.quoteChar, static_cast<size_t>(end - p)));
+    const char* limit = close != nullptr ? close : end;
+
+    if (close != nullptr && state.pendingString.empty() &&
+        std::memchr(p, '\\', static_cast<size_t>(limit - p)) == nullptr) {
+        addToken(dictionary, std::string(p, close), stringType(p, static_cast<size_t>(close - p)), NumberValue(),
+                 state.stringOffset, state.lineOffset + static_cast<size_t>(close - line) + 1 - state.stringOffset);
+        state.inString = false;
+        return static_cast<size_t>(close - line) + 1;
+    }
+
+    std::string &body = state.pendingString;
+    bool continuation = false;
+    while (true) {
+        const char* escape = static_cast<const char*>(std::memchr(p, '\\', static_cast<size_t>(limit - p)));
+        if (escape == nullptr) {
+            body.append(p, limit);
+            break;
+        }
+        body.append(p, escape);
+        if (escape + 1 == end) {
+            continuation = true;
+            break;
+        }
+        p = escape + decodeEscape(escape, end, body);
+        if (close != nullptr && close < p) {
+            close = static_cast<const char*>(std::memchr(p, state.quoteChar, static_cast<size_t>(end - p)));
+            limit = close != nullptr ? close : end;
+        }
+    }
+
+    if (close == nullptr) {
+        if (!continuation) body += '\n';
+        return length;
+    }
+    const TokenType type = stringType(body.data(), body.size());
+    addToken(dictionary, std::move(body), type, NumberValue(), state.stringOffset,
+             state.lineOffset + static_cast<size_t>(close - line) + 1 - state.stringOffset);
+    body.clear();
+    state.inString = false;
+    return static_cast<size_t>(close - line) + 1;
+}
+
+/**
+ * @brief Tokeniza una única línea de código y añade sus tokens a la lista indicada.
  * * Implementa una máquina de estados finitos simple que maneja:
- * - Cadenas literales entre comillas (@c TEXT_DELIMITER).
+ * - Cadenas literales entre comillas (@c TEXT_DELIMITER), con secuencias de escape y que pueden
+ * continuar en las líneas siguientes a través de @c state.
  * - Identificación de números flotantes (preservando el punto).
  * - Operadores compuestos de dos caracteres (ej. `==`, `!=`).
  * - Omisión de espacios en blanco.
- * * @param[in] code Flujo de entrada con el código a tokenizar.
- * @return ArrayList<NodeStruct> Lista enlazada con la secuencia de tokens generada.
+ * - Comentarios de línea y de bloque, y líneas de preprocesador, según la configuración. Un
+ * comentario de bloque abierto continúa en las líneas siguientes a través de @c state.
+ * - Cada byte se clasifica con la tabla CharClass de TokenProvider, sin depender del locale ni
+ * del signo de @c char; los tramos de caracteres de palabra se copian al buffer de una vez.
+ * - Los bytes ≥ 0x80 se decodifican como UTF-8: un carácter XID_Start (o XID_Continue dentro de
+ * una palabra) forma parte del identificador; cualquier otro carácter, o un byte que no forme
+ * una secuencia válida, es un token UNKNOWN propio.
+ * * No modifica el estado del analizador, por lo que es seguro invocarla desde varios hilos.
+ * * @param line Inicio de la línea; no necesita terminar en '\0'.
+ * @param length Longitud de la línea sin el salto final.
+ * @param lineOffset Desplazamiento en bytes del inicio de la línea en el código fuente.
+ * @param[out] dictionary Lista que recibe los tokens de la línea.
+ * @param[in,out] state Estado arrastrado desde la línea anterior.
  */
-inline ArrayList<NodeStruct> LexicalAnalyzer::tokenize(std::ifstream &code) {
-    this->splitLine(code);
-    int numLines = 0;
+inline void LexicalAnalyzer::tokenizeLine(const char* line, const size_t length, const size_t lineOffset,
+                                          ArrayList<NodeStruct> &dictionary, LexerState &state) const {
+    std::string buffer;
+    size_t wordStart = 0;
+    size_t start = 0;
+    state.lineOffset = lineOffset;
+    state.lineEnd = lineOffset + length;
 
-    do {
-        std::string buffer;
-        std::string line = this->arrayLines.get()->getData();
-        int numWords = 1;
-        numLines++;
-        bool inString = false;
-        char quoteChar = '\0';
+    //FLUJO PARA CADENAS Y COMENTARIOS DE BLOQUE ABIERTOS, Y LÍNEAS DE PREPROCESADOR
 
-        for (size_t i = 0; i < line.length(); i++) {
-            char c = line[i];
+    if (state.inString) {
+        start = this->scanString(line, length, 0, state, dictionary);
+    } else if (state.blockComment != 0) {
+        const std::string &close = this->tokenProvider->getBlockComments()[state.blockComment - 1].close;
+        const char* end = findTerminator(line, line + length, close);
+        if (end == nullptr) return;
+        state.blockComment = 0;
+        start = static_cast<size_t>(end - line) + close.size();
+    } else if (!this->tokenProvider->getPreprocessorPrefixes().empty()) {
+        size_t first = 0;
+        while (first < length && (this->tokenProvider->charClass(line[first]) & CharClass::SPACE)) first++;
+        for (const std::string &prefix : this->tokenProvider->getPreprocessorPrefixes()) {
+            if (this->startsWith(line + first, length - first, prefix)) return;
+        }
+    }
 
-            //FLUJO PARA CADENAS DE TEXTO
+    const uint8_t* classes = this->tokenProvider->getCharClasses();
+    for (size_t i = start; i < length; i++) {
+        const char c = line[i];
+        const uint8_t kind = classes[static_cast<unsigned char>(c)];
 
-            if (inString) {
-                if (c == quoteChar) {
-                    this->addToken(buffer, TokenType::VALUE, '\0', numLines, numWords++);
-                    buffer.clear();
-                    inString = false;
-                } else buffer += c;
-                continue;
-            }
+        //FLUJO PARA PALABRAS: SE COPIA DE UNA VEZ EL TRAMO HASTA EL PRIMER CARÁCTER QUE LA CORTA
+
+        if (!(kind & CharClass::BREAK)) {
+            if (buffer.empty()) wordStart = i;
+            size_t end = i + 1;
+            while (end < length && !(classes[static_cast<unsigned char>(line[end])] & CharClass::BREAK)) end++;
+            buffer.append(line + i, end - i);
+            i = end - 1;
+            continue;
+        }
+
+        //FLUJO PARA COMENTARIOS
 
-            std::string singleChar(1, c);
-            if (this->tokenProvider.getToken(singleChar) == TokenType::TEXT_DELIMITER) {
+        if (kind & CharClass::COMMENT) {
+            const size_t end = this->commentEnd(line, length, i, state);
+            if (end != std::string::npos) {
                 if (!buffer.empty()) {
-                    this->addToken(buffer, this->wordAnalyzer(buffer), '\0', numLines, numWords++);
+                    this->addWord(dictionary, buffer, lineOffset + wordStart);
                     buffer.clear();
                 }
-                inString = true;
-                quoteChar = c;
+                i = end - 1;
                 continue;
             }
+        }
 
-            //FLUJO PARA ESPACIOS
+        //FLUJO PARA CADENAS DE TEXTO
 
-            if (isspace(c)) {
-                if (!buffer.empty()) {
-                    this->addToken(buffer, this->wordAnalyzer(buffer), '\0',numLines, numWords++);
-                    buffer.clear();
-                }
-                continue;
+        if (kind & CharClass::QUOTE) {
+            if (!buffer.empty()) {
+                this->addWord(dictionary, buffer, lineOffset + wordStart);
+                buffer.clear();
             }
+            state.inString = true;
+            state.quoteChar = c;
+            state.stringOffset = lineOffset + i;
+            i = this->scanString(line, length, i + 1, state, dictionary) - 1;
+            continue;
+        }
+
+        //FLUJO PARA ESPACIOS
+
+        if (kind & CharClass::SPACE) {
+            if (!buffer.empty()) {
+                this->addWord(dictionary, buffer, lineOffset + wordStart);
+                buffer.clear();
+            }
+            continue;
+        }
 
-            //FLUJO PARA OPERADOR INDIVIDUAL Y DOBLE
+        //FLUJO PARA UTF-8: CARÁCTER DE IDENTIFICADOR O UN TOKEN UNKNOWN POR CARÁCTER
 
-            if (isOperator(c)) {
+        if (kind & CharClass::NON_ASCII) {
+            uint32_t codePoint = 0;
+            const size_t size = Utf8::decode(line + i, line + length, codePoint);
+            if (size != 0 && (buffer.empty() ? Utf8::isIdentifierStart(codePoint) : Utf8::isIdentifierContinue(codePoint))) {
+                if (buffer.empty()) wordStart = i;
+                buffer.append(line + i, size);
+            } else {
                 if (!buffer.empty()) {
-                    this->addToken(buffer, this->wordAnalyzer(buffer), '\0',numLines, numWords++);
+                    this->addWord(dictionary, buffer, lineOffset + wordStart);
                     buffer.clear();
                 }
+                const size_t width = size != 0 ? size : 1;
+                addToken(dictionary, std::string(line + i, width), TokenType::UNKNOWN, NumberValue(), lineOffset + i, width);
+            }
+            i += (size != 0 ? size : 1) - 1;
+            continue;
+        }
 
-                std::string op(1, c);
-                if (i + 1 < line.length() && isOperator(line[i + 1])) {
-                    std::string double_op = op + line[i + 1];
-                    if (this->tokenProvider.isToken(double_op)) {
-                        op = double_op;
-                        i++;
-                    }
+        //FLUJO PARA OPERADOR INDIVIDUAL Y DOBLE
+
+        if (kind & CharClass::OPERATOR) {
+            if (!buffer.empty()) {
+                this->addWord(dictionary, buffer, lineOffset + wordStart);
+                buffer.clear();
+            }
+
+            std::string op(1, c);
+            if (i + 1 < length && isOperator(line[i + 1])) {
+                std::string double_op = op + line[i + 1];
+                if (this->tokenProvider->isToken(double_op)) {
+                    op = double_op;
+                    i++;
                 }
-                this->addToken(op, this->letterAnalyzer(op), '\0',numLines, numWords++);
-            } else {
-                buffer += c;
             }
+            addToken(dictionary, op, this->letterAnalyzer(op), NumberValue(), lineOffset + i + 1 - op.size(), op.size());
+        } else {
+            if (buffer.empty()) wordStart = i;
+            buffer += c;
         }
+    }
 
-        //LIMPIAR BUFFER
+    //LIMPIAR BUFFER
 
-        if (!buffer.empty()) {
-            this->addToken(buffer, this->wordAnalyzer(buffer), '\0',numLines, numWords++);
-            buffer.clear();
+    if (!buffer.empty()) {
+        this->addWord(dictionary, buffer, lineOffset + wordStart);
+        buffer.clear();
+    }
+}
+
+/**
+ * @brief Sobrecarga para una línea almacenada en una cadena.
+ */
+inline void LexicalAnalyzer::tokenizeLine(const std::string &line, const size_t lineOffset,
+                                          ArrayList<NodeStruct> &dictionary, LexerState &state) const {
+    this->tokenizeLine(line.data(), line.length(), lineOffset, dictionary, state);
+}
+
+/**
+ * @brief Tokeniza una línea aislada: una cadena o un comentario de bloque sin cerrar terminan con ella.
+ */
+inline void LexicalAnalyzer::tokenizeLine(const std::string &line, const size_t lineOffset,
+                                          ArrayList<NodeStruct> &dictionary) const {
+    LexerState state;
+    this->tokenizeLine(line.data(), line.length(), lineOffset, dictionary, state);
+    finishState(dictionary, state);
+}
+
+/**
+ * @brief Cierra el análisis al final del código: una cadena sin comilla de cierre se emite como
+ * UNKNOWN, de modo que las fases siguientes la rechacen y el diagnóstico apunte al literal.
+ * @param[out] dictionary Lista que recibe el token pendiente, si lo hay.
+ * @param[in,out] state Estado del análisis; queda reiniciado.
+ */
+inline void LexicalAnalyzer::finishState(ArrayList<NodeStruct> &dictionary, LexerState &state) {
+    if (state.inString) {
+        std::string &body = state.pendingString;
+        if (!body.empty() && body.back() == '\n') body.pop_back();
+        addToken(dictionary, std::move(body), TokenType::UNKNOWN, NumberValue(), state.stringOffset,
+                 state.lineEnd - state.stringOffset);
+    }
+    state = LexerState();
+}
+
+/**
+ * @brief Tokeniza las líneas completas de un bloque directamente sobre el búfer de lectura.
+ * * Solo la línea que queda partida entre dos bloques se copia a @c carry; el resto se analiza
+ * sin crear ninguna cadena intermedia.
+ * @param data Inicio del bloque.
+ * @param length Bytes del bloque.
+ * @param[in,out] carry Comienzo de línea pendiente del bloque anterior.
+ * @param[in,out] lineOffset Desplazamiento de la línea pendiente; avanza con cada línea completa.
+ * @param[out] dictionary Lista que recibe los tokens.
+ * @param[in,out] state Estado arrastrado entre líneas.
+ * @param[out] sourceMap Opcional: recibe el inicio de cada línea.
+ */
+inline void LexicalAnalyzer::tokenizeBlock(const char* data, const size_t length, std::string &carry,
+                                           size_t &lineOffset, ArrayList<NodeStruct> &dictionary,
+                                           LexerState &state, SourceMap* sourceMap) const {
+    const char* cursor = data;
+    const char* end = data + length;
+    while (const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)))) {
+        if (sourceMap != nullptr) sourceMap->addLine(lineOffset);
+        size_t lineLength = static_cast<size_t>(newline - cursor);
+        if (carry.empty()) {
+            this->tokenizeLine(cursor, lineLength, lineOffset, dictionary, state);
+        } else {
+            carry.append(cursor, newline);
+            lineLength = carry.size();
+            this->tokenizeLine(carry, lineOffset, dictionary, state);
+            carry.clear();
         }
+        lineOffset += lineLength + 1;
+        cursor = newline + 1;
+    }
+    carry.append(cursor, end);
+}
 
-    } while (this->arrayLines.currentNext());
+/**
+ * @brief Ejecuta el análisis léxico completo sobre el código fuente.
+ * * Lee las líneas del archivo y las tokeniza con tokenizeLine(). Las líneas y la lista de tokens
+ * son locales a la llamada, así que el método es reentrante y seguro entre hilos.
+ * * Con setReleaseSource(true) las líneas se liberan a medida que se procesan.
+ * * @param[in] code Flujo de entrada con el código a tokenizar.
+ * @param[out] retainedUsage Opcional: recibe la memoria de líneas y tokens retenida al terminar el análisis.
+ * @param[out] sourceMap Opcional: recibe el inicio de cada línea para traducir NodeStruct::offset a línea y columna.
+ * @return ArrayList<NodeStruct> Lista enlazada con la secuencia de tokens generada.
+ */
+inline ArrayList<NodeStruct> LexicalAnalyzer::tokenize(std::ifstream &code, MemoryFootprint* retainedUsage,
+                                                       SourceMap* sourceMap) const {
+    INSTRUMENT_SCOPE("tokenize");
+    ArrayList<std::string> arrayLines;
+    ArrayList<NodeStruct> dictionary;
+    splitLine(code, arrayLines);
+    LexerState state;
+    size_t lineOffset = 0;
+    if (sourceMap != nullptr) sourceMap->clear();
+    if (arrayLines.isEmpty()) return dictionary;
+    arrayLines.currentReset();
+
+    do {
+        const std::string &line = arrayLines.get()->getDataRef();
+        if (sourceMap != nullptr) sourceMap->addLine(lineOffset);
+        this->tokenizeLine(line, lineOffset, dictionary, state);
+        lineOffset += line.length() + 1;
+    } while (this->nextLine(arrayLines));
+    finishState(dictionary, state);
+
+    if (retainedUsage != nullptr) {
+        *retainedUsage = arrayLines.footprint();
+        *retainedUsage += dictionary.footprint();
+    }
+    dictionary.currentReset();
+    return dictionary;
+}
+
+/**
+ * @brief Ejecuta el análisis léxico leyendo el código en bloques grandes.
+ * * A diferencia de tokenize(std::ifstream&), no separa el archivo en una lista de líneas: cada
+ * bloque entregado por @c reader se tokeniza en el propio búfer. Produce exactamente los mismos
+ * tokens y desplazamientos.
+ * @param reader Lector de bloques ya abierto.
+ * @param[out] sourceMap Opcional: recibe el inicio de cada línea.
+ * @throw std::system_error Si la lectura falla antes del final del archivo.
+ * @throw std::out_of_range Si el archivo supera NodeStruct::MAX_OFFSET bytes; se rechaza antes de leerlo.
+ * @return ArrayList<NodeStruct> Lista enlazada con la secuencia de tokens generada.
+ */
+inline ArrayList<NodeStruct> LexicalAnalyzer::tokenize(BlockReader &reader, SourceMap* sourceMap) const {
+    INSTRUMENT_SCOPE("tokenizeBlocks");
+    ArrayList<NodeStruct> dictionary;
+    std::string carry;
+    LexerState state;
+    size_t lineOffset = 0;
+    const char* data = nullptr;
+    size_t length = 0;
+    if (sourceMap != nullptr) sourceMap->clear();
+    if (reader.getFileSize() > static_cast<long long>(NodeStruct::MAX_OFFSET)) {
+        throw std::out_of_range("Source larger than 4 GiB (" + std::to_string(reader.getFileSize()) + " bytes)");
+    }
+
+    while (reader.next(data, length)) {
+        this->tokenizeBlock(data, length, carry, lineOffset, dictionary, state, sourceMap);
+    }
+    if (reader.failed()) {
+        throw std::system_error(reader.getError(), std::generic_category(), "Error reading source at offset " +
+                                std::to_string(lineOffset + carry.size()));
+    }
+    if (!carry.empty()) {
+        if (sourceMap != nullptr) sourceMap->addLine(lineOffset);
+        this->tokenizeLine(carry, lineOffset, dictionary, state);
+    }
+    finishState(dictionary, state);
 
-    this->dictionary.currentReset();
-    return this->dictionary;
+    dictionary.currentReset();
+    return dictionary;
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include "../interface/node_struct.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Bytes ocupados por una estructura de datos: nodos enlazados y heap de cadenas.
+ */
+struct MemoryFootprint {
+    size_t nodeBytes = 0;
+    size_t stringBytes = 0;
+
+    size_t total() const { return nodeBytes + stringBytes; }
+    MemoryFootprint& operator+=(const MemoryFootprint &other) {
+        nodeBytes += other.nodeBytes;
+        stringBytes += other.stringBytes;
+        return *this;
+    }
+};
+
+/**
+ * @brief Bytes de heap adicionales de un valor. Por defecto los tipos no reservan heap.
+ */
+template <typename T>
+inline size_t heapBytes(const T &) {
+    return 0;
+}
+
+/**
+ * @brief Bytes de heap de una cadena. Las cadenas cortas (SSO) viven dentro del objeto y cuentan 0.
+ */
+inline size_t heapBytes(const std::string &text) {
+    const char* data = text.data();
+    const char* self = reinterpret_cast<const char*>(&text);
+    if (data >= self && data < self + sizeof(std::string)) return 0;
+    return text.capacity() + 1;
+}
+
+/**
+ * @brief Bytes de heap de un token: solo el lexema, el valor numérico vive en la estructura.
+ */
+inline size_t heapBytes(const NodeStruct &token) {
+    return heapBytes(token.name);
+}
+
+class MemoryUsage {
+
+    public:
+        static size_t currentRssBytes();
+        static size_t peakRssBytes();
+};
+
+/**
+ * @brief Memoria residente actual del proceso.
+ * @return Bytes residentes; 0 si la plataforma no expone /proc/self/statm.
+ */
+inline size_t MemoryUsage::currentRssBytes() {
+#if defined(__linux__)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr) return 0;
+    long pages = 0, resident = 0;
+    const int read = std::fscanf(statm, "%ld %ld", &pages, &resident);
+    std::fclose(statm);
+    if (read != 2) return 0;
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Pico de memoria residente del proceso desde su inicio (getrusage).
+ * @return Bytes; 0 si la plataforma no dispone de getrusage.
+ */
+inline size_t MemoryUsage::peakRssBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+#endif
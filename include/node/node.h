@@ -2,6 +2,8 @@
 #define NODE_H
 
 #include <iostream>
+#include <utility>
+#include "../instrumentation/instrumentation.h"
 
 template <typename T>
 class Node {
@@ -15,6 +17,7 @@ class Node {
         Node(T data);
         void setData(T data);
         T getData();
+        const T& getDataRef() const;
         Node<T>* getNextNode();
         void setNextNode(Node<T>* nextNode);
         Node<T>* getPreviousNode();
@@ -38,7 +41,8 @@ class Node {
  */
 template <typename T>
 Node<T>::Node(T data) {
-    this->data = data;
+    this->data = std::move(data);
+    INSTRUMENT_COUNT(Counter::ALLOCATIONS, 1);
 }
 
 /**
@@ -65,6 +69,18 @@ T Node<T>::getData() {
     return this->data;
 }
 
+/**
+ * @brief Obtiene una referencia constante al dato almacenado en el nodo
+ * @tparam T Tipo de dato almacenado en el nodo
+ * @return Referencia al dato, válida mientras el nodo exista
+ *
+ * @note A diferencia de getData(), no copia el dato; útil para recorridos de solo lectura.
+ */
+template <typename T>
+const T& Node<T>::getDataRef() const {
+    return this->data;
+}
+
 /**
  * @brief Obtiene el siguiente nodo en la lista
  * @tparam T Tipo de dato almacenado en el nodo
@@ -0,0 +1,139 @@
+#ifndef NUMBER_PARSER_H
+#define NUMBER_PARSER_H
+
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <locale>
+#include <sstream>
+#include <string>
+#include "../interface/number_value.h"
+
+/**
+ * @brief Conversión de literales numéricos independiente del locale.
+ * * Acepta enteros decimales (`42`) y flotantes (`5.5`, `20.`, `1e9`, `2.5E-3`). Los enteros
+ * se acumulan directamente en int64; los flotantes usan la vía rápida de Clinger (mantisa
+ * exacta <= 2^53 y exponente decimal <= 22), que es exacta con una sola multiplicación o
+ * división. El resto recurre a la conversión de la biblioteca bajo el locale "C", que
+ * garantiza el redondeo correcto.
+ */
+class NumberParser {
+
+    private:
+        static const double* powersOfTen();
+        static bool slowParse(const char* first, const char* last, double &out);
+
+    public:
+        static bool parse(const char* first, const char* last, NumberValue &out);
+        static bool parse(const std::string &text, NumberValue &out);
+};
+
+/**
+ * @brief Potencias de diez exactamente representables en doble precisión (10^0..10^22).
+ */
+inline const double* NumberParser::powersOfTen() {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    return powers;
+}
+
+/**
+ * @brief Conversión de respaldo con redondeo correcto bajo el locale clásico.
+ * * strtod se usa solo si el locale activo también emplea '.' como separador decimal;
+ * en otro caso se fuerza el locale "C" mediante un flujo.
+ */
+inline bool NumberParser::slowParse(const char* first, const char* last, double &out) {
+    const std::string text(first, last);
+    const lconv* locale = std::localeconv();
+    if (locale != nullptr && locale->decimal_point[0] == '.' && locale->decimal_point[1] == '\0') {
+        char* end = nullptr;
+        out = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size();
+    }
+    std::istringstream stream(text);
+    stream.imbue(std::locale::classic());
+    stream >> out;
+    return !stream.fail();
+}
+
+/**
+ * @brief Convierte el rango [first, last) en un valor numérico tipado.
+ * @param first Inicio del lexema.
+ * @param last Fin (exclusivo) del lexema.
+ * @param[out] out Recibe el valor; su tipo es INTEGER si no hay punto ni exponente y cabe en int64.
+ * @return false si el lexema no es un literal numérico completo.
+ */
+inline bool NumberParser::parse(const char* first, const char* last, NumberValue &out) {
+    const char* p = first;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool overflow = false;
+
+    while (p != last && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            if (mantissa != 0) ++digits;
+        } else {
+            ++exponent;
+            overflow = true;
+        }
+        ++p;
+    }
+    if (p == first) return false;
+
+    bool isFloat = false;
+    if (p != last && *p == '.') {
+        isFloat = true;
+        ++p;
+        while (p != last && *p >= '0' && *p <= '9') {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0) ++digits;
+                --exponent;
+            } else {
+                overflow = true;
+            }
+            ++p;
+        }
+    }
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        isFloat = true;
+        ++p;
+        bool negative = false;
+        if (p != last && (*p == '+' || *p == '-')) negative = *p++ == '-';
+        if (p == last || *p < '0' || *p > '9') return false;
+        int value = 0;
+        while (p != last && *p >= '0' && *p <= '9') {
+            if (value < 100000) value = value * 10 + (*p - '0');
+            ++p;
+        }
+        exponent += negative ? -value : value;
+    }
+    if (p != last) return false;
+
+    if (!isFloat && !overflow && mantissa <= static_cast<uint64_t>(INT64_MAX)) {
+        out.kind = NumberKind::INTEGER;
+        out.integer = static_cast<int64_t>(mantissa);
+        return true;
+    }
+
+    out.kind = NumberKind::FLOAT;
+    if (!overflow && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        const double value = static_cast<double>(mantissa);
+        out.real = exponent < 0 ? value / powersOfTen()[-exponent] : value * powersOfTen()[exponent];
+        return true;
+    }
+    return slowParse(first, last, out.real);
+}
+
+/**
+ * @brief Sobrecarga de conveniencia para cadenas completas.
+ */
+inline bool NumberParser::parse(const std::string &text, NumberValue &out) {
+    return parse(text.data(), text.data() + text.size(), out);
+}
+
+#endif
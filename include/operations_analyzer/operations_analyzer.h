@@ -2,139 +2,660 @@
 #define SYNTAX_ANALYZER_H
 
 #pragma once
+#include <cmath>
 #include <stdexcept>
+#include <vector>
 #include "../include/lexical_analyzer/lexical_analyzer.h"
 #include "../stack/stack.h"
+#include "../small_stack/small_stack.h"
+#include "../expression_cache/expression_cache.h"
+#include "../builtin_functions/builtin_functions.h"
+#include "../symbol_table/symbol_table.h"
 
+/**
+ * @brief Evaluador de expresiones por shunting-yard.
+ * * Admite, de menor a mayor precedencia: el condicional `c ? a : b`, `||`, `&&`, `==` `!=`,
+ * `<` `>` `<=` `>=`, `+` `-`, `*` `/` `%`, los prefijos `-` `+` `!` `++` `--`, la potencia
+ * `**` o `^` (asociativa por la derecha) y, ligados a su operando, los sufijos `++` `--`, el
+ * indexado `a[i]` y las llamadas a BuiltinFunctions. Los identificadores se leen de una
+ * SymbolTable opcional.
+ */
 class OperationsAnalyzer {
 
     private:
+        /**
+         * @brief Valor en la pila de evaluación; @c storage apunta a la variable si es asignable.
+         */
+        struct Operand {
+            double value;
+            std::vector<double>* storage;
+            size_t index;
+        };
+
         ArrayList<NodeStruct> inputTokens;
+        ExpressionCache* cache = nullptr;
+        SymbolTable* symbols = nullptr;
 
         static bool isOperator(TokenType type);
-        static bool isDelimiter(TokenType type);
         static int getPrecedence(const NodeStruct &token);
-        ArrayList<NodeStruct> toPostfix();
-        static double evaluatePostfix(ArrayList<NodeStruct>& postfixTokens);
+        static bool isRightAssociative(int precedence);
+        static bool closes(const NodeStruct &open, const NodeStruct &close);
+        static const NodeStruct &syntheticOperator(const char* name);
+        static int operandCount(OpCode op);
+        static double apply(OpCode op, double left, double right);
+        static bool isConstantExpression(const ArrayList<NodeStruct> &tokens);
 
     public:
         explicit OperationsAnalyzer(const ArrayList<NodeStruct> &tokens);
-        void resolve();
+        explicit OperationsAnalyzer(ArrayList<NodeStruct> &&tokens);
+        MemoryFootprint footprint() const;
+        void setCache(ExpressionCache* expressionCache);
+        void setSymbols(SymbolTable* symbolTable);
+        static ArrayList<NodeStruct> toPostfix(const ArrayList<NodeStruct> &tokens);
+        static bool isCall(const NodeStruct &token);
+        static int resolveCall(const NodeStruct &token);
+        static bool toOpCode(const NodeStruct &token, OpCode &op);
+        static bool compile(const ArrayList<NodeStruct> &postfixTokens, CompiledExpression &out);
+        static double evaluatePostfix(const ArrayList<NodeStruct>& postfixTokens, SymbolTable* symbols);
+        static double execute(const CompiledExpression &program, SymbolTable* symbols = nullptr);
+        static double evaluate(const ArrayList<NodeStruct> &tokens, ExpressionCache* cache, SymbolTable* symbols = nullptr);
+        double evaluate() const;
+        void resolve() const;
     };
 
 inline OperationsAnalyzer::OperationsAnalyzer(const ArrayList<NodeStruct> &tokens) {
     inputTokens = tokens;
 }
 
+/**
+ * @brief Construye el analizador adoptando la lista de tokens sin copiarla.
+ * @param tokens Lista de tokens; queda vacía tras la llamada.
+ */
+inline OperationsAnalyzer::OperationsAnalyzer(ArrayList<NodeStruct> &&tokens) : inputTokens(std::move(tokens)) {}
+
+/**
+ * @brief Memoria retenida por la lista de tokens de entrada.
+ */
+inline MemoryFootprint OperationsAnalyzer::footprint() const {
+    return this->inputTokens.footprint();
+}
+
 inline bool OperationsAnalyzer::isOperator(const TokenType type) {
     return type == TokenType::OPERATOR;
 }
 
-inline bool OperationsAnalyzer::isDelimiter(const TokenType type) {
-    return type == TokenType::OPEN_DELIMITER || type == TokenType::CLOSE_DELIMITER;
+/**
+ * @brief Precedencia de un operador en la pila de shunting-yard.
+ * * 1: `?` `:` | 2: `||` | 3: `&&` | 4: `==` `!=` | 5: `<` `>` `<=` `>=` | 6: `+` `-` |
+ * 7: `*` `/` `%` | 8: prefijos `u-` `!` `++` `--` | 9: `**` `^` | 10: sufijos e indexado.
+ * @return 0 si el token no es un operador.
+ */
+inline int OperationsAnalyzer::getPrecedence(const NodeStruct &token) {
+    if (!isOperator(token.type) || token.name.empty()) return 0;
+    const bool single = token.name.size() == 1;
+    switch (token.name[0]) {
+        case '?': case ':': return 1;
+        case '|': return 2;
+        case '&': return 3;
+        case '=': return 4;
+        case '!': return single ? 8 : 4;
+        case '<': case '>': return 5;
+        case '+': case '-': return single ? 6 : 8;
+        case '*': return single ? 7 : 9;
+        case '/': case '%': return 7;
+        case 'u': return 8;
+        case '^': return 9;
+        case 'x': case '[': return 10;
+        default: return 0;
+    }
 }
 
-inline int OperationsAnalyzer::getPrecedence(const NodeStruct &token) {
-    if (isOperator(token.type)) {
-        if (token.name == "+" || token.name == "-") return 2;
-        if (token.name == "*" || token.name == "/") return 3;
-    } else if (isDelimiter(token.type)) return 1;
-    return 0;
+/**
+ * @brief Los prefijos, la potencia y el condicional se agrupan por la derecha.
+ * @param precedence Valor devuelto por getPrecedence().
+ */
+inline bool OperationsAnalyzer::isRightAssociative(const int precedence) {
+    return precedence == 1 || precedence == 8 || precedence == 9;
+}
+
+/**
+ * @brief Indica si un token postfijo es una llamada; su @c value guarda el número de argumentos.
+ */
+inline bool OperationsAnalyzer::isCall(const NodeStruct &token) {
+    return token.type == TokenType::IDENTIFIER && token.value.kind == NumberKind::INTEGER;
+}
+
+inline bool OperationsAnalyzer::closes(const NodeStruct &open, const NodeStruct &close) {
+    return (open.name == "(" && close.name == ")") || (open.name == "[" && close.name == "]") ||
+           (open.name == "{" && close.name == "}");
+}
+
+/**
+ * @brief Operadores que el analizador léxico no produce y que distinguen usos de un mismo símbolo.
+ * * `u-` es el menos unario, `x++` y `x--` los sufijos (los prefijos conservan `++` y `--`) y
+ * `[]` el indexado. Ninguno puede confundirse con un token real: el léxico los separaría.
+ * @param name Uno de "u-", "x++", "x--" o "[]".
+ */
+inline const NodeStruct &OperationsAnalyzer::syntheticOperator(const char* name) {
+    static const auto make = [](const char* text) {
+        NodeStruct token;
+        token.name = text;
+        token.type = TokenType::OPERATOR;
+        token.offset = 0;
+        token.length = 0;
+        return token;
+    };
+    static const NodeStruct negate = make("u-");
+    static const NodeStruct increment = make("x++");
+    static const NodeStruct decrement = make("x--");
+    static const NodeStruct index = make("[]");
+    if (name[0] == 'u') return negate;
+    if (name[0] == '[') return index;
+    return name[1] == '+' ? increment : decrement;
+}
+
+/**
+ * @brief Instrucción equivalente a un operador postfijo de una o dos entradas.
+ * @return false para `&&`, `||` y `:`, que se compilan con saltos, y para los tokens no válidos.
+ */
+inline bool OperationsAnalyzer::toOpCode(const NodeStruct &token, OpCode &op) {
+    const std::string &name = token.name;
+    if (name.empty() || name.size() > 3) return false;
+    const char second = name.size() >= 2 ? name[1] : '\0';
+    if (name.size() == 3) {
+        op = name[2] == '+' ? OpCode::POST_INC : OpCode::POST_DEC;
+        return name[0] == 'x' && second == name[2] && (second == '+' || second == '-');
+    }
+    switch (name[0]) {
+        case '+': op = second == '+' ? OpCode::PRE_INC : OpCode::ADD; return second == '\0' || second == '+';
+        case '-': op = second == '-' ? OpCode::PRE_DEC : OpCode::SUB; return second == '\0' || second == '-';
+        case '*': op = second == '*' ? OpCode::POW : OpCode::MUL; return second == '\0' || second == '*';
+        case '/': op = OpCode::DIV; return second == '\0';
+        case '%': op = OpCode::MOD; return second == '\0';
+        case '^': op = OpCode::POW; return second == '\0';
+        case 'u': op = OpCode::NEG; return second == '-';
+        case '!': op = second == '=' ? OpCode::NE : OpCode::NOT; return second == '\0' || second == '=';
+        case '=': op = OpCode::EQ; return second == '=';
+        case '<': op = second == '=' ? OpCode::LE : OpCode::LT; return second == '\0' || second == '=';
+        case '>': op = second == '=' ? OpCode::GE : OpCode::GT; return second == '\0' || second == '=';
+        case '[': op = OpCode::INDEX; return second == ']';
+        default: return false;
+    }
+}
+
+/**
+ * @brief Número de operandos que consume una instrucción de operador.
+ */
+inline int OperationsAnalyzer::operandCount(const OpCode op) {
+    switch (op) {
+        case OpCode::NEG: case OpCode::NOT: case OpCode::TO_BOOL:
+        case OpCode::PRE_INC: case OpCode::PRE_DEC: case OpCode::POST_INC: case OpCode::POST_DEC:
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+/**
+ * @brief Busca la función de una llamada y comprueba su número de argumentos.
+ * @throw std::out_of_range Si la función no existe o la aridad no coincide.
+ * @return Índice en BuiltinFunctions.
+ */
+inline int OperationsAnalyzer::resolveCall(const NodeStruct &token) {
+    const int index = BuiltinFunctions::find(token.name);
+    if (index < 0) throw std::out_of_range("Unknown function: " + token.name);
+    if (BuiltinFunctions::get(index).arity != token.value.integer) {
+        throw std::out_of_range("Wrong number of arguments for " + token.name);
+    }
+    return index;
+}
+
+/**
+ * @brief Aplica un operador binario (y ∘ x, con x en la cima). Las comparaciones devuelven 1.0 o 0.0.
+ */
+inline double OperationsAnalyzer::apply(const OpCode op, const double left, const double right) {
+    switch (op) {
+        case OpCode::ADD: return left + right;
+        case OpCode::SUB: return left - right;
+        case OpCode::MUL: return left * right;
+        case OpCode::DIV: return left / right;
+        case OpCode::MOD: return std::fmod(left, right);
+        case OpCode::POW: return std::pow(left, right);
+        case OpCode::EQ: return left == right ? 1.0 : 0.0;
+        case OpCode::NE: return left != right ? 1.0 : 0.0;
+        case OpCode::LT: return left < right ? 1.0 : 0.0;
+        case OpCode::GT: return left > right ? 1.0 : 0.0;
+        case OpCode::LE: return left <= right ? 1.0 : 0.0;
+        case OpCode::GE: return left >= right ? 1.0 : 0.0;
+        default: return 0.0;
+    }
 }
 
-inline ArrayList<NodeStruct> OperationsAnalyzer::toPostfix() {
-    Stack<NodeStruct> stack;
+/**
+ * @brief Convierte una secuencia de tokens a notación postfija (shunting-yard).
+ * * La pila de operadores guarda punteros a los tokens de entrada en una SmallStack,
+ * por lo que no copia estructuras ni reserva memoria para profundidades habituales.
+ * * Un operador que llega cuando se espera un operando es un prefijo. Un identificador seguido
+ * de `(` abre una llamada: cada delimitador abierto lleva en @c arguments las comas vistas
+ * (-1 si no es una llamada) y al cerrarse se emite el identificador con su número de
+ * argumentos. `c ? a : b` se emite como `c a b :`.
+ * @param tokens Secuencia de tokens en notación infija; no se modifica.
+ * @throw std::out_of_range Si los delimitadores no están balanceados, falta un operando o aparece
+ * un token UNKNOWN.
+ * @return Lista de tokens en orden postfijo.
+ */
+inline ArrayList<NodeStruct> OperationsAnalyzer::toPostfix(const ArrayList<NodeStruct> &tokens) {
+    INSTRUMENT_SCOPE("toPostfix");
+    SmallStack<const NodeStruct*> stack;
+    SmallStack<int> arguments;
     ArrayList<NodeStruct> postfix;
+    bool expectOperand = true;
+    bool justOpened = false;
 
-    if (inputTokens.isEmpty()) return postfix;
+    const auto popUntilOpen = [&]() {
+        while (!stack.isEmpty() && (*stack.peek())->type == TokenType::OPERATOR) {
+            postfix.addLast(**stack.peek());
+            stack.pop();
+        }
+    };
 
-    inputTokens.currentReset();
-    do {
-        NodeStruct token = inputTokens.get()->getData();
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const NodeStruct &token = node->getDataRef();
+        const bool opened = justOpened;
+        justOpened = false;
+
+        if (token.type == TokenType::UNKNOWN) {
+            throw std::out_of_range("Unknown token '" + token.name + "' at offset " + std::to_string(token.offset));
+        }
 
         if (token.type == TokenType::VALUE) {
+            if (!expectOperand) throw std::out_of_range("Invalid postfix expression");
+            postfix.addLast(token);
+            expectOperand = false;
+            continue;
+        }
+
+        if (token.type == TokenType::IDENTIFIER) {
+            if (!expectOperand) throw std::out_of_range("Invalid postfix expression");
+            const Node<NodeStruct>* next = node->getNextNode();
+            if (next != nullptr && next->getDataRef().type == TokenType::OPEN_DELIMITER && next->getDataRef().name == "(") {
+                stack.push(&token);
+                continue;
+            }
             postfix.addLast(token);
+            expectOperand = false;
             continue;
         }
 
         if (token.type == TokenType::OPEN_DELIMITER) {
-            stack.push(token);
+            if ((token.name == "[") == expectOperand) throw std::out_of_range("Invalid postfix expression");
+            const bool call = !stack.isEmpty() && (*stack.peek())->type == TokenType::IDENTIFIER;
+            arguments.push(call ? 0 : -1);
+            stack.push(&token);
+            expectOperand = true;
+            justOpened = true;
             continue;
         }
 
         if (token.type == TokenType::CLOSE_DELIMITER) {
-            while (!stack.isEmpty() && stack.top().type != TokenType::OPEN_DELIMITER) {
-                postfix.addLast(stack.pop());
-            }
-            if (!stack.isEmpty()) {
-                stack.pop();
+            popUntilOpen();
+            const NodeStruct* open = nullptr;
+            int commas = -1;
+            if (!stack.tryPop(open) || !closes(*open, token)) throw std::out_of_range("Unbalanced parentheses");
+            arguments.tryPop(commas);
+
+            if (commas >= 0) {
+                const NodeStruct* function = nullptr;
+                stack.tryPop(function);
+                if (expectOperand && !opened) throw std::out_of_range("Invalid postfix expression");
+                NodeStruct call = *function;
+                call.value.kind = NumberKind::INTEGER;
+                call.value.integer = opened ? 0 : commas + 1;
+                postfix.addLast(std::move(call));
+            } else {
+                if (expectOperand) throw std::out_of_range("Invalid postfix expression");
+                if (open->name == "[") postfix.addLast(syntheticOperator("[]"));
             }
+            expectOperand = false;
             continue;
         }
 
-        if (token.type == TokenType::OPERATOR) {
-            const int value = getPrecedence(token);
-            while (!stack.isEmpty() && stack.top().type == TokenType::OPERATOR &&
-                   value <= getPrecedence(stack.top())) {
-                postfix.addLast(stack.pop());
-            }
-            stack.push(token);
+        if (token.type == TokenType::DELIMITER && token.name == ",") {
+            if (arguments.isEmpty() || *arguments.peek() < 0) continue;
+            if (expectOperand) throw std::out_of_range("Invalid postfix expression");
+            popUntilOpen();
+            ++*arguments.peek();
+            expectOperand = true;
+            continue;
+        }
+
+        if (token.type != TokenType::OPERATOR || token.name.empty()) continue;
+        const char symbol = token.name[0];
+        const bool single = token.name.size() == 1;
+        const bool step = token.name.size() == 2 && (symbol == '+' || symbol == '-') && token.name[1] == symbol;
+
+        if (expectOperand) {
+            if (single && symbol == '+') continue;
+            if (single && symbol == '-') stack.push(&syntheticOperator("u-"));
+            else if ((single && symbol == '!') || step) stack.push(&token);
+            else throw std::out_of_range("Invalid postfix expression");
+            continue;
+        }
+
+        if (step) {
+            postfix.addLast(syntheticOperator(symbol == '+' ? "x++" : "x--"));
+            continue;
         }
-    } while (inputTokens.currentNext());
+        if (single && symbol == '!') throw std::out_of_range("Invalid postfix expression");
 
-    while (!stack.isEmpty()) {
-        if (stack.top().type == TokenType::OPEN_DELIMITER) {
+        if (single && symbol == ':') {
+            while (!stack.isEmpty() && (*stack.peek())->type == TokenType::OPERATOR && (*stack.peek())->name != "?") {
+                postfix.addLast(**stack.peek());
+                stack.pop();
+            }
+            if (stack.isEmpty() || (*stack.peek())->name != "?") throw std::out_of_range("Invalid postfix expression");
             stack.pop();
+            stack.push(&token);
+            expectOperand = true;
             continue;
         }
-        postfix.addLast(stack.pop());
+
+        const int precedence = getPrecedence(token);
+        const bool right = isRightAssociative(precedence);
+        while (!stack.isEmpty() && (*stack.peek())->type == TokenType::OPERATOR) {
+            const int top = getPrecedence(**stack.peek());
+            if (top < precedence || (top == precedence && right)) break;
+            postfix.addLast(**stack.peek());
+            stack.pop();
+        }
+        stack.push(&token);
+        expectOperand = true;
+    }
+
+    const NodeStruct* top = nullptr;
+    while (stack.tryPop(top)) {
+        if (top->type != TokenType::OPERATOR) throw std::out_of_range("Unbalanced parentheses");
+        if (top->name == "?") throw std::out_of_range("Invalid postfix expression");
+        postfix.addLast(*top);
     }
 
     return postfix;
 }
 
-inline double OperationsAnalyzer::evaluatePostfix(ArrayList<NodeStruct> &postfixTokens) {
-    Stack<double> values;
+/**
+ * @brief Evalúa una expresión en notación postfija.
+ * * La compila y ejecuta, de modo que `&&`, `||` y `?:` evalúan solo el operando necesario
+ * igual que con la caché. El programa se reutiliza por hilo para no reservar memoria en cada llamada.
+ * @param postfixTokens Tokens en orden postfijo.
+ * @param symbols Variables disponibles; puede ser nullptr.
+ * @throw std::out_of_range Si faltan operandos, sobran valores al finalizar, una variable no
+ * existe, un índice se sale del arreglo o una llamada no coincide con BuiltinFunctions.
+ * @return Resultado numérico; 0.0 para una expresión vacía.
+ */
+inline double OperationsAnalyzer::evaluatePostfix(const ArrayList<NodeStruct> &postfixTokens, SymbolTable* symbols) {
+    INSTRUMENT_SCOPE("evaluatePostfix");
+    static thread_local CompiledExpression program;
+    if (!compile(postfixTokens, program)) throw std::out_of_range("Invalid postfix expression");
+    return execute(program, symbols);
+}
+
+/**
+ * @brief Asocia una caché de expresiones compiladas al analizador.
+ * @param expressionCache Caché a usar (p. ej. ExpressionCache::shared()); nullptr la desactiva.
+ */
+inline void OperationsAnalyzer::setCache(ExpressionCache* expressionCache) {
+    this->cache = expressionCache;
+}
+
+/**
+ * @brief Asocia la tabla de variables con la que se resuelven los identificadores.
+ * @param symbolTable Tabla a usar; nullptr hace que cualquier variable sea un error.
+ */
+inline void OperationsAnalyzer::setSymbols(SymbolTable* symbolTable) {
+    this->symbols = symbolTable;
+}
 
-    if (postfixTokens.isEmpty()) return 0.0;
+/**
+ * @brief Indica si una expresión no depende de variables.
+ * Solo los resultados de expresiones constantes pueden memorizarse directamente; las
+ * llamadas a BuiltinFunctions son puras y no cuentan como variables.
+ */
+inline bool OperationsAnalyzer::isConstantExpression(const ArrayList<NodeStruct> &tokens) {
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        if (node->getDataRef().type != TokenType::IDENTIFIER) continue;
+        const Node<NodeStruct>* next = node->getNextNode();
+        if (next == nullptr || next->getDataRef().name != "(") return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Traduce una secuencia postfija de tokens a un programa de instrucciones.
+ * * Verifica estáticamente la profundidad de la pila de valores, por lo que un programa
+ * compilado nunca falla por falta de operandos al ejecutarse.
+ * * Para cada operando pendiente se recuerda dónde empieza su código. Al llegar `&&` o `||` se
+ * inserta entre sus dos operandos un salto que omite el derecho cuando el izquierdo ya decide
+ * el resultado; `c a b :` se reordena como `c JUMP_IF_FALSE a JUMP b`. Los saltos son
+ * relativos, así que insertar instrucciones delante de un operando no invalida los suyos, y
+ * el orden de izquierda a derecha de `++` y `--` se conserva.
+ * @param postfixTokens Tokens en orden postfijo.
+ * @param[out] out Programa resultante.
+ * @throw std::out_of_range Si la expresión postfija no es válida o una llamada no coincide con BuiltinFunctions.
+ * @return false si la expresión usa un operador sin instrucción equivalente.
+ */
+inline bool OperationsAnalyzer::compile(const ArrayList<NodeStruct> &postfixTokens, CompiledExpression &out) {
+    out.code.clear();
+    out.names.clear();
+    out.code.reserve(static_cast<size_t>(postfixTokens.getSize()) + 4);
+    SmallStack<size_t> starts;
+    size_t operands[3] = {};
+
+    const auto take = [&](const size_t count) {
+        if (starts.getSize() < count) throw std::out_of_range("Invalid postfix expression");
+        for (size_t i = count; i > 0; i--) starts.tryPop(operands[i - 1]);
+    };
+    const auto insertJump = [&](const size_t at, const OpCode op, const size_t skip) {
+        out.code.insert(out.code.begin() + static_cast<std::ptrdiff_t>(at), Instruction{op, static_cast<double>(skip)});
+    };
 
-    postfixTokens.currentReset();
-    do {
-        NodeStruct token = postfixTokens.get()->getData();
+    for (Node<NodeStruct>* node = postfixTokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const NodeStruct &token = node->getDataRef();
+        const size_t here = out.code.size();
 
         if (token.type == TokenType::VALUE) {
-            values.push(std::stod(token.name));
+            if (token.value.kind == NumberKind::NONE) throw std::out_of_range("Invalid operand '" + token.name + "'");
+            out.code.push_back(Instruction{OpCode::PUSH, token.value.asDouble()});
+            starts.push(here);
             continue;
         }
 
-        if (token.type == TokenType::OPERATOR) {
-            if (values.getSize() < 2) {
-                throw std::out_of_range("Invalid postfix expression");
-            }
-            const double x = values.pop();
-            const double y = values.pop();
-            double result;
+        if (isCall(token)) {
+            const int function = resolveCall(token);
+            const size_t arity = static_cast<size_t>(BuiltinFunctions::get(function).arity);
+            take(arity);
+            out.code.push_back(Instruction{OpCode::CALL, static_cast<double>(function)});
+            starts.push(arity > 0 ? operands[0] : here);
+            continue;
+        }
+
+        if (token.type == TokenType::IDENTIFIER) {
+            size_t slot = 0;
+            while (slot < out.names.size() && out.names[slot] != token.name) slot++;
+            if (slot == out.names.size()) out.names.push_back(token.name);
+            out.code.push_back(Instruction{OpCode::LOAD, static_cast<double>(slot)});
+            starts.push(here);
+            continue;
+        }
+
+        if (token.type != TokenType::OPERATOR) continue;
+
+        OpCode op;
+        if (toOpCode(token, op)) {
+            take(static_cast<size_t>(operandCount(op)));
+            out.code.push_back(Instruction{op, 0.0});
+        } else if (token.name == "&&" || token.name == "||") {
+            take(2);
+            insertJump(operands[1], token.name == "&&" ? OpCode::JUMP_IF_FALSE_OR_POP : OpCode::JUMP_IF_TRUE_OR_POP,
+                       here - operands[1]);
+            out.code.push_back(Instruction{OpCode::TO_BOOL, 0.0});
+        } else if (token.name == ":") {
+            take(3);
+            insertJump(operands[2], OpCode::JUMP, here - operands[2]);
+            insertJump(operands[1], OpCode::JUMP_IF_FALSE, operands[2] - operands[1] + 1);
+        } else {
+            return false;
+        }
+        starts.push(operands[0]);
+    }
 
-            if (token.name == "+") result = y + x;
-            else if (token.name == "-") result = y - x;
-            else if (token.name == "*") result = y * x;
-            else if (token.name == "/") result = y / x;
-            else continue;
+    if (!out.code.empty() && starts.getSize() != 1) throw std::out_of_range("Invalid postfix expression");
+    return true;
+}
+
+/**
+ * @brief Ejecuta un programa compilado.
+ * * Los operandos leídos de una variable recuerdan su posición para que `++`, `--` y `[]`
+ * puedan modificarla o indexarla. Los operadores unarios y binarios escriben su resultado
+ * sobre la cima de la pila en lugar de desapilar y apilar.
+ * @param program Programa validado por compile().
+ * @param symbols Variables para LOAD; puede ser nullptr si el programa no las usa.
+ * @throw std::out_of_range Si una variable no existe, un índice se sale del arreglo o `++`/`--`
+ * se aplica a algo que no es una variable.
+ * @return Resultado de la expresión; 0.0 para un programa vacío.
+ */
+inline double OperationsAnalyzer::execute(const CompiledExpression &program, SymbolTable* symbols) {
+    INSTRUMENT_SCOPE("execute");
+    if (program.code.empty()) return 0.0;
+    SmallStack<Operand> values;
+    Operand x{};
+    const Instruction* code = program.code.data();
+    const size_t size = program.code.size();
 
-            values.push(result);
+    for (size_t pc = 0; pc < size; pc++) {
+        const Instruction &instruction = code[pc];
+        switch (instruction.op) {
+            case OpCode::PUSH:
+                values.push(Operand{instruction.operand, nullptr, 0});
+                break;
+            case OpCode::LOAD: {
+                const std::string &name = program.names[static_cast<size_t>(instruction.operand)];
+                std::vector<double>* storage = symbols != nullptr ? symbols->find(name) : nullptr;
+                if (storage == nullptr) throw std::out_of_range("Undefined variable: " + name);
+                values.push(Operand{storage->empty() ? 0.0 : (*storage)[0], storage, 0});
+                break;
+            }
+            case OpCode::NEG:
+                *values.peek() = Operand{-values.peek()->value, nullptr, 0};
+                break;
+            case OpCode::NOT:
+                *values.peek() = Operand{values.peek()->value == 0.0 ? 1.0 : 0.0, nullptr, 0};
+                break;
+            case OpCode::TO_BOOL:
+                *values.peek() = Operand{values.peek()->value != 0.0 ? 1.0 : 0.0, nullptr, 0};
+                break;
+            case OpCode::PRE_INC: case OpCode::PRE_DEC: case OpCode::POST_INC: case OpCode::POST_DEC: {
+                Operand* top = values.peek();
+                if (top->storage == nullptr || top->index >= top->storage->size()) {
+                    throw std::out_of_range("Increment requires a variable");
+                }
+                double &slot = (*top->storage)[top->index];
+                const double before = slot;
+                slot += instruction.op == OpCode::PRE_INC || instruction.op == OpCode::POST_INC ? 1.0 : -1.0;
+                *top = Operand{instruction.op == OpCode::POST_INC || instruction.op == OpCode::POST_DEC ? before : slot,
+                               nullptr, 0};
+                break;
+            }
+            case OpCode::INDEX: {
+                values.tryPop(x);
+                Operand* base = values.peek();
+                if (base->storage == nullptr || base->index != 0) throw std::out_of_range("Indexing requires an array");
+                if (!(x.value >= 0.0) || x.value >= static_cast<double>(base->storage->size()) ||
+                    x.value != std::floor(x.value)) {
+                    throw std::out_of_range("Index out of range");
+                }
+                base->index = static_cast<size_t>(x.value);
+                base->value = (*base->storage)[base->index];
+                break;
+            }
+            case OpCode::CALL: {
+                const BuiltinFunction &function = BuiltinFunctions::get(static_cast<int>(instruction.operand));
+                double args[BuiltinFunctions::MAX_ARITY] = {};
+                for (int i = function.arity - 1; i >= 0; i--) {
+                    values.tryPop(x);
+                    args[i] = x.value;
+                }
+                values.push(Operand{function.apply(args), nullptr, 0});
+                break;
+            }
+            case OpCode::JUMP:
+                pc += static_cast<size_t>(instruction.operand);
+                break;
+            case OpCode::JUMP_IF_FALSE:
+                values.tryPop(x);
+                if (x.value == 0.0) pc += static_cast<size_t>(instruction.operand);
+                break;
+            case OpCode::JUMP_IF_FALSE_OR_POP:
+                if (values.peek()->value == 0.0) pc += static_cast<size_t>(instruction.operand);
+                else values.pop();
+                break;
+            case OpCode::JUMP_IF_TRUE_OR_POP:
+                if (values.peek()->value != 0.0) pc += static_cast<size_t>(instruction.operand);
+                else values.pop();
+                break;
+            default:
+                values.tryPop(x);
+                *values.peek() = Operand{apply(instruction.op, values.peek()->value, x.value), nullptr, 0};
+                break;
         }
-    } while (postfixTokens.currentNext());
+    }
+    values.tryPop(x);
+    return x.value;
+}
 
-    if (values.getSize() != 1) {
-        throw std::out_of_range("Invalid postfix expression");
+/**
+ * @brief Convierte una expresión a notación postfija y la evalúa sin imprimir resultados.
+ * * Con una caché, la secuencia de tokens se busca primero en ella: un acierto reutiliza el
+ * programa compilado (o directamente el resultado si la expresión es constante) y un fallo
+ * compila la expresión y la registra. No usa estado compartido salvo la caché, que es segura
+ * entre hilos.
+ * @param tokens Secuencia de tokens en notación infija.
+ * @param cache Caché de expresiones compiladas; nullptr para evaluar siempre desde los tokens.
+ * @param symbols Variables disponibles; de las expresiones con variables se memoriza el programa, no el resultado.
+ * @throw std::out_of_range Si la expresión postfija resultante no es válida.
+ * @return Valor numérico de la expresión.
+ */
+inline double OperationsAnalyzer::evaluate(const ArrayList<NodeStruct> &tokens, ExpressionCache* cache,
+                                           SymbolTable* symbols) {
+    if (cache == nullptr) {
+        ArrayList<NodeStruct> postfix = toPostfix(tokens);
+        return evaluatePostfix(postfix, symbols);
     }
 
-    return values.pop();
+    std::shared_ptr<const CompiledExpression> program = cache->find(tokens);
+    if (program == nullptr) {
+        ArrayList<NodeStruct> postfix = toPostfix(tokens);
+        std::shared_ptr<CompiledExpression> compiled = std::make_shared<CompiledExpression>();
+        if (!compile(postfix, *compiled)) throw std::out_of_range("Invalid postfix expression");
+        compiled->constant = isConstantExpression(tokens);
+        if (compiled->constant) compiled->result = execute(*compiled);
+        cache->insert(tokens, compiled);
+        program = compiled;
+    }
+    return program->constant ? program->result : execute(*program, symbols);
+}
+
+/**
+ * @brief Evalúa la expresión de entrada del analizador con su caché y sus variables asociadas.
+ * @throw std::out_of_range Si la expresión postfija resultante no es válida.
+ * @return Valor numérico de la expresión.
+ */
+inline double OperationsAnalyzer::evaluate() const {
+    return evaluate(this->inputTokens, this->cache, this->symbols);
 }
 
-inline void OperationsAnalyzer::resolve() {
+inline void OperationsAnalyzer::resolve() const {
     try {
-        ArrayList<NodeStruct> postfix = toPostfix();
+        ArrayList<NodeStruct> postfix = toPostfix(this->inputTokens);
         std::cout << "Postfix Tokens: ";
         if (!postfix.isEmpty()) {
             postfix.currentReset();
@@ -144,7 +665,7 @@ inline void OperationsAnalyzer::resolve() {
         }
         std::cout << std::endl;
 
-        const double result = evaluatePostfix(postfix);
+        const double result = evaluatePostfix(postfix, this->symbols);
         std::cout << std::endl;
         std::cout << "Result: " << result << std::endl;
     } catch (const std::exception &e) {
@@ -0,0 +1,364 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "spsc_ring.h"
+#include "../source_map/source_map.h"
+#include "../operations_analyzer/operations_analyzer.h"
+
+/**
+ * @brief Métricas de una ejecución de la cadena lectura → léxico → evaluación.
+ */
+struct PipelineStats {
+    long long bytes = 0;
+    long long lines = 0;
+    long long tokens = 0;
+    long long batches = 0;
+    double firstBatchUs = 0;
+    double totalUs = 0;
+};
+
+/**
+ * @brief Cadena de compilación por etapas solapadas.
+ * * Tres hilos conectados por colas SpscRing acotadas:
+ * 1. Lectura: lee bloques de @c chunkBytes del flujo y los corta en lotes de líneas.
+ * 2. Léxico: tokeniza cada lote con LexicalAnalyzer::tokenizeLine().
+ * 3. Consumo: el hilo que llama a run() recibe cada lote de tokens en cuanto está listo.
+ * * Mientras se tokeniza un lote ya se está leyendo el siguiente y evaluando el anterior, y
+ * nunca hay más de @c ringCapacity lotes en vuelo por cola, de modo que la memoria retenida
+ * no depende del tamaño del archivo.
+ */
+class CompilationPipeline {
+
+    private:
+        struct LineBatch {
+            size_t firstOffset = 0;
+            std::vector<std::string> lines;
+        };
+        LexicalAnalyzer lexer;
+        size_t chunkBytes;
+        size_t batchLines;
+        size_t ringCapacity;
+        static double elapsedUs(std::chrono::steady_clock::time_point start);
+        void readStage(std::istream &code, SpscRing<LineBatch> &out, const std::atomic<bool> &stop,
+                       PipelineStats &stats) const;
+        void lexStage(SpscRing<LineBatch> &in, SpscRing<ArrayList<NodeStruct>> &out,
+                      const std::atomic<bool> &stop) const;
+
+    public:
+        explicit CompilationPipeline(std::shared_ptr<const TokenProvider> provider, size_t chunkBytes = 64 * 1024,
+                                     size_t batchLines = 256, size_t ringCapacity = 8);
+        template <typename Consumer>
+        PipelineStats run(std::istream &code, Consumer &&consumer) const;
+        template <typename Consumer>
+        PipelineStats runSequential(std::ifstream &code, Consumer &&consumer) const;
+        ArrayList<NodeStruct> collect(std::istream &code, PipelineStats* stats = nullptr) const;
+};
+
+/**
+ * @brief Etapa final: separa el flujo de tokens en sentencias y evalúa sus expresiones.
+ * * Una sentencia termina en `;` y puede quedar repartida entre dos lotes. Solo se evalúa la
+ * parte derecha de la asignación (o la sentencia completa si no la hay) cuando es aritmética:
+ * literales numéricos, + - * / y paréntesis.
+ */
+class StatementEvaluator {
+
+    private:
+        ArrayList<NodeStruct> pending;
+        ExpressionCache* cache;
+        long long statements = 0;
+        long long evaluated = 0;
+        double checksum = 0;
+        static bool isArithmetic(const NodeStruct &token);
+        void flush();
+
+    public:
+        explicit StatementEvaluator(ExpressionCache* cache = nullptr);
+        void operator()(ArrayList<NodeStruct> &batch);
+        void finish();
+        long long getStatements() const;
+        long long getEvaluated() const;
+        double getChecksum() const;
+};
+
+/**
+ * @brief Constructor.
+ * @param provider Configuración de tokens compartida.
+ * @param chunkBytes Tamaño de cada lectura del flujo de entrada.
+ * @param batchLines Líneas por lote entregado al analizador léxico.
+ * @param ringCapacity Lotes máximos en vuelo entre dos etapas.
+ */
+inline CompilationPipeline::CompilationPipeline(std::shared_ptr<const TokenProvider> provider, const size_t chunkBytes,
+                                                const size_t batchLines, const size_t ringCapacity)
+    : lexer(std::move(provider)), chunkBytes(chunkBytes == 0 ? 1 : chunkBytes),
+      batchLines(batchLines == 0 ? 1 : batchLines), ringCapacity(ringCapacity) {}
+
+inline double CompilationPipeline::elapsedUs(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Etapa de lectura: bloques de tamaño fijo cortados en líneas completas.
+ * * Una línea partida entre dos bloques se completa con el bloque siguiente. Las líneas se
+ * cuentan igual que con std::getline; cada lote recuerda el desplazamiento de su primera línea.
+ */
+inline void CompilationPipeline::readStage(std::istream &code, SpscRing<LineBatch> &out,
+                                           const std::atomic<bool> &stop, PipelineStats &stats) const {
+    INSTRUMENT_SCOPE("pipeline.read");
+    std::vector<char> chunk(this->chunkBytes);
+    std::string partial;
+    LineBatch batch;
+    int numLines = 0;
+    size_t offset = 0;
+
+    while (!stop.load(std::memory_order_relaxed) && code) {
+        code.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const size_t read = static_cast<size_t>(code.gcount());
+        if (read == 0) break;
+        stats.bytes += static_cast<long long>(read);
+        INSTRUMENT_COUNT(Counter::BYTES_READ, static_cast<long long>(read));
+
+        size_t start = 0;
+        for (size_t i = 0; i < read; i++) {
+            if (chunk[i] != '\n') continue;
+            partial.append(chunk.data() + start, i - start);
+            offset += partial.size() + 1;
+            batch.lines.push_back(std::move(partial));
+            partial.clear();
+            ++numLines;
+            start = i + 1;
+            if (batch.lines.size() >= this->batchLines) {
+                out.push(std::move(batch));
+                batch = LineBatch();
+                batch.firstOffset = offset;
+            }
+        }
+        partial.append(chunk.data() + start, read - start);
+    }
+    if (!partial.empty()) {
+        batch.lines.push_back(std::move(partial));
+        ++numLines;
+    }
+    if (!batch.lines.empty()) out.push(std::move(batch));
+    stats.lines = numLines;
+    out.close();
+}
+
+/**
+ * @brief Etapa léxica: convierte cada lote de líneas en un lote de tokens.
+ */
+inline void CompilationPipeline::lexStage(SpscRing<LineBatch> &in, SpscRing<ArrayList<NodeStruct>> &out,
+                                          const std::atomic<bool> &stop) const {
+    INSTRUMENT_SCOPE("pipeline.lex");
+    LineBatch batch;
+    LexerState state;
+    while (in.pop(batch)) {
+        if (stop.load(std::memory_order_relaxed)) continue;
+        ArrayList<NodeStruct> tokens;
+        size_t offset = batch.firstOffset;
+        for (const std::string &line : batch.lines) {
+            this->lexer.tokenizeLine(line, offset, tokens, state);
+            offset += line.size() + 1;
+        }
+        out.push(std::move(tokens));
+    }
+    if (state.inString && !stop.load(std::memory_order_relaxed)) {
+        ArrayList<NodeStruct> tokens;
+        LexicalAnalyzer::finishState(tokens, state);
+        out.push(std::move(tokens));
+    }
+    out.close();
+}
+
+/**
+ * @brief Ejecuta la cadena con las etapas solapadas.
+ * * Si el consumidor lanza una excepción, las etapas anteriores se detienen, se vacían las
+ * colas y la excepción se propaga tras unir los hilos.
+ * @param code Flujo con el código fuente.
+ * @param consumer Invocable con firma void(ArrayList<NodeStruct>&); se llama en el hilo actual, en orden,
+ * y puede adoptar los nodos del lote con ArrayList::splice().
+ * @return Métricas de la ejecución; @c firstBatchUs mide cuándo recibió el consumidor su primer lote.
+ */
+template <typename Consumer>
+PipelineStats CompilationPipeline::run(std::istream &code, Consumer &&consumer) const {
+    INSTRUMENT_SCOPE("pipeline.run");
+    const auto start = std::chrono::steady_clock::now();
+    PipelineStats stats;
+    SpscRing<LineBatch> lines(this->ringCapacity);
+    SpscRing<ArrayList<NodeStruct>> tokens(this->ringCapacity);
+    std::atomic<bool> stop(false);
+    std::exception_ptr readError;
+    std::exception_ptr lexError;
+
+    std::thread reader([&]() {
+        try {
+            this->readStage(code, lines, stop, stats);
+        } catch (...) {
+            readError = std::current_exception();
+            stop.store(true);
+            lines.close();
+        }
+    });
+    std::thread lexer([&]() {
+        try {
+            this->lexStage(lines, tokens, stop);
+        } catch (...) {
+            lexError = std::current_exception();
+            stop.store(true);
+            LineBatch discarded;
+            while (lines.pop(discarded)) {}
+            tokens.close();
+        }
+    });
+
+    std::exception_ptr consumerError;
+    ArrayList<NodeStruct> batch;
+    while (tokens.pop(batch)) {
+        if (consumerError) continue;
+        if (stats.batches++ == 0) stats.firstBatchUs = elapsedUs(start);
+        stats.tokens += batch.getSize();
+        try {
+            consumer(batch);
+        } catch (...) {
+            consumerError = std::current_exception();
+            stop.store(true);
+        }
+    }
+    reader.join();
+    lexer.join();
+
+    if (readError) std::rethrow_exception(readError);
+    if (lexError) std::rethrow_exception(lexError);
+    if (consumerError) std::rethrow_exception(consumerError);
+    stats.totalUs = elapsedUs(start);
+    return stats;
+}
+
+/**
+ * @brief Referencia secuencial: tokeniza el archivo completo y después entrega un único lote.
+ * @param code Flujo del archivo con el código fuente.
+ * @param consumer Mismo consumidor que en run().
+ * @return Métricas de la ejecución; @c firstBatchUs coincide con el final del análisis léxico.
+ */
+template <typename Consumer>
+PipelineStats CompilationPipeline::runSequential(std::ifstream &code, Consumer &&consumer) const {
+    const auto start = std::chrono::steady_clock::now();
+    PipelineStats stats;
+    SourceMap sourceMap;
+    ArrayList<NodeStruct> tokens = this->lexer.tokenize(code, nullptr, &sourceMap);
+    stats.firstBatchUs = elapsedUs(start);
+    stats.batches = 1;
+    stats.tokens = tokens.getSize();
+    stats.lines = static_cast<int>(sourceMap.getLineCount());
+    consumer(tokens);
+    stats.totalUs = elapsedUs(start);
+    return stats;
+}
+
+/**
+ * @brief Ejecuta la cadena solapada y reúne todos los lotes en una sola lista.
+ * * Cada lote se encadena con ArrayList::splice() en O(1), sin copiar tokens.
+ * @param code Flujo con el código fuente.
+ * @param[out] stats Métricas de la ejecución; opcional.
+ * @return Tokens del código completo, en orden de aparición.
+ */
+inline ArrayList<NodeStruct> CompilationPipeline::collect(std::istream &code, PipelineStats* stats) const {
+    ArrayList<NodeStruct> tokens;
+    const PipelineStats result = this->run(code, [&tokens](ArrayList<NodeStruct> &batch) { tokens.splice(batch); });
+    if (stats != nullptr) *stats = result;
+    return tokens;
+}
+
+/**
+ * @brief Constructor.
+ * @param cache Caché de expresiones compiladas; nullptr para evaluar siempre desde los tokens.
+ */
+inline StatementEvaluator::StatementEvaluator(ExpressionCache* cache) : cache(cache) {}
+
+inline bool StatementEvaluator::isArithmetic(const NodeStruct &token) {
+    switch (token.type) {
+        case TokenType::VALUE: return token.value.kind != NumberKind::NONE;
+        case TokenType::OPERATOR:
+            return token.name == "+" || token.name == "-" || token.name == "*" || token.name == "/";
+        case TokenType::OPEN_DELIMITER: return token.name == "(";
+        case TokenType::CLOSE_DELIMITER: return token.name == ")";
+        default: return false;
+    }
+}
+
+/**
+ * @brief Cierra la sentencia pendiente y evalúa su expresión si es aritmética.
+ * @throw std::out_of_range Si la expresión aritmética está mal formada.
+ */
+inline void StatementEvaluator::flush() {
+    if (this->pending.isEmpty()) return;
+    ++this->statements;
+
+    Node<NodeStruct>* first = this->pending.getFirst();
+    for (Node<NodeStruct>* node = first; node != nullptr; node = node->getNextNode()) {
+        if (node->getDataRef().type == TokenType::ASSIGNMENT) first = node->getNextNode();
+    }
+    bool arithmetic = first != nullptr;
+    for (Node<NodeStruct>* node = first; node != nullptr && arithmetic; node = node->getNextNode()) {
+        arithmetic = isArithmetic(node->getDataRef());
+    }
+    if (arithmetic) {
+        ArrayList<NodeStruct> expression;
+        expression.splice(this->pending, first, this->pending.getLast());
+        this->checksum += OperationsAnalyzer::evaluate(expression, this->cache);
+        ++this->evaluated;
+    }
+    this->pending.clear();
+}
+
+/**
+ * @brief Consume un lote de tokens; las sentencias incompletas se completan con el lote siguiente.
+ * * Los tokens de cada sentencia pasan a la sentencia pendiente con splice(), sin copiarse.
+ * @param batch Tokens en orden de aparición; queda vacío.
+ */
+inline void StatementEvaluator::operator()(ArrayList<NodeStruct> &batch) {
+    Node<NodeStruct>* node = batch.getFirst();
+    while (node != nullptr) {
+        Node<NodeStruct>* next = node->getNextNode();
+        const NodeStruct &token = node->getDataRef();
+        if (token.type == TokenType::DELIMITER && token.name == ";") {
+            if (node != batch.getFirst()) this->pending.splice(batch, batch.getFirst(), node->getPreviousNode());
+            delete batch.removeNode(node);
+            this->flush();
+        }
+        node = next;
+    }
+    this->pending.splice(batch);
+}
+
+/**
+ * @brief Evalúa la última sentencia si el código no terminaba en `;`.
+ */
+inline void StatementEvaluator::finish() {
+    this->flush();
+}
+
+inline long long StatementEvaluator::getStatements() const {
+    return this->statements;
+}
+
+inline long long StatementEvaluator::getEvaluated() const {
+    return this->evaluated;
+}
+
+/**
+ * @brief Suma de los resultados evaluados; permite comparar dos ejecuciones sobre el mismo código.
+ */
+inline double StatementEvaluator::getChecksum() const {
+    return this->checksum;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Cola circular acotada sin bloqueos para un único productor y un único consumidor.
+ * * El productor solo escribe @c tail y el consumidor solo escribe @c head; cada índice se
+ * publica con semántica release/acquire, por lo que no hace falta ningún mutex. Cuando la
+ * cola está llena (o vacía) el hilo cede la CPU con yield en lugar de girar en vacío.
+ * @tparam T Tipo de los elementos; se transfieren por movimiento.
+ */
+template <typename T>
+class SpscRing {
+
+    private:
+        std::vector<T> slots;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+        alignas(64) std::atomic<bool> closed{false};
+
+    public:
+        explicit SpscRing(size_t capacity);
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+        bool tryPush(T &item);
+        void push(T item);
+        bool tryPop(T &out);
+        bool pop(T &out);
+        void close();
+};
+
+/**
+ * @brief Constructor.
+ * @param capacity Capacidad mínima; se redondea a la siguiente potencia de dos.
+ */
+template <typename T>
+SpscRing<T>::SpscRing(const size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    this->slots.resize(size);
+    this->mask = size - 1;
+}
+
+/**
+ * @brief Intenta encolar sin esperar (solo productor).
+ * @param item Elemento a mover a la cola; se conserva si la cola está llena.
+ * @return false si la cola está llena.
+ */
+template <typename T>
+bool SpscRing<T>::tryPush(T &item) {
+    const size_t currentTail = this->tail.load(std::memory_order_relaxed);
+    if (currentTail - this->head.load(std::memory_order_acquire) > this->mask) return false;
+    this->slots[currentTail & this->mask] = std::move(item);
+    this->tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Encola esperando a que haya hueco (solo productor).
+ */
+template <typename T>
+void SpscRing<T>::push(T item) {
+    while (!this->tryPush(item)) std::this_thread::yield();
+}
+
+/**
+ * @brief Intenta desencolar sin esperar (solo consumidor).
+ * @param[out] out Recibe el elemento.
+ * @return false si la cola está vacía.
+ */
+template <typename T>
+bool SpscRing<T>::tryPop(T &out) {
+    const size_t currentHead = this->head.load(std::memory_order_relaxed);
+    if (currentHead == this->tail.load(std::memory_order_acquire)) return false;
+    out = std::move(this->slots[currentHead & this->mask]);
+    this->head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Desencola esperando a que haya datos (solo consumidor).
+ * @param[out] out Recibe el elemento.
+ * @return false si la cola fue cerrada y ya no quedan elementos.
+ */
+template <typename T>
+bool SpscRing<T>::pop(T &out) {
+    while (!this->tryPop(out)) {
+        if (this->closed.load(std::memory_order_acquire)) return this->tryPop(out);
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+/**
+ * @brief Marca el fin de la producción (solo productor).
+ */
+template <typename T>
+void SpscRing<T>::close() {
+    this->closed.store(true, std::memory_order_release);
+}
+
+#endif
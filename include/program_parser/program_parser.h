@@ -0,0 +1,597 @@
+#ifndef PROGRAM_PARSER_H
+#define PROGRAM_PARSER_H
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../operations_analyzer/operations_analyzer.h"
+#include "../../interface/program_struct.h"
+
+/**
+ * @brief Analizador sintáctico de programas completos por descenso recursivo.
+ * * Reconoce declaraciones `int|float|double|string x [= e];` y de arreglos `int v[n] = {...};`,
+ * asignaciones a variables y elementos, expresiones, bloques, `if`/`else`, `while`, `for`,
+ * `break`, `continue` y `return`. El programa puede ser una lista de sentencias o una función
+ * `main()` sin parámetros. Las expresiones se convierten con OperationsAnalyzer::toPostfix() y
+ * el árbol se arma con una pila, igual que OperationsAnalyzer::compile().
+ * * Cada declaración recibe una ranura nueva en ProgramStruct::variables, de modo que los
+ * nombres quedan resueltos y tipados durante el análisis. Las operaciones entre INT dan INT;
+ * si interviene un DOUBLE, DOUBLE. `**` y las funciones devuelven DOUBLE; las comparaciones y
+ * los operadores lógicos, INT. Las cadenas solo admiten `+`, `==` y `!=` entre cadenas.
+ */
+class ProgramParser {
+
+    private:
+        std::vector<const NodeStruct*> tokens;
+        size_t position = 0;
+        ProgramStruct program;
+        std::vector<std::unordered_map<std::string, int32_t>> scopes;
+        size_t globalDepth = 1;
+        int loopDepth = 0;
+
+        explicit ProgramParser(const ArrayList<NodeStruct> &tokens);
+        explicit ProgramParser(std::vector<const NodeStruct*> tokens);
+        const NodeStruct* peek(size_t ahead = 0) const;
+        bool at(TokenType type, const char* name, size_t ahead = 0) const;
+        void expect(TokenType type, const char* name);
+        uint32_t offset() const;
+        void fail(const std::string &message) const;
+        static bool isTypeKeyword(const NodeStruct* token);
+        static ValueType toValueType(const NodeStruct &token);
+        static bool assignable(ValueType target, ValueType value);
+        int32_t declare(const NodeStruct &name, ValueType type, bool array);
+        int32_t lookup(const NodeStruct &name) const;
+        int32_t addExpression(const ExpressionNode &node);
+        int32_t addStatement(const StatementNode &node);
+        size_t findTerminator(size_t from, const char* name, const char* other = nullptr) const;
+        int32_t scalarOperand(int32_t expression) const;
+        int32_t buildExpression(const ArrayList<NodeStruct> &postfix, uint32_t at);
+        int32_t parseExpression(size_t end);
+        int32_t parseCondition();
+        int32_t parseCondition(size_t end);
+        int32_t parseSimple(size_t end);
+        int32_t parseDeclaration();
+        int32_t parseBlock();
+        int32_t parseStatement();
+        int32_t parseBody();
+        void parseProgram();
+
+    public:
+        static ProgramStruct parse(const ArrayList<NodeStruct> &tokens);
+        static ProgramStruct parse(std::vector<const NodeStruct*> tokens);
+};
+
+inline ProgramParser::ProgramParser(const ArrayList<NodeStruct> &tokens) {
+    this->tokens.reserve(static_cast<size_t>(tokens.getSize()));
+    for (Node<NodeStruct>* node = tokens.getFirst(); node != nullptr; node = node->getNextNode()) {
+        this->tokens.push_back(&node->getDataRef());
+    }
+}
+
+inline ProgramParser::ProgramParser(std::vector<const NodeStruct*> tokens) : tokens(std::move(tokens)) {}
+
+/**
+ * @brief Analiza un programa completo.
+ * @param tokens Tokens producidos por LexicalAnalyzer; deben seguir vivos durante la llamada.
+ * @throw std::out_of_range Si el programa no es válido; el mensaje incluye el desplazamiento del error.
+ * @return Árbol sintáctico con los nombres resueltos a ranuras.
+ */
+inline ProgramStruct ProgramParser::parse(const ArrayList<NodeStruct> &tokens) {
+    INSTRUMENT_SCOPE("parseProgram");
+    ProgramParser parser(tokens);
+    parser.parseProgram();
+    return std::move(parser.program);
+}
+
+/**
+ * @brief Sobrecarga para tokens que ya están en memoria fuera de una ArrayList, p. ej. los de
+ * DocumentIndex, sin copiarlos.
+ * @param tokens Punteros a los tokens en orden; deben seguir vivos durante la llamada.
+ */
+inline ProgramStruct ProgramParser::parse(std::vector<const NodeStruct*> tokens) {
+    INSTRUMENT_SCOPE("parseProgram");
+    ProgramParser parser(std::move(tokens));
+    parser.parseProgram();
+    return std::move(parser.program);
+}
+
+inline const NodeStruct* ProgramParser::peek(const size_t ahead) const {
+    const size_t index = this->position + ahead;
+    return index < this->tokens.size() ? this->tokens[index] : nullptr;
+}
+
+inline bool ProgramParser::at(const TokenType type, const char* name, const size_t ahead) const {
+    const NodeStruct* token = this->peek(ahead);
+    return token != nullptr && token->type == type && token->name == name;
+}
+
+inline void ProgramParser::expect(const TokenType type, const char* name) {
+    if (!this->at(type, name)) this->fail(std::string("Expected '") + name + "'");
+    ++this->position;
+}
+
+/**
+ * @brief Desplazamiento del token actual, o del final del último si ya no quedan tokens.
+ */
+inline uint32_t ProgramParser::offset() const {
+    if (this->position < this->tokens.size()) return this->tokens[this->position]->offset;
+    if (this->tokens.empty()) return 0;
+    return this->tokens.back()->offset + this->tokens.back()->length;
+}
+
+inline void ProgramParser::fail(const std::string &message) const {
+    throw std::out_of_range(message + " at offset " + std::to_string(this->offset()));
+}
+
+inline bool ProgramParser::isTypeKeyword(const NodeStruct* token) {
+    return token != nullptr && token->type == TokenType::KEYWORD &&
+           (token->name == "int" || token->name == "float" || token->name == "double" || token->name == "string");
+}
+
+inline ValueType ProgramParser::toValueType(const NodeStruct &token) {
+    if (token.name == "int") return ValueType::INT;
+    return token.name == "string" ? ValueType::STRING : ValueType::DOUBLE;
+}
+
+/**
+ * @brief Los números se convierten entre sí al asignarse; las cadenas solo a cadenas.
+ */
+inline bool ProgramParser::assignable(const ValueType target, const ValueType value) {
+    return (target == ValueType::STRING) == (value == ValueType::STRING);
+}
+
+/**
+ * @brief Reserva una ranura para una variable en el ámbito actual.
+ * Redeclarar un nombre en el mismo ámbito crea una variable nueva que oculta a la anterior.
+ */
+inline int32_t ProgramParser::declare(const NodeStruct &name, const ValueType type, const bool array) {
+    const int32_t slot = static_cast<int32_t>(this->program.variables.size());
+    this->program.variables.push_back(VariableInfo{name.name, type, array, this->scopes.size() <= this->globalDepth,
+                                                      name.offset});
+    this->scopes.back()[name.name] = slot;
+    return slot;
+}
+
+inline int32_t ProgramParser::lookup(const NodeStruct &name) const {
+    for (size_t i = this->scopes.size(); i > 0; i--) {
+        const auto found = this->scopes[i - 1].find(name.name);
+        if (found != this->scopes[i - 1].end()) return found->second;
+    }
+    throw std::out_of_range("Undefined variable: " + name.name + " at offset " + std::to_string(name.offset));
+}
+
+inline int32_t ProgramParser::addExpression(const ExpressionNode &node) {
+    this->program.expressions.push_back(node);
+    return static_cast<int32_t>(this->program.expressions.size() - 1);
+}
+
+inline int32_t ProgramParser::addStatement(const StatementNode &node) {
+    this->program.statements.push_back(node);
+    return static_cast<int32_t>(this->program.statements.size() - 1);
+}
+
+/**
+ * @brief Busca, desde @p from y fuera de paréntesis, corchetes y llaves, el token @p name u @p other.
+ * * Un delimitador de cierre sin pareja también termina la búsqueda, de modo que `)` cierra la
+ * condición de un `if` aunque no se haya abierto dentro del tramo.
+ * @return Posición del terminador; el número de tokens si no aparece.
+ */
+inline size_t ProgramParser::findTerminator(const size_t from, const char* name, const char* other) const {
+    int depth = 0;
+    for (size_t i = from; i < this->tokens.size(); i++) {
+        const NodeStruct &token = *this->tokens[i];
+        const bool matches = token.name == name || (other != nullptr && token.name == other);
+        if (depth == 0 && matches && token.type != TokenType::VALUE) return i;
+        if (token.type == TokenType::OPEN_DELIMITER) ++depth;
+        else if (token.type == TokenType::CLOSE_DELIMITER && --depth < 0) return i;
+    }
+    return this->tokens.size();
+}
+
+/**
+ * @brief Comprueba que un operando no sea un arreglo sin indexar.
+ */
+inline int32_t ProgramParser::scalarOperand(const int32_t expression) const {
+    const ExpressionNode &node = this->program.expressions[static_cast<size_t>(expression)];
+    if (node.kind == ExpressionKind::VARIABLE && this->program.variables[static_cast<size_t>(node.symbol)].array) {
+        throw std::out_of_range("Array used as a value: " + this->program.variables[static_cast<size_t>(node.symbol)].name +
+                                " at offset " + std::to_string(node.offset));
+    }
+    return expression;
+}
+
+/**
+ * @brief Arma el árbol de una expresión postfija con una pila de índices y calcula sus tipos.
+ * @param postfix Tokens en orden postfijo.
+ * @param at Desplazamiento de la expresión, para los mensajes de error.
+ * @throw std::out_of_range Si faltan operandos, una variable no existe o los tipos no son compatibles.
+ * @return Índice de la raíz en ProgramStruct::expressions.
+ */
+inline int32_t ProgramParser::buildExpression(const ArrayList<NodeStruct> &postfix, const uint32_t at) {
+    SmallStack<int32_t> stack;
+    int32_t operands[3] = {};
+    const auto take = [&](const size_t count) {
+        if (stack.getSize() < count) throw std::out_of_range("Invalid expression at offset " + std::to_string(at));
+        for (size_t i = count; i > 0; i--) stack.tryPop(operands[i - 1]);
+    };
+    const auto typeOf = [this](const int32_t expression) {
+        return this->program.expressions[static_cast<size_t>(expression)].type;
+    };
+    const auto invalid = [](const NodeStruct &token) {
+        return std::out_of_range("Invalid operands for '" + token.name + "' at offset " + std::to_string(token.offset));
+    };
+
+    for (Node<NodeStruct>* node = postfix.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const NodeStruct &token = node->getDataRef();
+        ExpressionNode expression{ExpressionKind::NUMBER, OpCode::PUSH, ValueType::INT, -1, -1, -1, -1, {}, token.offset};
+
+        if (token.type == TokenType::VALUE) {
+            if (token.value.kind == NumberKind::NONE) {
+                expression.kind = ExpressionKind::STRING;
+                expression.type = ValueType::STRING;
+                expression.symbol = static_cast<int32_t>(this->program.strings.size());
+                this->program.strings.push_back(token.name);
+            } else {
+                expression.type = token.value.kind == NumberKind::INTEGER ? ValueType::INT : ValueType::DOUBLE;
+                expression.number = token.value;
+            }
+        } else if (OperationsAnalyzer::isCall(token)) {
+            expression.kind = ExpressionKind::CALL;
+            expression.type = ValueType::DOUBLE;
+            expression.symbol = OperationsAnalyzer::resolveCall(token);
+            const size_t arity = static_cast<size_t>(BuiltinFunctions::get(expression.symbol).arity);
+            take(arity);
+            for (size_t i = 0; i < arity; i++) {
+                if (typeOf(scalarOperand(operands[i])) == ValueType::STRING) throw invalid(token);
+            }
+            expression.left = arity > 0 ? operands[0] : -1;
+            expression.right = arity > 1 ? operands[1] : -1;
+        } else if (token.type == TokenType::IDENTIFIER) {
+            expression.kind = ExpressionKind::VARIABLE;
+            expression.symbol = this->lookup(token);
+            expression.type = this->program.variables[static_cast<size_t>(expression.symbol)].type;
+        } else if (token.name == "&&" || token.name == "||") {
+            take(2);
+            if (typeOf(scalarOperand(operands[0])) == ValueType::STRING ||
+                typeOf(scalarOperand(operands[1])) == ValueType::STRING) throw invalid(token);
+            expression.kind = token.name == "&&" ? ExpressionKind::AND : ExpressionKind::OR;
+            expression.left = operands[0];
+            expression.right = operands[1];
+        } else if (token.name == ":") {
+            take(3);
+            const ValueType a = typeOf(scalarOperand(operands[1]));
+            const ValueType b = typeOf(scalarOperand(operands[2]));
+            if (typeOf(scalarOperand(operands[0])) == ValueType::STRING || !assignable(a, b)) throw invalid(token);
+            expression.kind = ExpressionKind::CONDITIONAL;
+            expression.type = a == b ? a : ValueType::DOUBLE;
+            expression.extra = operands[0];
+            expression.left = operands[1];
+            expression.right = operands[2];
+        } else {
+            OpCode op;
+            if (!OperationsAnalyzer::toOpCode(token, op)) throw invalid(token);
+            expression.op = op;
+            if (op == OpCode::INDEX) {
+                take(2);
+                const ExpressionNode &base = this->program.expressions[static_cast<size_t>(operands[0])];
+                if (base.kind != ExpressionKind::VARIABLE || !this->program.variables[static_cast<size_t>(base.symbol)].array ||
+                    typeOf(scalarOperand(operands[1])) != ValueType::INT) throw invalid(token);
+                expression.kind = ExpressionKind::INDEX;
+                expression.symbol = base.symbol;
+                expression.type = base.type;
+                expression.left = operands[0];
+                expression.right = operands[1];
+            } else if (op == OpCode::PRE_INC || op == OpCode::PRE_DEC || op == OpCode::POST_INC || op == OpCode::POST_DEC) {
+                take(1);
+                const ExpressionNode &target = this->program.expressions[static_cast<size_t>(scalarOperand(operands[0]))];
+                if ((target.kind != ExpressionKind::VARIABLE && target.kind != ExpressionKind::INDEX) ||
+                    target.type == ValueType::STRING) throw invalid(token);
+                expression.kind = ExpressionKind::STEP;
+                expression.type = target.type;
+                expression.left = operands[0];
+            } else if (op == OpCode::NEG || op == OpCode::NOT) {
+                take(1);
+                const ValueType type = typeOf(scalarOperand(operands[0]));
+                if (type == ValueType::STRING) throw invalid(token);
+                expression.kind = ExpressionKind::UNARY;
+                expression.type = op == OpCode::NEG ? type : ValueType::INT;
+                expression.left = operands[0];
+            } else {
+                take(2);
+                const ValueType left = typeOf(scalarOperand(operands[0]));
+                const ValueType right = typeOf(scalarOperand(operands[1]));
+                const bool comparison = op == OpCode::EQ || op == OpCode::NE || op == OpCode::LT ||
+                                        op == OpCode::GT || op == OpCode::LE || op == OpCode::GE;
+                if (left == ValueType::STRING || right == ValueType::STRING) {
+                    if (left != right || (op != OpCode::ADD && op != OpCode::EQ && op != OpCode::NE)) throw invalid(token);
+                    expression.type = op == OpCode::ADD ? ValueType::STRING : ValueType::INT;
+                } else if (comparison) {
+                    expression.type = ValueType::INT;
+                } else {
+                    expression.type = op != OpCode::POW && left == ValueType::INT && right == ValueType::INT
+                                      ? ValueType::INT : ValueType::DOUBLE;
+                }
+                expression.kind = ExpressionKind::BINARY;
+                expression.left = operands[0];
+                expression.right = operands[1];
+            }
+        }
+        stack.push(this->addExpression(expression));
+    }
+
+    if (stack.getSize() != 1) throw std::out_of_range("Invalid expression at offset " + std::to_string(at));
+    return *stack.peek();
+}
+
+/**
+ * @brief Analiza la expresión que ocupa los tokens [posición actual, @p end).
+ */
+inline int32_t ProgramParser::parseExpression(const size_t end) {
+    if (end <= this->position) this->fail("Expected expression");
+    const uint32_t at = this->offset();
+    ArrayList<NodeStruct> infix;
+    for (; this->position < end; ++this->position) infix.addLast(*this->tokens[this->position]);
+    return this->buildExpression(OperationsAnalyzer::toPostfix(infix), at);
+}
+
+/**
+ * @brief Condición entre paréntesis de `if` y `while`.
+ */
+inline int32_t ProgramParser::parseCondition() {
+    this->expect(TokenType::OPEN_DELIMITER, "(");
+    const int32_t condition = this->parseCondition(this->findTerminator(this->position, ")"));
+    this->expect(TokenType::CLOSE_DELIMITER, ")");
+    return condition;
+}
+
+/**
+ * @brief Condición de `if`, `while` o `for` hasta la posición @c end, sin delimitadores.
+ * @throw std::out_of_range Si la condición es una cadena.
+ */
+inline int32_t ProgramParser::parseCondition(const size_t end) {
+    const int32_t condition = this->parseExpression(end);
+    if (this->program.expressions[static_cast<size_t>(condition)].type == ValueType::STRING) {
+        this->fail("Condition must be numeric");
+    }
+    return condition;
+}
+
+/**
+ * @brief Asignación `x = e`, `v[i] = e` o expresión, sin el terminador.
+ * @param end Posición del terminador (`;` o el `)` de un `for`).
+ */
+inline int32_t ProgramParser::parseSimple(const size_t end) {
+    const uint32_t at = this->offset();
+    size_t assignment = end;
+    int depth = 0;
+    for (size_t i = this->position; i < end && assignment == end; i++) {
+        const NodeStruct &token = *this->tokens[i];
+        if (token.type == TokenType::OPEN_DELIMITER) ++depth;
+        else if (token.type == TokenType::CLOSE_DELIMITER) --depth;
+        else if (depth == 0 && token.type == TokenType::ASSIGNMENT) assignment = i;
+    }
+
+    StatementNode statement{StatementKind::EXPRESSION, -1, -1, -1, -1, -1, -1, -1, -1, 0, at};
+    if (assignment == end) {
+        statement.value = this->parseExpression(end);
+        return this->addStatement(statement);
+    }
+
+    const int32_t target = this->parseExpression(assignment);
+    const ExpressionNode lvalue = this->program.expressions[static_cast<size_t>(target)];
+    if (lvalue.kind != ExpressionKind::INDEX && (lvalue.kind != ExpressionKind::VARIABLE ||
+        this->program.variables[static_cast<size_t>(lvalue.symbol)].array)) {
+        throw std::out_of_range("Invalid assignment target at offset " + std::to_string(at));
+    }
+    ++this->position;
+    statement.kind = StatementKind::ASSIGN;
+    statement.target = lvalue.symbol;
+    statement.index = lvalue.kind == ExpressionKind::INDEX ? lvalue.right : -1;
+    statement.value = this->parseExpression(end);
+    if (!assignable(lvalue.type, this->program.expressions[static_cast<size_t>(statement.value)].type)) {
+        throw std::out_of_range("Type mismatch in assignment at offset " + std::to_string(at));
+    }
+    return this->addStatement(statement);
+}
+
+/**
+ * @brief Declaración `tipo nombre [= e];` o `tipo nombre[n] [= {e, ...}];`, incluido el `;`.
+ * * La variable se declara después de su inicializador, que no puede referirse a ella.
+ */
+inline int32_t ProgramParser::parseDeclaration() {
+    const uint32_t at = this->offset();
+    const ValueType type = toValueType(*this->peek());
+    ++this->position;
+    const NodeStruct* name = this->peek();
+    if (name == nullptr || name->type != TokenType::IDENTIFIER) this->fail("Expected identifier");
+    ++this->position;
+
+    StatementNode statement{StatementKind::DECLARE, -1, -1, -1, -1, -1, -1, -1, -1, 0, at};
+    const bool array = this->at(TokenType::OPEN_DELIMITER, "[");
+    if (array) {
+        ++this->position;
+        if (!this->at(TokenType::CLOSE_DELIMITER, "]")) {
+            statement.index = this->parseExpression(this->findTerminator(this->position, "]"));
+            if (this->program.expressions[static_cast<size_t>(statement.index)].type != ValueType::INT) {
+                this->fail("Array size must be an int");
+            }
+        }
+        this->expect(TokenType::CLOSE_DELIMITER, "]");
+    }
+
+    if (this->at(TokenType::ASSIGNMENT, "=")) {
+        ++this->position;
+        if (array) {
+            this->expect(TokenType::OPEN_DELIMITER, "{");
+            std::vector<int32_t> elements;
+            while (!this->at(TokenType::CLOSE_DELIMITER, "}")) {
+                const int32_t element = this->parseExpression(this->findTerminator(this->position, ",", "}"));
+                if (!assignable(type, this->program.expressions[static_cast<size_t>(element)].type)) {
+                    this->fail("Type mismatch in initializer");
+                }
+                elements.push_back(element);
+                if (this->at(TokenType::DELIMITER, ",")) ++this->position;
+            }
+            ++this->position;
+            statement.first = static_cast<int32_t>(this->program.items.size());
+            statement.count = static_cast<int32_t>(elements.size());
+            this->program.items.insert(this->program.items.end(), elements.begin(), elements.end());
+        } else {
+            statement.value = this->parseExpression(this->findTerminator(this->position, ";"));
+            if (!assignable(type, this->program.expressions[static_cast<size_t>(statement.value)].type)) {
+                this->fail("Type mismatch in declaration");
+            }
+        }
+    }
+    if (array && statement.index < 0 && statement.first < 0) this->fail("Array size required");
+    this->expect(TokenType::DELIMITER, ";");
+    statement.target = this->declare(*name, type, array);
+    return this->addStatement(statement);
+}
+
+/**
+ * @brief Bloque `{ ... }` con su propio ámbito.
+ */
+inline int32_t ProgramParser::parseBlock() {
+    const uint32_t at = this->offset();
+    this->expect(TokenType::OPEN_DELIMITER, "{");
+    this->scopes.emplace_back();
+    std::vector<int32_t> children;
+    while (!this->at(TokenType::CLOSE_DELIMITER, "}")) {
+        if (this->peek() == nullptr) this->fail("Expected '}'");
+        children.push_back(this->parseStatement());
+    }
+    ++this->position;
+    this->scopes.pop_back();
+
+    const int32_t first = static_cast<int32_t>(this->program.items.size());
+    this->program.items.insert(this->program.items.end(), children.begin(), children.end());
+    return this->addStatement(StatementNode{StatementKind::BLOCK, -1, -1, -1, -1, -1, -1, -1, first,
+                                            static_cast<int32_t>(children.size()), at});
+}
+
+/**
+ * @brief Cuerpo de `if`, `else`, `while` o `for`. Una declaración suelta no abre ámbito propio y
+ * quedaría registrada en el ámbito exterior aunque el cuerpo no se ejecutara, así que solo se
+ * admite dentro de un bloque.
+ * @throw std::out_of_range Si el cuerpo es una declaración.
+ */
+inline int32_t ProgramParser::parseBody() {
+    if (isTypeKeyword(this->peek())) this->fail("Declaration must be inside a block");
+    return this->parseStatement();
+}
+
+inline int32_t ProgramParser::parseStatement() {
+    const NodeStruct* token = this->peek();
+    const uint32_t at = this->offset();
+    StatementNode statement{StatementKind::BLOCK, -1, -1, -1, -1, -1, -1, -1, -1, 0, at};
+
+    if (this->at(TokenType::OPEN_DELIMITER, "{")) return this->parseBlock();
+    if (this->at(TokenType::DELIMITER, ";")) {
+        ++this->position;
+        return this->addStatement(statement);
+    }
+    if (isTypeKeyword(token)) return this->parseDeclaration();
+
+    if (this->at(TokenType::KEYWORD, "if")) {
+        ++this->position;
+        statement.kind = StatementKind::IF;
+        statement.value = this->parseCondition();
+        statement.body = this->parseBody();
+        if (this->at(TokenType::KEYWORD, "else")) {
+            ++this->position;
+            statement.otherwise = this->parseBody();
+        }
+        return this->addStatement(statement);
+    }
+
+    if (this->at(TokenType::KEYWORD, "while")) {
+        ++this->position;
+        statement.kind = StatementKind::WHILE;
+        statement.value = this->parseCondition();
+        ++this->loopDepth;
+        statement.body = this->parseBody();
+        --this->loopDepth;
+        return this->addStatement(statement);
+    }
+
+    if (this->at(TokenType::KEYWORD, "for")) {
+        ++this->position;
+        statement.kind = StatementKind::FOR;
+        this->expect(TokenType::OPEN_DELIMITER, "(");
+        this->scopes.emplace_back();
+        if (isTypeKeyword(this->peek())) {
+            statement.init = this->parseDeclaration();
+        } else {
+            const size_t end = this->findTerminator(this->position, ";");
+            if (end > this->position) statement.init = this->parseSimple(end);
+            this->expect(TokenType::DELIMITER, ";");
+        }
+        const size_t condition = this->findTerminator(this->position, ";");
+        if (condition > this->position) statement.value = this->parseCondition(condition);
+        this->expect(TokenType::DELIMITER, ";");
+        const size_t step = this->findTerminator(this->position, ")");
+        if (step > this->position) statement.step = this->parseSimple(step);
+        this->expect(TokenType::CLOSE_DELIMITER, ")");
+        ++this->loopDepth;
+        statement.body = this->parseBody();
+        --this->loopDepth;
+        this->scopes.pop_back();
+        return this->addStatement(statement);
+    }
+
+    if (this->at(TokenType::KEYWORD, "return")) {
+        ++this->position;
+        statement.kind = StatementKind::RETURN;
+        const size_t end = this->findTerminator(this->position, ";");
+        if (end > this->position) statement.value = this->parseExpression(end);
+        this->expect(TokenType::DELIMITER, ";");
+        return this->addStatement(statement);
+    }
+
+    if ((this->at(TokenType::IDENTIFIER, "break") || this->at(TokenType::IDENTIFIER, "continue")) &&
+        this->at(TokenType::DELIMITER, ";", 1)) {
+        if (this->loopDepth == 0) this->fail("'" + token->name + "' outside of a loop");
+        statement.kind = token->name == "break" ? StatementKind::BREAK : StatementKind::CONTINUE;
+        this->position += 2;
+        return this->addStatement(statement);
+    }
+
+    const size_t end = this->findTerminator(this->position, ";");
+    const int32_t simple = this->parseSimple(end);
+    this->expect(TokenType::DELIMITER, ";");
+    return simple;
+}
+
+/**
+ * @brief Sentencias de nivel superior; `tipo main() { ... }` aporta su cuerpo al programa.
+ * * Las declaraciones del nivel superior y del cuerpo de main son globales.
+ */
+inline void ProgramParser::parseProgram() {
+    this->scopes.emplace_back();
+    std::vector<int32_t> children;
+    while (this->peek() != nullptr) {
+        const bool function = isTypeKeyword(this->peek()) && this->peek(1) != nullptr &&
+                              this->peek(1)->type == TokenType::IDENTIFIER && this->at(TokenType::OPEN_DELIMITER, "(", 2);
+        if (!function) {
+            children.push_back(this->parseStatement());
+            continue;
+        }
+        if (this->peek(1)->name != "main" || !this->at(TokenType::CLOSE_DELIMITER, ")", 3)) {
+            this->fail("Only a parameterless main() is supported");
+        }
+        this->position += 4;
+        this->globalDepth = 2;
+        children.push_back(this->parseBlock());
+        this->globalDepth = 1;
+    }
+
+    this->program.root = static_cast<int32_t>(this->program.statements.size());
+    const int32_t first = static_cast<int32_t>(this->program.items.size());
+    this->program.items.insert(this->program.items.end(), children.begin(), children.end());
+    this->program.statements.push_back(StatementNode{StatementKind::BLOCK, -1, -1, -1, -1, -1, -1, -1, first,
+                                                     static_cast<int32_t>(children.size()), 0});
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef SMALL_STACK_H
+#define SMALL_STACK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../instrumentation/instrumentation.h"
+
+/**
+ * @brief Pila contigua con almacenamiento interno para profundidades pequeñas.
+ * * Los primeros @p InlineCapacity elementos viven dentro del propio objeto (sin reservas
+ * de heap); al superarlos se migra a un arreglo dinámico que duplica su capacidad.
+ * A diferencia de Stack<T>, la API de consulta no lanza excepciones: informa del
+ * resultado mediante su valor de retorno.
+ * @tparam T Tipo de los elementos.
+ * @tparam InlineCapacity Número de elementos almacenados sin reservar memoria.
+ */
+template <typename T, size_t InlineCapacity = 32>
+class SmallStack {
+
+    private:
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type inlineStorage[InlineCapacity];
+        T* items;
+        size_t count;
+        size_t capacity;
+        bool isInline() const;
+        void grow();
+
+    public:
+        SmallStack();
+        SmallStack(const SmallStack&) = delete;
+        SmallStack& operator=(const SmallStack&) = delete;
+        void push(const T &data);
+        void push(T &&data);
+        bool tryPop(T &out);
+        bool pop();
+        const T* peek() const;
+        T* peek();
+        size_t getSize() const;
+        bool isEmpty() const;
+        void clear();
+        ~SmallStack();
+};
+
+/**
+ * @brief Constructor por defecto: pila vacía sobre el almacenamiento interno.
+ */
+template <typename T, size_t InlineCapacity>
+SmallStack<T, InlineCapacity>::SmallStack()
+    : items(reinterpret_cast<T*>(inlineStorage)), count(0), capacity(InlineCapacity) {}
+
+/**
+ * @brief Indica si los elementos siguen en el almacenamiento interno.
+ */
+template <typename T, size_t InlineCapacity>
+bool SmallStack<T, InlineCapacity>::isInline() const {
+    return this->items == reinterpret_cast<const T*>(this->inlineStorage);
+}
+
+/**
+ * @brief Duplica la capacidad moviendo los elementos a un nuevo arreglo del heap.
+ */
+template <typename T, size_t InlineCapacity>
+void SmallStack<T, InlineCapacity>::grow() {
+    const size_t newCapacity = this->capacity * 2;
+    T* newItems = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (size_t i = 0; i < this->count; i++) {
+        new (newItems + i) T(std::move(this->items[i]));
+        this->items[i].~T();
+    }
+    if (!this->isInline()) ::operator delete(this->items);
+    this->items = newItems;
+    this->capacity = newCapacity;
+    INSTRUMENT_COUNT(Counter::ALLOCATIONS, 1);
+}
+
+/**
+ * @brief Inserta un elemento en la cima.
+ * @param data Valor a copiar.
+ */
+template <typename T, size_t InlineCapacity>
+void SmallStack<T, InlineCapacity>::push(const T &data) {
+    if (this->count == this->capacity) this->grow();
+    new (this->items + this->count) T(data);
+    ++this->count;
+    INSTRUMENT_MAX(Counter::STACK_DEPTH_MAX, static_cast<long long>(this->count));
+}
+
+/**
+ * @brief Inserta un elemento en la cima moviéndolo.
+ * @param data Valor a mover.
+ */
+template <typename T, size_t InlineCapacity>
+void SmallStack<T, InlineCapacity>::push(T &&data) {
+    if (this->count == this->capacity) this->grow();
+    new (this->items + this->count) T(std::move(data));
+    ++this->count;
+    INSTRUMENT_MAX(Counter::STACK_DEPTH_MAX, static_cast<long long>(this->count));
+}
+
+/**
+ * @brief Extrae la cima si existe.
+ * @param[out] out Recibe el elemento extraído; no se modifica si la pila está vacía.
+ * @return false si la pila estaba vacía.
+ */
+template <typename T, size_t InlineCapacity>
+bool SmallStack<T, InlineCapacity>::tryPop(T &out) {
+    if (this->count == 0) return false;
+    --this->count;
+    out = std::move(this->items[this->count]);
+    this->items[this->count].~T();
+    return true;
+}
+
+/**
+ * @brief Descarta la cima si existe.
+ * @return false si la pila estaba vacía.
+ */
+template <typename T, size_t InlineCapacity>
+bool SmallStack<T, InlineCapacity>::pop() {
+    if (this->count == 0) return false;
+    --this->count;
+    this->items[this->count].~T();
+    return true;
+}
+
+/**
+ * @brief Consulta la cima sin extraerla.
+ * @return Puntero a la cima; nullptr si la pila está vacía.
+ */
+template <typename T, size_t InlineCapacity>
+const T* SmallStack<T, InlineCapacity>::peek() const {
+    return this->count == 0 ? nullptr : this->items + this->count - 1;
+}
+
+template <typename T, size_t InlineCapacity>
+T* SmallStack<T, InlineCapacity>::peek() {
+    return this->count == 0 ? nullptr : this->items + this->count - 1;
+}
+
+/**
+ * @brief Número de elementos en la pila.
+ */
+template <typename T, size_t InlineCapacity>
+size_t SmallStack<T, InlineCapacity>::getSize() const {
+    return this->count;
+}
+
+/**
+ * @brief Comprueba si la pila está vacía.
+ */
+template <typename T, size_t InlineCapacity>
+bool SmallStack<T, InlineCapacity>::isEmpty() const {
+    return this->count == 0;
+}
+
+/**
+ * @brief Destruye todos los elementos; conserva la capacidad reservada.
+ */
+template <typename T, size_t InlineCapacity>
+void SmallStack<T, InlineCapacity>::clear() {
+    while (this->count > 0) {
+        --this->count;
+        this->items[this->count].~T();
+    }
+}
+
+/**
+ * @brief Destructor: destruye los elementos y libera el arreglo del heap si se usó.
+ */
+template <typename T, size_t InlineCapacity>
+SmallStack<T, InlineCapacity>::~SmallStack() {
+    this->clear();
+    if (!this->isInline()) ::operator delete(this->items);
+}
+
+#endif
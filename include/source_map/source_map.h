@@ -0,0 +1,90 @@
+#ifndef SOURCE_MAP_H
+#define SOURCE_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Posición legible de un byte del código fuente.
+ * @note Ambos campos empiezan en 1; la columna se mide en bytes.
+ */
+struct SourceLocation {
+    int line;
+    int column;
+};
+
+/**
+ * @brief Índice compacto de inicios de línea del código fuente.
+ * * El analizador léxico registra el desplazamiento de cada línea mientras la recorre; los
+ * tokens solo guardan su desplazamiento en bytes y la línea y columna se obtienen bajo demanda
+ * con una búsqueda binaria, en O(log n), sobre 4 bytes por línea.
+ */
+class SourceMap {
+
+    private:
+        std::vector<uint32_t> lineStarts;
+
+    public:
+        void clear();
+        void addLine(size_t offset);
+        size_t getLineCount() const;
+        size_t getLineStart(int line) const;
+        SourceLocation locate(size_t offset) const;
+        size_t getBytes() const;
+};
+
+/**
+ * @brief Vacía el índice para reutilizarlo en otro análisis.
+ */
+inline void SourceMap::clear() {
+    this->lineStarts.clear();
+}
+
+/**
+ * @brief Registra el comienzo de la siguiente línea.
+ * @param offset Desplazamiento en bytes del primer carácter de la línea; debe ser creciente.
+ * @throw std::out_of_range Si el desplazamiento no cabe en 32 bits.
+ */
+inline void SourceMap::addLine(const size_t offset) {
+    if (offset > UINT32_MAX) throw std::out_of_range("Source larger than 4 GiB at offset " + std::to_string(offset));
+    this->lineStarts.push_back(static_cast<uint32_t>(offset));
+}
+
+inline size_t SourceMap::getLineCount() const {
+    return this->lineStarts.size();
+}
+
+/**
+ * @brief Desplazamiento del primer byte de una línea.
+ * @param line Número de línea (basado en 1).
+ * @return Desplazamiento; 0 si la línea no existe.
+ */
+inline size_t SourceMap::getLineStart(const int line) const {
+    if (line < 1 || static_cast<size_t>(line) > this->lineStarts.size()) return 0;
+    return this->lineStarts[static_cast<size_t>(line - 1)];
+}
+
+/**
+ * @brief Traduce un desplazamiento en bytes a línea y columna.
+ * @param offset Desplazamiento, p. ej. NodeStruct::offset.
+ * @return Línea y columna; {0, 0} si el índice está vacío.
+ */
+inline SourceLocation SourceMap::locate(const size_t offset) const {
+    if (this->lineStarts.empty()) return SourceLocation{0, 0};
+    const auto after = std::upper_bound(this->lineStarts.begin(), this->lineStarts.end(), static_cast<uint32_t>(offset));
+    const size_t index = after == this->lineStarts.begin() ? 0 : static_cast<size_t>(after - this->lineStarts.begin()) - 1;
+    return SourceLocation{static_cast<int>(index + 1), static_cast<int>(offset - this->lineStarts[index]) + 1};
+}
+
+/**
+ * @brief Memoria reservada por el índice.
+ */
+inline size_t SourceMap::getBytes() const {
+    return this->lineStarts.capacity() * sizeof(uint32_t);
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef STACK_H
 #define STACK_H
+#include <stdexcept>
 #include "../node/node.h"
+#include "../memory_usage/memory_usage.h"
 template <typename T>
 class Stack {
     private:
@@ -15,6 +17,7 @@ class Stack {
         void printStack();
         bool has(T data);
         bool isEmpty();
+        MemoryFootprint footprint() const;
         ~Stack();
 };
 
@@ -51,6 +54,7 @@ void Stack<T>::push(T data){
         this->head = node;
     }
     ++this->size;
+    INSTRUMENT_MAX(Counter::STACK_DEPTH_MAX, this->size);
 };
 
 /**
@@ -123,6 +127,22 @@ bool Stack<T>::has(T data){
     return false;
 }
 
+/**
+ * @brief Calcula la memoria ocupada por la pila.
+ * @return Bytes de los nodos enlazados y bytes de heap reservados por los datos.
+ */
+template <typename T>
+MemoryFootprint Stack<T>::footprint() const {
+    MemoryFootprint usage;
+    usage.nodeBytes = static_cast<size_t>(this->size) * sizeof(Node<T>);
+    Node<T>* temp = this->head;
+    while (temp != nullptr) {
+        usage.stringBytes += heapBytes(temp->getDataRef());
+        temp = temp->getNextNode();
+    }
+    return usage;
+}
+
 /**
  * @brief Destructor de la clase Stack.
  * Libera de forma iterativa la memoria de todos los nodos en la pila
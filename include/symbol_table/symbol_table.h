@@ -0,0 +1,61 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Variables visibles para OperationsAnalyzer durante la evaluación.
+ * * Cada variable es un arreglo de doubles; una variable escalar es un arreglo de un elemento,
+ * de modo que `x` y `x[0]` designan el mismo valor. Los operadores ++ y -- modifican la tabla.
+ */
+class SymbolTable {
+
+    private:
+        std::unordered_map<std::string, std::vector<double>> values;
+
+    public:
+        void set(const std::string &name, double value);
+        void setArray(const std::string &name, std::vector<double> elements);
+        std::vector<double>* find(const std::string &name);
+        double get(const std::string &name) const;
+        size_t size() const;
+        void clear();
+};
+
+inline void SymbolTable::set(const std::string &name, const double value) {
+    this->values[name].assign(1, value);
+}
+
+inline void SymbolTable::setArray(const std::string &name, std::vector<double> elements) {
+    this->values[name] = std::move(elements);
+}
+
+/**
+ * @return Almacenamiento de la variable; nullptr si no está definida.
+ */
+inline std::vector<double>* SymbolTable::find(const std::string &name) {
+    const auto found = this->values.find(name);
+    return found == this->values.end() ? nullptr : &found->second;
+}
+
+/**
+ * @brief Valor escalar (primer elemento) de una variable.
+ * @return 0.0 si la variable no existe o está vacía.
+ */
+inline double SymbolTable::get(const std::string &name) const {
+    const auto found = this->values.find(name);
+    return found == this->values.end() || found->second.empty() ? 0.0 : found->second[0];
+}
+
+inline size_t SymbolTable::size() const {
+    return this->values.size();
+}
+
+inline void SymbolTable::clear() {
+    this->values.clear();
+}
+
+#endif
@@ -0,0 +1,484 @@
+#ifndef TIERED_INTERPRETER_H
+#define TIERED_INTERPRETER_H
+
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../operations_analyzer/operations_analyzer.h"
+#include "../../interface/program_struct.h"
+
+/**
+ * @brief Umbrales de promoción de TieredInterpreter.
+ * @note Una expresión se compila cuando sus ejecuciones superan @c expressionThreshold, y todas
+ * las de un bucle cuando sus vueltas superan @c loopThreshold. Con un umbral 0 se compilan
+ * todas al construir el intérprete; con TieredInterpreter::NEVER nunca.
+ */
+struct TierPolicy {
+    uint64_t expressionThreshold = 32;
+    uint64_t loopThreshold = 256;
+};
+
+/**
+ * @brief Perfil de una expresión raíz de una sentencia.
+ * @note @c promotedAt es el número de ejecuciones al compilarla; @c byLoop indica que la
+ * promovió el contador de su bucle y no el suyo.
+ */
+struct SiteProfile {
+    int32_t expression;
+    int32_t loop;
+    uint32_t offset;
+    uint64_t executions;
+    uint64_t promotedAt;
+    bool compiled;
+    bool byLoop;
+};
+
+/**
+ * @brief Perfil de un `while` o `for`: vueltas (saltos hacia atrás) y si ya se promovió.
+ */
+struct LoopProfile {
+    int32_t statement;
+    uint32_t offset;
+    uint64_t backEdges;
+    bool promoted;
+};
+
+/**
+ * @brief Ejecuta un ProgramStruct evaluando sus expresiones con OperationsAnalyzer por niveles.
+ * * Cada expresión raíz de una sentencia es un sitio con su contador. Al principio se evalúa
+ * con OperationsAnalyzer::evaluatePostfix(), que vuelve a compilar los tokens postfijos en cada
+ * ejecución; al superar el umbral se compila una sola vez a un CompiledExpression propio (o a
+ * su resultado, si no lee variables) y desde entonces se ejecuta directamente. Cada bucle cuenta
+ * sus vueltas y al superar su umbral promueve a la vez todos los sitios de su cuerpo.
+ * * Los tokens postfijos se generan a partir del árbol la primera vez que se necesitan, así que
+ * el código que nunca se ejecuta no cuesta nada. Los valores son los de OperationsAnalyzer:
+ * doubles en una SymbolTable. Las asignaciones a variables `int` truncan hacia cero. Las
+ * variables homónimas de distintos ámbitos se distinguen con el sufijo `#<ranura>`.
+ * * Las cadenas no se admiten. Un índice fuera de rango o un tamaño de arreglo negativo lanzan
+ * std::out_of_range. Los contadores se acumulan entre llamadas a run().
+ */
+class TieredInterpreter {
+
+    private:
+        enum class Flow {
+            NEXT,
+            BREAK,
+            CONTINUE,
+            RETURN
+        };
+
+        struct Site {
+            ArrayList<NodeStruct> postfix;
+            CompiledExpression program;
+            SiteProfile profile;
+        };
+
+        struct LoopSites {
+            size_t first;
+            size_t last;
+        };
+
+        const ProgramStruct &program;
+        TierPolicy policy;
+        SymbolTable symbols;
+        std::vector<std::string> names;
+        std::vector<int32_t> siteOf;
+        std::vector<Site> sites;
+        std::vector<int32_t> loopOf;
+        std::vector<LoopProfile> loops;
+        std::vector<LoopSites> loopSites;
+        double result = 0.0;
+
+        const ExpressionNode &node(int32_t index) const;
+        static const char* operatorName(OpCode op);
+        static NodeStruct token(TokenType type, const std::string &name);
+        void postfix(int32_t index, ArrayList<NodeStruct> &out) const;
+        uint32_t offsetOf(int32_t index) const;
+        void addSite(int32_t expression, int32_t loop);
+        void collect(int32_t statement, int32_t loop);
+        void promote(Site &site, bool byLoop);
+        void backEdge(int32_t loop);
+        double evaluate(int32_t expression);
+        double convert(int32_t variable, double value) const;
+        void declare(const StatementNode &statement);
+        void assign(const StatementNode &statement);
+        Flow execute(int32_t statement);
+
+    public:
+        static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+        explicit TieredInterpreter(const ProgramStruct &program, TierPolicy policy = TierPolicy());
+        double run();
+        double get(int32_t variable) const;
+        std::vector<SiteProfile> siteProfiles() const;
+        const std::vector<LoopProfile> &loopProfiles() const;
+        size_t compiledSites() const;
+        void dump(std::ostream &out) const;
+};
+
+/**
+ * @brief Registra los sitios y bucles del programa.
+ * @param program Árbol de ProgramParser::parse(); debe seguir vivo mientras se use el intérprete.
+ * @param policy Umbrales de promoción.
+ * @throw std::out_of_range Si el programa usa cadenas.
+ */
+inline TieredInterpreter::TieredInterpreter(const ProgramStruct &program, const TierPolicy policy)
+    : program(program), policy(policy) {
+    std::unordered_map<std::string, int> uses;
+    for (const VariableInfo &variable : program.variables) {
+        if (variable.type == ValueType::STRING) throw std::out_of_range("Strings are not supported: " + variable.name);
+        ++uses[variable.name];
+    }
+    for (size_t i = 0; i < program.variables.size(); i++) {
+        const std::string &name = program.variables[i].name;
+        this->names.push_back(uses[name] > 1 ? name + "#" + std::to_string(i) : name);
+    }
+    for (const ExpressionNode &expression : program.expressions) {
+        if (expression.kind == ExpressionKind::STRING) throw std::out_of_range("Strings are not supported");
+    }
+
+    this->siteOf.assign(program.expressions.size(), -1);
+    this->loopOf.assign(program.statements.size(), -1);
+    if (program.root >= 0) this->collect(program.root, -1);
+    if (policy.expressionThreshold == 0) {
+        for (Site &site : this->sites) this->promote(site, false);
+    }
+}
+
+inline const ExpressionNode &TieredInterpreter::node(const int32_t index) const {
+    return this->program.expressions[static_cast<size_t>(index)];
+}
+
+/**
+ * @brief Token que OperationsAnalyzer::toPostfix() produciría para un operador.
+ */
+inline const char* TieredInterpreter::operatorName(const OpCode op) {
+    switch (op) {
+        case OpCode::ADD: return "+";
+        case OpCode::SUB: return "-";
+        case OpCode::MUL: return "*";
+        case OpCode::DIV: return "/";
+        case OpCode::MOD: return "%";
+        case OpCode::POW: return "**";
+        case OpCode::NEG: return "u-";
+        case OpCode::NOT: return "!";
+        case OpCode::EQ: return "==";
+        case OpCode::NE: return "!=";
+        case OpCode::LT: return "<";
+        case OpCode::GT: return ">";
+        case OpCode::LE: return "<=";
+        case OpCode::GE: return ">=";
+        case OpCode::INDEX: return "[]";
+        case OpCode::PRE_INC: return "++";
+        case OpCode::PRE_DEC: return "--";
+        case OpCode::POST_INC: return "x++";
+        case OpCode::POST_DEC: return "x--";
+        default: return "";
+    }
+}
+
+inline NodeStruct TieredInterpreter::token(const TokenType type, const std::string &name) {
+    NodeStruct token;
+    token.name = name;
+    token.type = type;
+    token.offset = 0;
+    token.length = 0;
+    return token;
+}
+
+/**
+ * @brief Reconstruye los tokens postfijos de una expresión a partir de su árbol.
+ */
+inline void TieredInterpreter::postfix(const int32_t index, ArrayList<NodeStruct> &out) const {
+    const ExpressionNode &expression = this->node(index);
+    switch (expression.kind) {
+        case ExpressionKind::NUMBER: {
+            NodeStruct value = token(TokenType::VALUE, "");
+            value.value = expression.number;
+            out.addLast(value);
+            break;
+        }
+        case ExpressionKind::VARIABLE:
+            out.addLast(token(TokenType::IDENTIFIER, this->names[static_cast<size_t>(expression.symbol)]));
+            break;
+        case ExpressionKind::CALL: {
+            if (expression.left >= 0) this->postfix(expression.left, out);
+            if (expression.right >= 0) this->postfix(expression.right, out);
+            const BuiltinFunction &function = BuiltinFunctions::get(expression.symbol);
+            NodeStruct call = token(TokenType::IDENTIFIER, function.name);
+            call.value.kind = NumberKind::INTEGER;
+            call.value.integer = function.arity;
+            out.addLast(call);
+            break;
+        }
+        case ExpressionKind::AND:
+        case ExpressionKind::OR:
+            this->postfix(expression.left, out);
+            this->postfix(expression.right, out);
+            out.addLast(token(TokenType::OPERATOR, expression.kind == ExpressionKind::AND ? "&&" : "||"));
+            break;
+        case ExpressionKind::CONDITIONAL:
+            this->postfix(expression.extra, out);
+            this->postfix(expression.left, out);
+            this->postfix(expression.right, out);
+            out.addLast(token(TokenType::OPERATOR, ":"));
+            break;
+        default:
+            if (expression.left >= 0) this->postfix(expression.left, out);
+            if (expression.right >= 0) this->postfix(expression.right, out);
+            out.addLast(token(TokenType::OPERATOR, operatorName(expression.op)));
+            break;
+    }
+}
+
+/**
+ * @brief Desplazamiento del primer token de una expresión; los operadores sintéticos valen 0.
+ */
+inline uint32_t TieredInterpreter::offsetOf(const int32_t index) const {
+    if (index < 0) return 0;
+    const ExpressionNode &expression = this->node(index);
+    uint32_t offset = expression.offset;
+    for (const int32_t child : {expression.extra, expression.left, expression.right}) {
+        const uint32_t inner = this->offsetOf(child);
+        if (inner != 0 && (offset == 0 || inner < offset)) offset = inner;
+    }
+    return offset;
+}
+
+inline void TieredInterpreter::addSite(const int32_t expression, const int32_t loop) {
+    if (expression < 0) return;
+    this->siteOf[static_cast<size_t>(expression)] = static_cast<int32_t>(this->sites.size());
+    this->sites.push_back(Site{ArrayList<NodeStruct>(), CompiledExpression(),
+                               SiteProfile{expression, loop, this->offsetOf(expression), 0, 0, false, false}});
+}
+
+/**
+ * @brief Recorre las sentencias en orden: los sitios de un bucle quedan contiguos.
+ * @param loop Bucle más interno que contiene la sentencia; -1 fuera de bucles.
+ */
+inline void TieredInterpreter::collect(const int32_t statement, const int32_t loop) {
+    if (statement < 0) return;
+    const StatementNode &node = this->program.statements[static_cast<size_t>(statement)];
+    switch (node.kind) {
+        case StatementKind::DECLARE:
+            this->addSite(node.index, loop);
+            this->addSite(node.value, loop);
+            for (int32_t i = 0; i < node.count; i++) this->addSite(this->program.items[static_cast<size_t>(node.first + i)], loop);
+            break;
+        case StatementKind::ASSIGN:
+            this->addSite(node.index, loop);
+            this->addSite(node.value, loop);
+            break;
+        case StatementKind::EXPRESSION:
+        case StatementKind::RETURN:
+            this->addSite(node.value, loop);
+            break;
+        case StatementKind::BLOCK:
+            for (int32_t i = 0; i < node.count; i++) this->collect(this->program.items[static_cast<size_t>(node.first + i)], loop);
+            break;
+        case StatementKind::IF:
+            this->addSite(node.value, loop);
+            this->collect(node.body, loop);
+            this->collect(node.otherwise, loop);
+            break;
+        case StatementKind::WHILE:
+        case StatementKind::FOR: {
+            this->collect(node.init, loop);
+            const int32_t inner = static_cast<int32_t>(this->loops.size());
+            this->loopOf[static_cast<size_t>(statement)] = inner;
+            this->loops.push_back(LoopProfile{statement, node.offset, 0, false});
+            this->loopSites.push_back(LoopSites{this->sites.size(), 0});
+            this->addSite(node.value, inner);
+            this->collect(node.body, inner);
+            this->collect(node.step, inner);
+            this->loopSites[static_cast<size_t>(inner)].last = this->sites.size();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Compila un sitio; si no lee variables, guarda directamente su resultado.
+ */
+inline void TieredInterpreter::promote(Site &site, const bool byLoop) {
+    if (site.profile.compiled) return;
+    if (site.postfix.isEmpty()) this->postfix(site.profile.expression, site.postfix);
+    if (!OperationsAnalyzer::compile(site.postfix, site.program)) throw std::out_of_range("Invalid postfix expression");
+    site.program.constant = site.program.names.empty();
+    if (site.program.constant) site.program.result = OperationsAnalyzer::execute(site.program);
+    site.profile.compiled = true;
+    site.profile.byLoop = byLoop;
+    site.profile.promotedAt = site.profile.executions;
+}
+
+inline void TieredInterpreter::backEdge(const int32_t loop) {
+    LoopProfile &profile = this->loops[static_cast<size_t>(loop)];
+    if (++profile.backEdges <= this->policy.loopThreshold || profile.promoted) return;
+    profile.promoted = true;
+    const LoopSites &range = this->loopSites[static_cast<size_t>(loop)];
+    for (size_t i = range.first; i < range.last; i++) this->promote(this->sites[i], true);
+}
+
+inline double TieredInterpreter::evaluate(const int32_t expression) {
+    Site &site = this->sites[static_cast<size_t>(this->siteOf[static_cast<size_t>(expression)])];
+    if (++site.profile.executions > this->policy.expressionThreshold) this->promote(site, false);
+    if (site.profile.compiled) {
+        return site.program.constant ? site.program.result : OperationsAnalyzer::execute(site.program, &this->symbols);
+    }
+    if (site.postfix.isEmpty()) this->postfix(expression, site.postfix);
+    return OperationsAnalyzer::evaluatePostfix(site.postfix, &this->symbols);
+}
+
+inline double TieredInterpreter::convert(const int32_t variable, const double value) const {
+    return this->program.variables[static_cast<size_t>(variable)].type == ValueType::INT ? std::trunc(value) : value;
+}
+
+inline void TieredInterpreter::declare(const StatementNode &statement) {
+    const std::string &name = this->names[static_cast<size_t>(statement.target)];
+    if (!this->program.variables[static_cast<size_t>(statement.target)].array) {
+        this->symbols.set(name, statement.value >= 0 ? this->convert(statement.target, this->evaluate(statement.value)) : 0.0);
+        return;
+    }
+    const double size = statement.index >= 0 ? std::trunc(this->evaluate(statement.index)) : statement.count;
+    if (!(size >= 0.0)) throw std::out_of_range("Invalid array size");
+    std::vector<double> elements(static_cast<size_t>(size), 0.0);
+    for (int32_t i = 0; i < statement.count; i++) {
+        const double value = this->convert(statement.target, this->evaluate(this->program.items[static_cast<size_t>(statement.first + i)]));
+        if (static_cast<size_t>(i) < elements.size()) elements[static_cast<size_t>(i)] = value;
+    }
+    this->symbols.setArray(name, std::move(elements));
+}
+
+inline void TieredInterpreter::assign(const StatementNode &statement) {
+    const std::string &name = this->names[static_cast<size_t>(statement.target)];
+    if (statement.index < 0) {
+        this->symbols.set(name, this->convert(statement.target, this->evaluate(statement.value)));
+        return;
+    }
+    const double index = this->evaluate(statement.index);
+    const double value = this->convert(statement.target, this->evaluate(statement.value));
+    std::vector<double>* storage = this->symbols.find(name);
+    if (storage == nullptr || !(index >= 0.0) || index >= static_cast<double>(storage->size()) ||
+        index != std::floor(index)) {
+        throw std::out_of_range("Index out of range");
+    }
+    (*storage)[static_cast<size_t>(index)] = value;
+}
+
+inline TieredInterpreter::Flow TieredInterpreter::execute(const int32_t index) {
+    const StatementNode &statement = this->program.statements[static_cast<size_t>(index)];
+    switch (statement.kind) {
+        case StatementKind::DECLARE:
+            this->declare(statement);
+            return Flow::NEXT;
+        case StatementKind::ASSIGN:
+            this->assign(statement);
+            return Flow::NEXT;
+        case StatementKind::EXPRESSION:
+            this->evaluate(statement.value);
+            return Flow::NEXT;
+        case StatementKind::BLOCK:
+            for (int32_t i = 0; i < statement.count; i++) {
+                const Flow flow = this->execute(this->program.items[static_cast<size_t>(statement.first + i)]);
+                if (flow != Flow::NEXT) return flow;
+            }
+            return Flow::NEXT;
+        case StatementKind::IF:
+            if (this->evaluate(statement.value) != 0.0) return this->execute(statement.body);
+            return statement.otherwise >= 0 ? this->execute(statement.otherwise) : Flow::NEXT;
+        case StatementKind::WHILE:
+        case StatementKind::FOR: {
+            const int32_t loop = this->loopOf[static_cast<size_t>(index)];
+            if (statement.init >= 0) this->execute(statement.init);
+            while (statement.value < 0 || this->evaluate(statement.value) != 0.0) {
+                const Flow flow = this->execute(statement.body);
+                if (flow == Flow::BREAK) break;
+                if (flow == Flow::RETURN) return flow;
+                if (statement.step >= 0) this->execute(statement.step);
+                this->backEdge(loop);
+            }
+            return Flow::NEXT;
+        }
+        case StatementKind::BREAK:
+            return Flow::BREAK;
+        case StatementKind::CONTINUE:
+            return Flow::CONTINUE;
+        case StatementKind::RETURN:
+            this->result = statement.value >= 0 ? this->evaluate(statement.value) : 0.0;
+            return Flow::RETURN;
+    }
+    return Flow::NEXT;
+}
+
+/**
+ * @brief Ejecuta el programa desde el principio con las variables vacías.
+ * @throw std::out_of_range Si un índice se sale de su arreglo o un tamaño es negativo.
+ * @return Valor del `return` ejecutado; 0.0 si no hay ninguno.
+ */
+inline double TieredInterpreter::run() {
+    INSTRUMENT_SCOPE("tiered.run");
+    this->symbols.clear();
+    this->result = 0.0;
+    if (this->program.root >= 0) this->execute(this->program.root);
+    return this->result;
+}
+
+/**
+ * @brief Valor escalar de una variable tras la última ejecución; 0.0 si no llegó a declararse.
+ */
+inline double TieredInterpreter::get(const int32_t variable) const {
+    return this->symbols.get(this->names[static_cast<size_t>(variable)]);
+}
+
+inline std::vector<SiteProfile> TieredInterpreter::siteProfiles() const {
+    std::vector<SiteProfile> profiles;
+    profiles.reserve(this->sites.size());
+    for (const Site &site : this->sites) profiles.push_back(site.profile);
+    return profiles;
+}
+
+inline const std::vector<LoopProfile> &TieredInterpreter::loopProfiles() const {
+    return this->loops;
+}
+
+inline size_t TieredInterpreter::compiledSites() const {
+    size_t count = 0;
+    for (const Site &site : this->sites) count += site.profile.compiled ? 1 : 0;
+    return count;
+}
+
+/**
+ * @brief Escribe el perfil: una fila por bucle y por sitio, en orden de aparición.
+ * El nivel de un sitio compilado indica tras cuántas ejecuciones se promovió y si fue por su bucle.
+ */
+inline void TieredInterpreter::dump(std::ostream &out) const {
+    out << std::left << std::setw(8) << "SITIO" << std::setw(8) << "BUCLE" << std::right << std::setw(10) << "DESPL"
+        << std::setw(14) << "CUENTA" << "  NIVEL" << std::endl;
+    size_t loop = 0;
+    for (size_t i = 0; i <= this->sites.size(); i++) {
+        for (; loop < this->loops.size() && (i == this->sites.size() || this->loopSites[loop].first <= i); loop++) {
+            const LoopProfile &profile = this->loops[loop];
+            out << std::left << std::setw(8) << ("L" + std::to_string(loop)) << std::setw(8) << "" << std::right
+                << std::setw(10) << profile.offset << std::setw(14) << profile.backEdges << "  "
+                << (profile.promoted ? "compilado" : "interpretado") << std::endl;
+        }
+        if (i == this->sites.size()) break;
+        const SiteProfile &profile = this->sites[i].profile;
+        out << std::left << std::setw(8) << ("e" + std::to_string(profile.expression))
+            << std::setw(8) << (profile.loop >= 0 ? "L" + std::to_string(profile.loop) : std::string("-"))
+            << std::right << std::setw(10) << profile.offset << std::setw(14) << profile.executions << "  ";
+        if (!profile.compiled) out << "interpretado";
+        else out << "compilado@" << profile.promotedAt << (profile.byLoop ? " (bucle)" : "");
+        out << std::endl;
+    }
+}
+
+#endif
@@ -1,15 +1,50 @@
 #ifndef TOKEN_PROVIDER_H
 #define TOKEN_PROVIDER_H
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include "../../interface/type_token.h"
 
+/**
+ * @brief Sintaxis de comentario de bloque: delimitador de apertura y de cierre.
+ */
+struct BlockComment {
+    std::string open;
+    std::string close;
+};
+
+/**
+ * @brief Banderas de la tabla de clases de carácter; un byte puede tener varias.
+ * * BREAK no es una bandera sino la máscara de las clases que cortan una palabra: un byte sin
+ * ninguna de ellas se acumula en la palabra en curso. NON_ASCII marca los bytes ≥ 0x80, que el
+ * analizador decodifica como UTF-8 antes de decidir si forman parte de un identificador.
+ */
+struct CharClass {
+    static constexpr uint8_t SPACE = 1 << 0;
+    static constexpr uint8_t IDENT_START = 1 << 1;
+    static constexpr uint8_t IDENT_CONTINUE = 1 << 2;
+    static constexpr uint8_t DIGIT = 1 << 3;
+    static constexpr uint8_t OPERATOR = 1 << 4;
+    static constexpr uint8_t QUOTE = 1 << 5;
+    static constexpr uint8_t COMMENT = 1 << 6;
+    static constexpr uint8_t NON_ASCII = 1 << 7;
+    static constexpr uint8_t BREAK = SPACE | OPERATOR | QUOTE | COMMENT | NON_ASCII;
+};
+
 class TokenProvider {
     private:
         std::unordered_map<std::string, TokenType> tokenMap;
+        std::vector<std::string> lineComments;
+        std::vector<BlockComment> blockComments;
+        std::vector<std::string> preprocessorPrefixes;
+        uint8_t charClasses[256] = {};
+        bool loadCommentSyntax(const std::string &typeStr, const std::string &tokenValue);
+        void buildCharClasses();
     public:
         TokenProvider();
 
@@ -21,9 +56,19 @@ class TokenProvider {
         bool isToken(const std::string &key) const;
 
         bool hasToken(const std::string& key) const;
+
+        const std::vector<std::string>& getLineComments() const;
+        const std::vector<BlockComment>& getBlockComments() const;
+        const std::vector<std::string>& getPreprocessorPrefixes() const;
+        const uint8_t* getCharClasses() const;
+        uint8_t charClass(char character) const;
+        bool mayStartComment(char character) const;
+        bool isTextDelimiter(char character) const;
     };
 
-inline TokenProvider::TokenProvider() = default;
+inline TokenProvider::TokenProvider() {
+    this->buildCharClasses();
+}
 
 /**
  * @brief Convierte un enumerador TypeToken a su representación en cadena de texto.
@@ -67,7 +112,9 @@ inline TokenType TokenProvider::toTypeToken(const std::string& str) {
  * @brief Carga la tabla de tokens desde un archivo CSV.
  * * Lee el archivo línea por línea esperando el formato: `TIPO;VALOR`.
  * Realiza una limpieza de espacios en blanco y saltos de línea tanto en la clave como en el valor.
- * * @note Ejemplo de formato de archivo: `KEYWORD;while`
+ * Las entradas LINE-COMMENT, BLOCK-COMMENT (apertura y cierre separados por un espacio) y
+ * PREPROCESSOR-LINE no son tokens: declaran la sintaxis de comentarios que el analizador omite.
+ * * @note Ejemplo de formato de archivo: `KEYWORD;while`, `LINE-COMMENT;//`
  * * @param file_config @param filename Ruta relativa o absoluta del archivo de configuración.
  * @return true Si el archivo se cargó y procesó correctamente.
  * @return false Si hubo un error al intentar abrir el archivo.
@@ -93,14 +140,73 @@ inline bool TokenProvider::loadConfig(std::ifstream& file_config) {
                 typeStr.erase(0, typeStr.find_first_not_of(' '));
                 typeStr.erase(typeStr.find_last_not_of(' ') + 1);
 
-                this->tokenMap[tokenValue] = TokenProvider::toTypeToken(typeStr);
+                if (this->loadCommentSyntax(typeStr, tokenValue)) continue;
+                const TokenType type = TokenProvider::toTypeToken(typeStr);
+                this->tokenMap[tokenValue] = type;
             }
         }
     }
     file_config.close();
+    this->buildCharClasses();
     return true;
 }
 
+/**
+ * @brief Recalcula la tabla de 256 clases de carácter a partir de la configuración cargada.
+ * * Las clases ASCII son fijas y no dependen del locale: SPACE son ' ', \t, \n, \v, \f y \r;
+ * IDENT_START las letras y '_'; IDENT_CONTINUE además los dígitos. OPERATOR marca los bytes que
+ * forman un token propio: los registrados como token de un carácter y cualquier otro byte ASCII
+ * que no sea espacio, letra, dígito, '_' o '.'. Los bytes ≥ 0x80 solo llevan NON_ASCII. QUOTE y
+ * COMMENT salen de las entradas TEXT-DELIMITER y del primer carácter de LINE-COMMENT y BLOCK-COMMENT.
+ */
+inline void TokenProvider::buildCharClasses() {
+    for (int c = 0; c < 256; c++) {
+        uint8_t kind = this->charClasses[c] & CharClass::COMMENT;
+        const bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        const bool digit = c >= '0' && c <= '9';
+        if (c == ' ' || (c >= '\t' && c <= '\r')) kind |= CharClass::SPACE;
+        if (letter) kind |= CharClass::IDENT_START | CharClass::IDENT_CONTINUE;
+        if (digit) kind |= CharClass::DIGIT | CharClass::IDENT_CONTINUE;
+        if (c >= 0x80) kind |= CharClass::NON_ASCII;
+        else if (!(kind & CharClass::SPACE) && c != '.' && !letter && !digit) kind |= CharClass::OPERATOR;
+        this->charClasses[c] = kind;
+    }
+    for (const auto &entry : this->tokenMap) {
+        const unsigned char c = static_cast<unsigned char>(entry.first[0]);
+        if (entry.first.size() != 1 || c >= 0x80) continue;
+        if (entry.second == TokenType::TEXT_DELIMITER) this->charClasses[c] |= CharClass::QUOTE;
+        if (!(this->charClasses[c] & CharClass::SPACE) && c != '.') this->charClasses[c] |= CharClass::OPERATOR;
+    }
+}
+
+/**
+ * @brief Registra una sintaxis de comentario si la entrada de configuración declara una.
+ * @param typeStr Tipo de la entrada (LINE-COMMENT, BLOCK-COMMENT o PREPROCESSOR-LINE).
+ * @param tokenValue Prefijo del comentario, o apertura y cierre separados por un espacio.
+ * @return true si la entrada era una sintaxis de comentario (válida o no) y no debe registrarse como token.
+ */
+inline bool TokenProvider::loadCommentSyntax(const std::string &typeStr, const std::string &tokenValue) {
+    if (typeStr == "LINE-COMMENT" || typeStr == "PREPROCESSOR-LINE") {
+        if (tokenValue.empty()) return true;
+        if (typeStr == "PREPROCESSOR-LINE") {
+            this->preprocessorPrefixes.push_back(tokenValue);
+            return true;
+        }
+        this->lineComments.push_back(tokenValue);
+        this->charClasses[static_cast<unsigned char>(tokenValue[0])] |= CharClass::COMMENT;
+        return true;
+    }
+    if (typeStr == "BLOCK-COMMENT") {
+        const size_t separator = tokenValue.find(' ');
+        if (separator == std::string::npos || separator == 0) return true;
+        BlockComment comment{tokenValue.substr(0, separator), tokenValue.substr(tokenValue.find_first_not_of(' ', separator))};
+        this->charClasses[static_cast<unsigned char>(comment.open[0])] |= CharClass::COMMENT;
+        this->blockComments.push_back(std::move(comment));
+        return true;
+    }
+    return false;
+}
+
 /**
  * @brief Obtiene la categoría (TypeToken) de un lexema específico.
  * * Busca en el mapa interno si el lexema (key) existe y devuelve su clasificación.
@@ -121,4 +227,53 @@ inline TokenType TokenProvider::getToken(const std::string &key) const {
 inline bool TokenProvider::isToken(const std::string &key) const {
     return tokenMap.count(key) > 0;
 }
+
+/**
+ * @brief Prefijos de comentario de línea (p. ej. `//`).
+ */
+inline const std::vector<std::string>& TokenProvider::getLineComments() const {
+    return this->lineComments;
+}
+
+/**
+ * @brief Delimitadores de apertura y cierre de los comentarios de bloque.
+ */
+inline const std::vector<BlockComment>& TokenProvider::getBlockComments() const {
+    return this->blockComments;
+}
+
+/**
+ * @brief Prefijos de línea de preprocesador (p. ej. `#`); solo cuentan al inicio de la línea.
+ */
+inline const std::vector<std::string>& TokenProvider::getPreprocessorPrefixes() const {
+    return this->preprocessorPrefixes;
+}
+
+/**
+ * @brief Tabla de clases de carácter, indexada por el byte sin signo.
+ */
+inline const uint8_t* TokenProvider::getCharClasses() const {
+    return this->charClasses;
+}
+
+/**
+ * @brief Banderas CharClass de un byte; válido también para bytes ≥ 0x80 con char con signo.
+ */
+inline uint8_t TokenProvider::charClass(const char character) const {
+    return this->charClasses[static_cast<unsigned char>(character)];
+}
+
+/**
+ * @brief Consulta en O(1) si un carácter puede iniciar un comentario de línea o de bloque.
+ */
+inline bool TokenProvider::mayStartComment(const char character) const {
+    return (this->charClass(character) & CharClass::COMMENT) != 0;
+}
+
+/**
+ * @brief Consulta en O(1) si un carácter abre o cierra una cadena literal (TEXT-DELIMITER).
+ */
+inline bool TokenProvider::isTextDelimiter(const char character) const {
+    return (this->charClass(character) & CharClass::QUOTE) != 0;
+}
 #endif
\ No newline at end of file
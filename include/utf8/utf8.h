@@ -0,0 +1,143 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "xid_ranges.h"
+
+/**
+ * @brief Decodificación y validación de UTF-8 y clasificación de identificadores Unicode.
+ * * La validación es estricta (RFC 3629): rechaza secuencias sobrelargas, sustitutos
+ * (U+D800..U+DFFF), puntos de código mayores que U+10FFFF y secuencias truncadas. Los tramos
+ * ASCII se saltan de 32 bytes (AVX2) o 16 bytes (SSE2) por vez, o de 8 en 8 sin SIMD, así que
+ * un texto ASCII se valida sin decodificar ningún carácter.
+ */
+class Utf8 {
+
+    private:
+        static bool inRanges(const CodePointRange* first, const CodePointRange* last, uint32_t codePoint);
+
+    public:
+        static size_t asciiPrefix(const char* text, size_t length);
+        static size_t decode(const char* text, const char* end, uint32_t &codePoint);
+        static bool isValid(const char* text, size_t length);
+        static bool isIdentifierStart(uint32_t codePoint);
+        static bool isIdentifierContinue(uint32_t codePoint);
+};
+
+inline bool Utf8::inRanges(const CodePointRange* first, const CodePointRange* last, const uint32_t codePoint) {
+    const CodePointRange* range = std::upper_bound(first, last, codePoint,
+        [](const uint32_t value, const CodePointRange &candidate) { return value < candidate.first; });
+    return range != first && codePoint <= (range - 1)->last;
+}
+
+/**
+ * @brief Cantidad de bytes ASCII (< 0x80) al comienzo de @c text.
+ * * Comprueba bloques completos con una sola instrucción de máscara de bits altos y solo
+ * recorre byte a byte el bloque donde aparece el primer byte no ASCII.
+ */
+inline size_t Utf8::asciiPrefix(const char* text, const size_t length) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= length; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        if (_mm256_movemask_epi8(block) != 0) break;
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        if (_mm_movemask_epi8(block) != 0) break;
+    }
+#else
+    for (; i + 8 <= length; i += 8) {
+        uint64_t block;
+        std::memcpy(&block, text + i, sizeof(block));
+        if ((block & 0x8080808080808080ULL) != 0) break;
+    }
+#endif
+    while (i < length && static_cast<unsigned char>(text[i]) < 0x80) i++;
+    return i;
+}
+
+/**
+ * @brief Decodifica el carácter que empieza en @c text.
+ * @param end Fin del texto disponible.
+ * @param[out] codePoint Punto de código decodificado.
+ * @return Bytes que ocupa el carácter (1 a 4); 0 si la secuencia no es UTF-8 válido.
+ */
+inline size_t Utf8::decode(const char* text, const char* end, uint32_t &codePoint) {
+    const auto byte = [&](const size_t k) { return static_cast<unsigned char>(text[k]); };
+    const size_t available = static_cast<size_t>(end - text);
+    if (available == 0) return 0;
+    const unsigned char lead = byte(0);
+    if (lead < 0x80) {
+        codePoint = lead;
+        return 1;
+    }
+    size_t size = 0;
+    uint32_t minimum = 0;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        size = 2;
+        minimum = 0x80;
+        codePoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        size = 3;
+        minimum = 0x800;
+        codePoint = lead & 0x0F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        size = 4;
+        minimum = 0x10000;
+        codePoint = lead & 0x07;
+    } else {
+        return 0;
+    }
+    if (available < size) return 0;
+    for (size_t k = 1; k < size; k++) {
+        if ((byte(k) & 0xC0) != 0x80) return 0;
+        codePoint = (codePoint << 6) | (byte(k) & 0x3F);
+    }
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return 0;
+    return size;
+}
+
+/**
+ * @brief Comprueba que @c text sea UTF-8 válido.
+ */
+inline bool Utf8::isValid(const char* text, const size_t length) {
+    size_t i = 0;
+    while (true) {
+        i += asciiPrefix(text + i, length - i);
+        if (i == length) return true;
+        uint32_t codePoint = 0;
+        const size_t size = decode(text + i, text + length, codePoint);
+        if (size == 0) return false;
+        i += size;
+    }
+}
+
+/**
+ * @brief Puede iniciar un identificador: letra ASCII, '_' o XID_Start.
+ */
+inline bool Utf8::isIdentifierStart(const uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        return (codePoint >= 'a' && codePoint <= 'z') || (codePoint >= 'A' && codePoint <= 'Z') || codePoint == '_';
+    }
+    return inRanges(std::begin(XID_START_RANGES), std::end(XID_START_RANGES), codePoint);
+}
+
+/**
+ * @brief Puede continuar un identificador: letra o dígito ASCII, '_' o XID_Continue.
+ */
+inline bool Utf8::isIdentifierContinue(const uint32_t codePoint) {
+    if (codePoint < 0x80) return isIdentifierStart(codePoint) || (codePoint >= '0' && codePoint <= '9');
+    return inRanges(std::begin(XID_CONTINUE_RANGES), std::end(XID_CONTINUE_RANGES), codePoint);
+}
+
+#endif
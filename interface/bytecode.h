@@ -0,0 +1,110 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../interface/program_struct.h"
+
+/**
+ * @brief Código de operación de BytecodeVm; el sufijo indica el tipo de los operandos.
+ */
+enum class VmOp : uint8_t {
+    MOVE,
+    MOVE_STRING,
+    TO_DOUBLE,
+    TO_INT,
+    ADD_INT,
+    SUB_INT,
+    MUL_INT,
+    DIV_INT,
+    MOD_INT,
+    NEG_INT,
+    NOT_INT,
+    EQ_INT,
+    NE_INT,
+    LT_INT,
+    GT_INT,
+    LE_INT,
+    GE_INT,
+    ADD_DOUBLE,
+    SUB_DOUBLE,
+    MUL_DOUBLE,
+    DIV_DOUBLE,
+    MOD_DOUBLE,
+    POW_DOUBLE,
+    NEG_DOUBLE,
+    NOT_DOUBLE,
+    EQ_DOUBLE,
+    NE_DOUBLE,
+    LT_DOUBLE,
+    GT_DOUBLE,
+    LE_DOUBLE,
+    GE_DOUBLE,
+    CONCAT,
+    EQ_STRING,
+    NE_STRING,
+    CALL,
+    ARRAY_NEW,
+    ARRAY_LOAD,
+    ARRAY_LOAD_STRING,
+    ARRAY_STORE,
+    ARRAY_STORE_STRING,
+    JUMP,
+    JUMP_IF_FALSE,
+    JUMP_IF_TRUE,
+    JUMP_IF_FALSE_DOUBLE,
+    JUMP_IF_TRUE_DOUBLE,
+    JUMP_IF_EQ_INT,
+    JUMP_IF_NE_INT,
+    JUMP_IF_LT_INT,
+    JUMP_IF_GT_INT,
+    JUMP_IF_LE_INT,
+    JUMP_IF_GE_INT,
+    RETURN,
+    RETURN_VALUE
+};
+
+/**
+ * @brief Instrucción de tres direcciones sobre ranuras del marco.
+ * @note @c target es la ranura destino; en los saltos, el índice de la instrucción siguiente.
+ * @c left y @c right son ranuras de operandos. En ARRAY_* @c left (o @c target en ARRAY_NEW y
+ * ARRAY_STORE) es el arreglo en BytecodeProgram::arrays. @c function es la función de CALL.
+ */
+struct VmInstruction {
+    VmOp op;
+    uint16_t function;
+    uint32_t target;
+    uint32_t left;
+    uint32_t right;
+};
+
+/**
+ * @brief Valor de una ranura con su tipo en 16 bytes.
+ * @note Una cadena guarda en @c integer la ranura cuyo texto la contiene y una variable de
+ * arreglo, el arreglo. `float` y `double` comparten DOUBLE, como en ProgramStruct.
+ */
+struct Value {
+    union {
+        int64_t integer = 0;
+        double real;
+    };
+    ValueType type = ValueType::INT;
+};
+
+/**
+ * @brief Programa compilado por BytecodeCompiler.
+ * @note El marco se divide en variables [0, variables.size()), constantes y temporales, en
+ * ese orden; @c frame y @c texts son su contenido inicial. El texto de la ranura i es texts[i].
+ * @c arrays guarda, por cada arreglo, la variable que lo declara.
+ */
+struct BytecodeProgram {
+    std::vector<VmInstruction> code;
+    std::vector<Value> frame;
+    std::vector<std::string> texts;
+    std::vector<VariableInfo> variables;
+    std::vector<int32_t> arrays;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef COMPILED_EXPRESSION_H
+#define COMPILED_EXPRESSION_H
+
+#include <string>
+#include <vector>
+
+enum class OpCode {
+    PUSH,
+    LOAD,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    POW,
+    NEG,
+    NOT,
+    TO_BOOL,
+    EQ,
+    NE,
+    LT,
+    GT,
+    LE,
+    GE,
+    INDEX,
+    PRE_INC,
+    PRE_DEC,
+    POST_INC,
+    POST_DEC,
+    CALL,
+    JUMP,
+    JUMP_IF_FALSE,
+    JUMP_IF_FALSE_OR_POP,
+    JUMP_IF_TRUE_OR_POP
+};
+
+/**
+ * @brief Instrucción de la máquina de pila.
+ * @note PUSH usa @c operand como valor; LOAD, como índice en CompiledExpression::names; CALL,
+ * como índice en BuiltinFunctions; los saltos, como número de instrucciones que se omiten.
+ */
+struct Instruction {
+    OpCode op;
+    double operand;
+};
+
+/**
+ * @brief Programa postfijo compilado a partir de una expresión.
+ * @note Si @c constant es verdadero, @c result ya contiene el valor final de la expresión.
+ */
+struct CompiledExpression {
+    std::vector<Instruction> code;
+    std::vector<std::string> names;
+    bool constant = false;
+    double result = 0.0;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef IR_STRUCT_H
+#define IR_STRUCT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../interface/program_struct.h"
+
+enum class IrOp : uint8_t {
+    CONST,
+    STRING,
+    PHI,
+    CONVERT,
+    UNARY,
+    BINARY,
+    CALL,
+    ARRAY_NEW,
+    ARRAY_LOAD,
+    ARRAY_STORE,
+    EXPORT,
+    JUMP,
+    BRANCH,
+    RETURN
+};
+
+/**
+ * @brief Instrucción de tres direcciones en forma SSA; su índice en IrFunction::instructions es su valor.
+ * @note Los operandos ocupan [@c first, @c first + @c count) de IrFunction::operands. @c code es
+ * el operador de UNARY y BINARY; @c symbol, la función de CALL, la cadena de STRING o la
+ * variable de EXPORT; @c constant, el valor de CONST. Los operandos de PHI siguen el orden
+ * de IrBlock::predecessors.
+ */
+struct IrInstruction {
+    IrOp op;
+    ValueType type;
+    OpCode code;
+    uint32_t block;
+    uint32_t first;
+    uint32_t count;
+    int32_t symbol;
+    NumberValue constant;
+};
+
+/**
+ * @brief Bloque básico: φ al inicio y un terminador (JUMP, BRANCH o RETURN) al final de @c code.
+ * @note BRANCH salta a successors[0] si su operando es distinto de cero y a successors[1] si no.
+ * Un bloque eliminado queda con @c code vacío.
+ */
+struct IrBlock {
+    std::vector<uint32_t> phis;
+    std::vector<uint32_t> code;
+    std::vector<uint32_t> predecessors;
+    std::vector<uint32_t> successors;
+};
+
+/**
+ * @brief Programa en representación intermedia SSA almacenado en arreglos contiguos.
+ * @note El bloque 0 es la entrada. Las instrucciones eliminadas siguen en @c instructions, pero
+ * ya no aparecen en ningún bloque.
+ */
+struct IrFunction {
+    std::vector<IrInstruction> instructions;
+    std::vector<uint32_t> operands;
+    std::vector<IrBlock> blocks;
+    std::vector<std::string> strings;
+    std::vector<VariableInfo> variables;
+
+    size_t instructionCount() const {
+        size_t count = 0;
+        for (const IrBlock &block : blocks) count += block.phis.size() + block.code.size();
+        return count;
+    }
+};
+
+#endif
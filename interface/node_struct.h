@@ -1,15 +1,26 @@
 #ifndef NODE_STRUCT_H
 #define NODE_STRUCT_H
+#include <cstdint>
 #include <string>
 
 #include "../interface/type_token.h"
+#include "../interface/number_value.h"
 
+/**
+ * @brief Token del código fuente.
+ * @note La posición se guarda como desplazamiento en bytes y longitud; la línea y la columna
+ * se obtienen con SourceMap::locate(). La longitud se satura en MAX_LENGTH; un desplazamiento
+ * mayor que MAX_OFFSET (fuentes de más de 4 GiB) no se puede representar y el analizador léxico lo rechaza.
+ */
 struct NodeStruct {
+    static const uint32_t MAX_LENGTH = 0xFFFFFF;
+    static const uint32_t MAX_OFFSET = 0xFFFFFFFF;
+
     std::string name;
-    TokenType type;
-    std::string value;
-    int line;
-    int word;
+    NumberValue value;
+    uint32_t offset;
+    uint32_t length : 24;
+    TokenType type : 8;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,27 @@
+#ifndef NUMBER_VALUE_H
+#define NUMBER_VALUE_H
+
+#include <cstdint>
+
+enum class NumberKind {
+    NONE,
+    INTEGER,
+    FLOAT
+};
+
+/**
+ * @brief Valor numérico tipado de un literal, calculado una sola vez durante el análisis léxico.
+ */
+struct NumberValue {
+    NumberKind kind = NumberKind::NONE;
+    union {
+        int64_t integer = 0;
+        double real;
+    };
+
+    double asDouble() const {
+        return kind == NumberKind::INTEGER ? static_cast<double>(integer) : real;
+    }
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef PROGRAM_STRUCT_H
+#define PROGRAM_STRUCT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../interface/number_value.h"
+#include "../interface/compiled_expression.h"
+
+/**
+ * @brief Tipo estático de una variable o expresión; `float` y `double` comparten DOUBLE.
+ */
+enum class ValueType : uint8_t {
+    INT,
+    DOUBLE,
+    STRING
+};
+
+enum class ExpressionKind : uint8_t {
+    NUMBER,
+    STRING,
+    VARIABLE,
+    INDEX,
+    UNARY,
+    BINARY,
+    AND,
+    OR,
+    CONDITIONAL,
+    CALL,
+    STEP
+};
+
+/**
+ * @brief Nodo de expresión del árbol sintáctico.
+ * @note @c symbol es la variable en VARIABLE e INDEX, la función de BuiltinFunctions en CALL y
+ * el índice en ProgramStruct::strings en STRING. Los hijos son índices en
+ * ProgramStruct::expressions; -1 si no existen. STEP aplica @c op (++ o --, prefijo o sufijo)
+ * a su hijo @c left, que es VARIABLE o INDEX.
+ */
+struct ExpressionNode {
+    ExpressionKind kind;
+    OpCode op;
+    ValueType type;
+    int32_t symbol;
+    int32_t left;
+    int32_t right;
+    int32_t extra;
+    NumberValue number;
+    uint32_t offset;
+};
+
+enum class StatementKind : uint8_t {
+    DECLARE,
+    ASSIGN,
+    EXPRESSION,
+    BLOCK,
+    IF,
+    WHILE,
+    FOR,
+    BREAK,
+    CONTINUE,
+    RETURN
+};
+
+/**
+ * @brief Nodo de sentencia del árbol sintáctico.
+ * @note Los campos que no usa una sentencia valen -1.
+ * DECLARE: @c target, @c index (tamaño si es arreglo), @c value (inicializador) y la lista
+ * `{...}` en [@c first, @c first + @c count) de ProgramStruct::items.
+ * ASSIGN: @c target, @c index (si es un elemento) y @c value.
+ * EXPRESSION y RETURN: @c value. BLOCK: sentencias en [@c first, @c first + @c count).
+ * IF: @c value, @c body y @c otherwise. WHILE: @c value y @c body.
+ * FOR: @c init, @c value (condición opcional), @c step y @c body.
+ */
+struct StatementNode {
+    StatementKind kind;
+    int32_t target;
+    int32_t index;
+    int32_t value;
+    int32_t body;
+    int32_t otherwise;
+    int32_t init;
+    int32_t step;
+    int32_t first;
+    int32_t count;
+    uint32_t offset;
+};
+
+/**
+ * @brief Variable declarada; su índice en ProgramStruct::variables es su ranura.
+ * @note @c global indica que se declaró en el bloque más externo del programa (o de main),
+ * por lo que su valor final es observable. @c offset es el desplazamiento del nombre en la
+ * declaración.
+ */
+struct VariableInfo {
+    std::string name;
+    ValueType type;
+    bool array;
+    bool global;
+    uint32_t offset;
+};
+
+/**
+ * @brief Programa analizado: árbol sintáctico almacenado en arreglos contiguos.
+ * @note @c root es el BLOCK con las sentencias de nivel superior.
+ */
+struct ProgramStruct {
+    std::vector<ExpressionNode> expressions;
+    std::vector<StatementNode> statements;
+    std::vector<int32_t> items;
+    std::vector<VariableInfo> variables;
+    std::vector<std::string> strings;
+    int32_t root = -1;
+};
+
+#endif
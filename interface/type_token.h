@@ -1,7 +1,9 @@
 #ifndef TYPE_TOKEN_H
 #define TYPE_TOKEN_H
 
-enum class TokenType {
+#include <cstdint>
+
+enum class TokenType : uint8_t {
     KEYWORD,
     IDENTIFIER,
     OPERATOR,
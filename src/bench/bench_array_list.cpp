@@ -0,0 +1,133 @@
+#include <chrono>
+#include <vector>
+#include "benchmark.h"
+#include "array_list/array_list.h"
+#include "../../interface/node_struct.h"
+
+static void BM_ArrayListAddLast(BenchmarkState &state) {
+    while (state.keepRunning()) {
+        ArrayList<int> list;
+        for (long long i = 0; i < state.range(); i++) list.addLast(static_cast<int>(i));
+        doNotOptimize(list.getSize());
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListAddLast, 1000, 100000);
+
+static void BM_ArrayListCursorIterate(BenchmarkState &state) {
+    ArrayList<int> list;
+    for (long long i = 0; i < state.range(); i++) list.addLast(static_cast<int>(i));
+    while (state.keepRunning()) {
+        long long sum = 0;
+        list.currentReset();
+        do {
+            sum += list.get()->getData();
+        } while (list.currentNext());
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListCursorIterate, 1000, 100000);
+
+static void BM_ArrayListIndexedGet(BenchmarkState &state) {
+    ArrayList<int> list;
+    for (long long i = 0; i < state.range(); i++) list.addLast(static_cast<int>(i));
+    while (state.keepRunning()) {
+        long long sum = 0;
+        for (int i = 1; i <= list.getSize(); i++) sum += list.get(i)->getData();
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListIndexedGet, 100, 1000);
+
+static void BM_ArrayListHas(BenchmarkState &state) {
+    ArrayList<std::string> list;
+    for (long long i = 0; i < state.range(); i++) list.addLast("token" + std::to_string(i));
+    const std::string missing = "missing";
+    while (state.keepRunning()) {
+        doNotOptimize(list.has(missing));
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListHas, 1000);
+
+static void BM_ArrayListCopy(BenchmarkState &state) {
+    ArrayList<int> list;
+    for (long long i = 0; i < state.range(); i++) list.addLast(static_cast<int>(i));
+    while (state.keepRunning()) {
+        ArrayList<int> copy = list;
+        doNotOptimize(copy.getSize());
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListCopy, 10000);
+
+static const int MERGE_CHUNKS = 1000;
+static const int MERGE_CHUNK_TOKENS = 10000;
+
+/**
+ * Une 1000 listas de 10K tokens, como las que entrega cada lote de la cadena léxica.
+ * range 0: copia cada token con addLast; range 1: encadena cada lista con splice().
+ * El contador merge_ms mide solo la unión; el tiempo total incluye construir y liberar las listas.
+ */
+static void BM_ArrayListMergeChunks(BenchmarkState &state) {
+    const bool splice = state.range() != 0;
+    double mergeMs = 0;
+    while (state.keepRunning()) {
+        std::vector<ArrayList<NodeStruct>> chunks(MERGE_CHUNKS);
+        uint32_t offset = 0;
+        for (ArrayList<NodeStruct> &chunk : chunks) {
+            for (int i = 0; i < MERGE_CHUNK_TOKENS; i++, offset += 2) {
+                NodeStruct token{"x", NumberValue{}, offset, 1, TokenType::IDENTIFIER};
+                chunk.addLast(std::move(token));
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        ArrayList<NodeStruct> merged;
+        for (ArrayList<NodeStruct> &chunk : chunks) {
+            if (splice) {
+                merged.splice(chunk);
+                continue;
+            }
+            for (Node<NodeStruct>* node = chunk.getFirst(); node != nullptr; node = node->getNextNode()) {
+                merged.addLast(node->getDataRef());
+            }
+        }
+        mergeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        doNotOptimize(merged.getSize());
+    }
+    state.setCounter("merge_ms", mergeMs / static_cast<double>(state.iterations()));
+    state.setItemsProcessed(static_cast<long long>(MERGE_CHUNKS) * MERGE_CHUNK_TOKENS * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListMergeChunks, 0, 1);
+
+static void BM_ArrayListSort(BenchmarkState &state) {
+    std::vector<int> values(static_cast<size_t>(state.range()));
+    unsigned int seed = 12345;
+    for (int &value : values) value = static_cast<int>((seed = seed * 1103515245u + 12345u) >> 8);
+    ArrayList<int> list;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        list.clear();
+        list.appendRange(values.begin(), values.end());
+        state.resumeTiming();
+        list.sort();
+        doNotOptimize(list.getFirst());
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListSort, 1000, 100000);
+
+static void BM_ArrayListRemoveLast(BenchmarkState &state) {
+    ArrayList<int> list;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        for (long long i = 0; i < state.range(); i++) list.addLast(static_cast<int>(i));
+        state.resumeTiming();
+        while (!list.isEmpty()) delete list.removeLast();
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_ArrayListRemoveLast, 1000, 10000);
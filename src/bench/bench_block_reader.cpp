@@ -0,0 +1,112 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "lexical_analyzer/lexical_analyzer.h"
+
+/*
+ * Lectura por líneas (ifstream + getline) frente a BlockReader. El argumento indica la
+ * caché de páginas: 0 = en caliente, 1 = en frío (se descarta con posix_fadvise antes de
+ * cada iteración). El tamaño del archivo se fija con MINI_COMPILER_BENCH_READ_MB
+ * (128 por defecto); para medir entradas de varios GB basta con aumentarlo.
+ */
+
+/**
+ * @brief Archivo grande formado por repeticiones de un bloque de código generado.
+ */
+static std::string largeInputFile() {
+    static std::string path;
+    if (!path.empty()) return path;
+    const char* env = std::getenv("MINI_COMPILER_BENCH_READ_MB");
+    const long long megabytes = env != nullptr && std::atoll(env) > 0 ? std::atoll(env) : 128;
+    path = "bench_workload_read" + std::to_string(megabytes) + "mb.txt";
+    if (benchFileSize(path) >= megabytes * 1024 * 1024) return path;
+
+    WorkloadConfig config;
+    config.targetBytes = 1024 * 1024;
+    const std::string chunk = WorkloadGenerator(config).source();
+    std::ofstream out(path, std::ios::binary);
+    for (long long written = 0; written < megabytes * 1024 * 1024; written += static_cast<long long>(chunk.size())) {
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    }
+    return path;
+}
+
+static void BM_ReadGetline(BenchmarkState &state) {
+    const std::string path = largeInputFile();
+    long long lines = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        if (state.range() == 1) BlockReader::dropCache(path);
+        std::ifstream code(path);
+        state.resumeTiming();
+
+        std::string line;
+        while (std::getline(code, line)) ++lines;
+    }
+    doNotOptimize(lines);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+BENCHMARK_ARGS(BM_ReadGetline, 0, 1);
+
+static void runBlockRead(BenchmarkState &state, const ReadBackend backend) {
+    const std::string path = largeInputFile();
+    long long lines = 0;
+    ReadBackend used = backend;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        if (state.range() == 1) BlockReader::dropCache(path);
+        state.resumeTiming();
+
+        BlockReader reader(path, 1 << 20, backend);
+        used = reader.getBackend();
+        const char* data = nullptr;
+        size_t length = 0;
+        while (reader.next(data, length)) {
+            const char* end = data + length;
+            while ((data = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data))))) {
+                ++lines;
+                ++data;
+            }
+        }
+    }
+    doNotOptimize(lines);
+    state.setCounter("io_uring", used == ReadBackend::IO_URING ? 1 : 0);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+
+static void BM_ReadBlocksPread(BenchmarkState &state) {
+    runBlockRead(state, ReadBackend::PREAD);
+}
+BENCHMARK_ARGS(BM_ReadBlocksPread, 0, 1);
+
+static void BM_ReadBlocksUring(BenchmarkState &state) {
+    runBlockRead(state, ReadBackend::IO_URING);
+}
+BENCHMARK_ARGS(BM_ReadBlocksUring, 0, 1);
+
+/**
+ * @brief Análisis léxico completo por líneas (0) o por bloques (1) sobre 16 MiB.
+ */
+static void BM_TokenizeReadPath(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.targetBytes = 16 * 1024 * 1024;
+    const std::string path = benchWorkloadFile("read16mb", config);
+    std::ifstream configFile(benchConfigPath());
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    long long tokens = 0;
+    while (state.keepRunning()) {
+        if (state.range() == 0) {
+            std::ifstream code(path);
+            tokens += lexer.tokenize(code).getSize();
+        } else {
+            BlockReader reader(path);
+            tokens += lexer.tokenize(reader).getSize();
+        }
+    }
+    state.setItemsProcessed(tokens);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+BENCHMARK_ARGS(BM_TokenizeReadPath, 0, 1);
@@ -0,0 +1,62 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include "workload_generator.h"
+
+#ifndef MINI_COMPILER_CONFIG_PATH
+#define MINI_COMPILER_CONFIG_PATH "config/lexical_config.csv"
+#endif
+
+/**
+ * @brief Ruta del archivo de configuración léxica usado por los benchmarks.
+ * CMake la fija en MINI_COMPILER_CONFIG_PATH para no depender del directorio de trabajo.
+ */
+inline std::string benchConfigPath() {
+    return MINI_COMPILER_CONFIG_PATH;
+}
+
+/**
+ * @brief Genera (una sola vez por nombre) un archivo de código sintético en el directorio actual.
+ * @param name Identificador de la carga; se usa para el nombre del archivo.
+ * @param config Parámetros del generador.
+ * @return Ruta del archivo generado.
+ */
+inline std::string benchWorkloadFile(const std::string &name, const WorkloadConfig &config) {
+    static std::map<std::string, std::string> generated;
+    auto found = generated.find(name);
+    if (found != generated.end()) return found->second;
+
+    const std::string path = "bench_workload_" + name + ".txt";
+    WorkloadGenerator generator(config);
+    generator.writeFile(path);
+    generated[name] = path;
+    return path;
+}
+
+/**
+ * @brief Como benchWorkloadFile(), pero con un programa completo de WorkloadGenerator::program().
+ */
+inline std::string benchProgramFile(const std::string &name, const WorkloadConfig &config) {
+    static std::map<std::string, std::string> generated;
+    auto found = generated.find(name);
+    if (found != generated.end()) return found->second;
+
+    const std::string path = "bench_program_" + name + ".txt";
+    WorkloadGenerator generator(config);
+    std::ofstream(path, std::ios::binary) << generator.program();
+    generated[name] = path;
+    return path;
+}
+
+/**
+ * @brief Tamaño en bytes de un archivo.
+ */
+inline long long benchFileSize(const std::string &path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<long long>(file.tellg()) : 0;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#include <fstream>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "test/concurrent_compile.h"
+
+/*
+ * Escalabilidad de la prueba de estrés de src/test/concurrent_compile.h con 1 a 8 hilos;
+ * test_concurrency la ejecuta como prueba de ctest.
+ */
+
+static const int COMPILATIONS = 2000;
+
+static void BM_ConcurrentCompile(BenchmarkState &state) {
+    std::ifstream configFile(benchConfigPath());
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    const ConcurrentSources sources = concurrentSources(lexer);
+    ExpressionCache cache(64);
+    long long mismatches = 0;
+    const int threads = static_cast<int>(state.range());
+
+    while (state.keepRunning()) {
+        mismatches += concurrentCompile(lexer, cache, sources, threads, COMPILATIONS);
+    }
+    state.setCounter("mismatches", static_cast<double>(mismatches));
+    state.setCounter("threads", threads);
+    state.setItemsProcessed(static_cast<long long>(COMPILATIONS) * state.iterations());
+}
+BENCHMARK_ARGS(BM_ConcurrentCompile, 1, 2, 4, 8);
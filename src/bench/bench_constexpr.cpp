@@ -0,0 +1,98 @@
+#include <fstream>
+#include <string>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "operations_analyzer/operations_analyzer.h"
+#include "constexpr_evaluator/constexpr_evaluator.h"
+
+/*
+ * Evaluación de fórmulas fijas: en tiempo de compilación (ConstexprEvaluator) frente al
+ * camino LexicalAnalyzer + OperationsAnalyzer en tiempo de ejecución.
+ */
+
+// Verificaciones en tiempo de compilación: si alguna falla, el benchmark no compila.
+static_assert(ConstexprEvaluator::evaluate("") == 0.0, "empty expression");
+static_assert(ConstexprEvaluator::evaluate("42") == 42.0, "integer literal");
+static_assert(ConstexprEvaluator::evaluate("5.5 + 20.") == 25.5, "float literals");
+static_assert(ConstexprEvaluator::evaluate("1e3 - 2.5E-1") == 999.75, "exponent literals");
+static_assert(ConstexprEvaluator::evaluate("2 + 3 * 4") == 14.0, "precedence");
+static_assert(ConstexprEvaluator::evaluate("(2 + 3) * 4") == 20.0, "parentheses");
+static_assert(ConstexprEvaluator::evaluate("10 - 4 - 3") == 3.0, "left associativity of -");
+static_assert(ConstexprEvaluator::evaluate("64 / 4 / 2") == 8.0, "left associativity of /");
+static_assert(ConstexprEvaluator::evaluate("7 / 2") == 3.5, "floating point division");
+static_assert(ConstexprEvaluator::evaluate("((1 + 2) * (3 + 4)) / (5 - 2)") == 7.0, "nesting");
+static_assert(ConstexprEvaluator::tokenize("3*(4+5)").size == 7, "token count");
+static_assert(ConstexprEvaluator::tokenize("0.1").items[0].value == 0.1, "exact decimal conversion");
+
+static const char* const FORMULA = "((12.5 + 7) * 3 - 4 / (2 + 6)) * (1.5 + 2.25) / 5";
+
+/**
+ * @brief Evalúa una expresión con el camino en tiempo de ejecución.
+ */
+static double runtimeEvaluate(const LexicalAnalyzer &lexer, const std::string &expression) {
+    ArrayList<NodeStruct> tokens;
+    lexer.tokenizeLine(expression, 0, tokens);
+    return OperationsAnalyzer::evaluate(tokens, nullptr);
+}
+
+static void BM_ConstexprEvaluate(BenchmarkState &state) {
+    double sum = 0;
+    while (state.keepRunning()) {
+        sum += CONSTEXPR_EVALUATE("((12.5 + 7) * 3 - 4 / (2 + 6)) * (1.5 + 2.25) / 5");
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConstexprEvaluate);
+
+/**
+ * @brief La misma función constexpr llamada sobre una cadena conocida solo en ejecución.
+ */
+static void BM_ConstexprEvaluateRuntimeInput(BenchmarkState &state) {
+    const std::string formula = FORMULA;
+    double sum = 0;
+    while (state.keepRunning()) {
+        sum += ConstexprEvaluator::evaluate(formula);
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConstexprEvaluateRuntimeInput);
+
+static void BM_RuntimeEvaluate(BenchmarkState &state) {
+    std::ifstream configFile(benchConfigPath());
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    const std::string formula = FORMULA;
+    const double expected = CONSTEXPR_EVALUATE("((12.5 + 7) * 3 - 4 / (2 + 6)) * (1.5 + 2.25) / 5");
+    double sum = 0;
+    long long mismatches = 0;
+    while (state.keepRunning()) {
+        const double value = runtimeEvaluate(lexer, formula);
+        if (value != expected) ++mismatches;
+        sum += value;
+        doNotOptimize(sum);
+    }
+    state.setCounter("mismatches", static_cast<double>(mismatches));
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RuntimeEvaluate);
+
+/**
+ * @brief Compara ambos caminos sobre expresiones generadas; el contador debe ser 0.
+ */
+static void BM_ConstexprConformance(BenchmarkState &state) {
+    std::ifstream configFile(benchConfigPath());
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    WorkloadGenerator generator{WorkloadConfig()};
+    std::vector<std::string> expressions;
+    for (int i = 0; i < 256; i++) expressions.push_back(generator.expression(1 + i % 6));
+    long long mismatches = 0;
+    while (state.keepRunning()) {
+        for (const std::string &expression : expressions) {
+            if (ConstexprEvaluator::evaluate(expression) != runtimeEvaluate(lexer, expression)) ++mismatches;
+        }
+    }
+    state.setCounter("mismatches", static_cast<double>(mismatches));
+    state.setItemsProcessed(static_cast<long long>(expressions.size()) * state.iterations());
+}
+BENCHMARK(BM_ConstexprConformance);
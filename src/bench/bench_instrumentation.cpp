@@ -0,0 +1,37 @@
+#include "benchmark.h"
+#include "instrumentation/instrumentation.h"
+
+/*
+ * Sin ENABLE_INSTRUMENTATION ambos benchmarks deben coincidir: los macros se expanden a nada.
+ * El objetivo bench_instrumented compila los mismos fuentes con la instrumentación activa.
+ */
+
+static long long workUnit(const long long i) {
+    return (i * 2654435761LL) ^ (i >> 3);
+}
+
+static void BM_LoopBaseline(BenchmarkState &state) {
+    while (state.keepRunning()) {
+        long long sum = 0;
+        for (long long i = 0; i < state.range(); i++) {
+            sum += workUnit(i);
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_LoopBaseline, 1000);
+
+static void BM_LoopInstrumented(BenchmarkState &state) {
+    while (state.keepRunning()) {
+        long long sum = 0;
+        for (long long i = 0; i < state.range(); i++) {
+            INSTRUMENT_SCOPE("loop");
+            INSTRUMENT_COUNT(Counter::TOKENS_PRODUCED, 1);
+            sum += workUnit(i);
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_LoopInstrumented, 1000);
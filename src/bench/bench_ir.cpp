@@ -0,0 +1,64 @@
+#include <fstream>
+#include <string>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "program_parser/program_parser.h"
+#include "ir_builder/ir_builder.h"
+#include "ir_optimizer/ir_optimizer.h"
+
+/*
+ * Construcción SSA y pasadas de IrOptimizer sobre programas generados con
+ * WorkloadGenerator::program(). El argumento es el tamaño del programa en KiB.
+ * Por cada pasada se informan las instrucciones que quedan (<pasada>_after) y su tiempo
+ * medio (<pasada>_us); ir_before es el tamaño de la IR recién construida.
+ */
+
+static ProgramStruct parseProgram(const int kib) {
+    WorkloadConfig config;
+    config.targetBytes = static_cast<size_t>(kib) * 1024;
+    const std::string path = benchProgramFile("ir" + std::to_string(kib), config);
+    std::ifstream configFile(benchConfigPath());
+    LexicalAnalyzer lexer(configFile);
+    std::ifstream code(path, std::ios::binary);
+    const ArrayList<NodeStruct> tokens = lexer.tokenize(code);
+    return ProgramParser::parse(tokens);
+}
+
+static void BM_IrBuild(BenchmarkState &state) {
+    const ProgramStruct program = parseProgram(static_cast<int>(state.range()));
+    size_t instructions = 0;
+    while (state.keepRunning()) {
+        const IrFunction function = IrBuilder::build(program);
+        instructions = function.instructionCount();
+        doNotOptimize(instructions);
+    }
+    state.setCounter("instructions", static_cast<double>(instructions));
+    state.setCounter("statements", static_cast<double>(program.statements.size()));
+    state.setItemsProcessed(static_cast<long long>(instructions) * state.iterations());
+}
+BENCHMARK_ARGS(BM_IrBuild, 64, 512);
+
+static void BM_IrOptimize(BenchmarkState &state) {
+    const ProgramStruct program = parseProgram(static_cast<int>(state.range()));
+    const IrFunction built = IrBuilder::build(program);
+    std::vector<IrPassStats> total;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        IrFunction function = built;
+        state.resumeTiming();
+
+        const std::vector<IrPassStats> stats = IrOptimizer::optimize(function);
+        if (total.empty()) total = stats;
+        else for (size_t i = 0; i < stats.size(); i++) total[i].microseconds += stats[i].microseconds;
+        doNotOptimize(function.instructionCount());
+    }
+    const double iterations = static_cast<double>(state.iterations());
+    state.setCounter("ir_before", static_cast<double>(built.instructionCount()));
+    for (size_t i = 0; i < total.size(); i++) {
+        const std::string name = std::to_string(i + 1) + "_" + total[i].name;
+        state.setCounter(name + "_after", static_cast<double>(total[i].after));
+        state.setCounter(name + "_us", total[i].microseconds / iterations);
+    }
+    state.setItemsProcessed(static_cast<long long>(built.instructionCount()) * state.iterations());
+}
+BENCHMARK_ARGS(BM_IrOptimize, 64, 512);
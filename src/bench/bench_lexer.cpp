@@ -0,0 +1,173 @@
+#include <fstream>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "lexical_analyzer/lexical_analyzer.h"
+
+/**
+ * @brief Tokeniza un archivo generado; el argumento es el tamaño objetivo en KiB.
+ */
+static void runTokenize(BenchmarkState &state, const std::string &name, WorkloadConfig config) {
+    config.targetBytes = static_cast<size_t>(state.range()) * 1024;
+    const std::string path = benchWorkloadFile(name + std::to_string(state.range()), config);
+    long long tokens = 0;
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        std::ifstream configFile(benchConfigPath());
+        LexicalAnalyzer analyzer(configFile);
+        std::ifstream code(path);
+        state.resumeTiming();
+
+        ArrayList<NodeStruct> result = analyzer.tokenize(code);
+        tokens += result.getSize();
+        doNotOptimize(result.getSize());
+    }
+    state.setCounter("tokens", static_cast<double>(tokens) / static_cast<double>(state.iterations()));
+    state.setItemsProcessed(tokens);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+
+static void BM_Tokenize(BenchmarkState &state) {
+    runTokenize(state, "default", WorkloadConfig());
+}
+BENCHMARK_ARGS(BM_Tokenize, 16, 256);
+
+static void BM_TokenizeStringHeavy(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.stringDensity = 0.8;
+    runTokenize(state, "strings", config);
+}
+BENCHMARK_ARGS(BM_TokenizeStringHeavy, 256);
+
+static void BM_TokenizeLongStrings(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.stringDensity = 0.8;
+    config.stringWords = 40;
+    runTokenize(state, "longstrings", config);
+}
+BENCHMARK_ARGS(BM_TokenizeLongStrings, 256);
+
+static void BM_TokenizeCommentHeavy(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.commentRatio = 0.6;
+    runTokenize(state, "comments", config);
+}
+BENCHMARK_ARGS(BM_TokenizeCommentHeavy, 256);
+
+static void BM_TokenizeBlockCommentHeavy(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.commentRatio = 0.3;
+    config.blockCommentRatio = 0.4;
+    runTokenize(state, "blockcomments", config);
+}
+BENCHMARK_ARGS(BM_TokenizeBlockCommentHeavy, 256);
+
+static void BM_TokenizeDeepExpressions(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.expressionDepth = 8;
+    config.identifierLength = 16;
+    runTokenize(state, "deep", config);
+}
+BENCHMARK_ARGS(BM_TokenizeDeepExpressions, 256);
+
+/**
+ * @brief Cadenas y comentarios abundantes con la mitad de sus palabras en UTF-8 (bytes ≥ 0x80).
+ */
+static void BM_TokenizeUtf8Heavy(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.stringDensity = 0.5;
+    config.commentRatio = 0.3;
+    config.utf8Ratio = 0.5;
+    runTokenize(state, "utf8", config);
+}
+BENCHMARK_ARGS(BM_TokenizeUtf8Heavy, 256);
+
+/**
+ * @brief Como BM_TokenizeUtf8Heavy, pero además un 30 % de los identificadores no son ASCII.
+ */
+static void BM_TokenizeUtf8Identifiers(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.stringDensity = 0.5;
+    config.commentRatio = 0.3;
+    config.utf8Ratio = 0.5;
+    config.utf8IdentifierRatio = 0.3;
+    runTokenize(state, "utf8ident", config);
+}
+BENCHMARK_ARGS(BM_TokenizeUtf8Identifiers, 256);
+
+/**
+ * @brief Memoria retenida tras tokenizar, relativa al tamaño de la entrada.
+ * El argumento indica si se activa la liberación temprana (1) o no (0).
+ */
+static void BM_TokenizeMemory(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.targetBytes = 256 * 1024;
+    const std::string path = benchWorkloadFile("default256", config);
+    const double inputBytes = static_cast<double>(benchFileSize(path));
+    double retained = 0;
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        std::ifstream configFile(benchConfigPath());
+        LexicalAnalyzer analyzer(configFile);
+        analyzer.setReleaseSource(state.range() != 0);
+        std::ifstream code(path);
+        state.resumeTiming();
+
+        MemoryFootprint usage;
+        ArrayList<NodeStruct> result = analyzer.tokenize(code, &usage);
+        retained = static_cast<double>(usage.total());
+    }
+    state.setCounter("retained_bytes_per_input_byte", retained / inputBytes);
+    state.setCounter("peak_rss_bytes", static_cast<double>(MemoryUsage::peakRssBytes()));
+}
+BENCHMARK_ARGS(BM_TokenizeMemory, 0, 1);
+
+/**
+ * @brief Costo de construir el índice de líneas durante el análisis: sin índice (0) o con él (1).
+ */
+static void BM_TokenizeSourceMap(BenchmarkState &state) {
+    WorkloadConfig config;
+    config.targetBytes = 256 * 1024;
+    const std::string path = benchWorkloadFile("default256", config);
+    double mapBytes = 0;
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        std::ifstream configFile(benchConfigPath());
+        LexicalAnalyzer analyzer(configFile);
+        std::ifstream code(path);
+        SourceMap sourceMap;
+        state.resumeTiming();
+
+        ArrayList<NodeStruct> result = analyzer.tokenize(code, nullptr, state.range() != 0 ? &sourceMap : nullptr);
+        doNotOptimize(result.getSize());
+        mapBytes = static_cast<double>(sourceMap.getBytes());
+    }
+    state.setCounter("node_struct_bytes", static_cast<double>(sizeof(NodeStruct)));
+    state.setCounter("source_map_bytes", mapBytes);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+BENCHMARK_ARGS(BM_TokenizeSourceMap, 0, 1);
+
+/**
+ * @brief Traducción de desplazamientos a línea y columna sobre un índice de 2^arg líneas.
+ */
+static void BM_SourceMapLocate(BenchmarkState &state) {
+    const size_t lines = static_cast<size_t>(1) << state.range();
+    SourceMap sourceMap;
+    for (size_t i = 0; i < lines; i++) sourceMap.addLine(i * 40);
+
+    size_t offset = 0;
+    long long checksum = 0;
+    while (state.keepRunning()) {
+        for (int i = 0; i < 1024; i++) {
+            offset = (offset + 2654435761u) % (lines * 40);
+            const SourceLocation location = sourceMap.locate(offset);
+            checksum += location.line + location.column;
+        }
+    }
+    doNotOptimize(checksum);
+    state.setItemsProcessed(1024 * state.iterations());
+}
+BENCHMARK_ARGS(BM_SourceMapLocate, 10, 20);
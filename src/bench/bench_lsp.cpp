@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "language_server/language_server.h"
+
+/*
+ * Reproducción de una sesión de edición grabada contra LanguageServer. La sesión abre un
+ * programa de WorkloadGenerator de `range` KiB y escribe sentencias carácter a carácter en una
+ * línea intermedia, con algún retroceso, pidiendo semanticTokens/full cada 4 pulsaciones y una
+ * definición al terminar cada sentencia; los diagnósticos se publican tras cada cambio. Cada
+ * iteración reproduce la sesión completa con un servidor nuevo y cronometra cada mensaje por
+ * separado: change_* son las ediciones (con sus diagnósticos) y request_* las peticiones.
+ * Con MINI_COMPILER_LSP_SESSION se reproduce en su lugar un archivo grabado con
+ * `proyectos --lsp --lsp-record=<archivo>`, un mensaje por línea.
+ */
+
+static std::string message(const char* method, JsonValue params, const int64_t id = -1) {
+    JsonValue body = JsonValue::object();
+    body.set("jsonrpc", "2.0");
+    if (id >= 0) body.set("id", id);
+    body.set("method", method).set("params", std::move(params));
+    return body.dump();
+}
+
+static JsonValue position(const size_t line, const size_t character) {
+    JsonValue value = JsonValue::object();
+    value.set("line", line).set("character", character);
+    return value;
+}
+
+static JsonValue document(const std::string &uri) {
+    JsonValue value = JsonValue::object();
+    value.set("uri", uri);
+    return value;
+}
+
+/**
+ * @brief Escribe (una sola vez por tamaño) la sesión sintética, un mensaje JSON por línea.
+ */
+static std::string sessionFile(const int kilobytes) {
+    const std::string path = "bench_lsp_session_" + std::to_string(kilobytes) + ".jsonl";
+    if (benchFileSize(path) > 0) return path;
+
+    WorkloadConfig config;
+    config.targetBytes = static_cast<size_t>(kilobytes) * 1024;
+    const std::string text = WorkloadGenerator(config).program();
+    const std::string uri = "file:///bench/session.txt";
+    std::vector<std::string> session;
+
+    JsonValue capabilities = JsonValue::object();
+    capabilities.set("general", JsonValue::object().set("positionEncodings", JsonValue::array().push("utf-16")));
+    session.push_back(message("initialize", JsonValue::object().set("capabilities", std::move(capabilities)), 1));
+    session.push_back(message("initialized", JsonValue::object()));
+    JsonValue item = document(uri);
+    item.set("languageId", "proyectos").set("version", 1).set("text", text);
+    session.push_back(message("textDocument/didOpen", JsonValue::object().set("textDocument", std::move(item))));
+
+    size_t line = static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) / 2;
+    int64_t version = 1;
+    int64_t id = 2;
+    int keystrokes = 0;
+    const auto edit = [&](const size_t character, const size_t end, const std::string &insert) {
+        JsonValue range = JsonValue::object();
+        range.set("start", position(line, character)).set("end", position(line, end));
+        JsonValue change = JsonValue::object();
+        change.set("range", std::move(range)).set("text", insert);
+        JsonValue versioned = document(uri);
+        versioned.set("version", ++version);
+        JsonValue params = JsonValue::object();
+        params.set("textDocument", std::move(versioned)).set("contentChanges", JsonValue::array().push(std::move(change)));
+        session.push_back(message("textDocument/didChange", std::move(params)));
+        if (++keystrokes % 4 == 0) {
+            session.push_back(message("textDocument/semanticTokens/full", JsonValue::object().set("textDocument", document(uri)), id++));
+        }
+    };
+
+    for (int statement = 0; statement < 24; statement++) {
+        const std::string typed = "v" + std::to_string(statement % 16) + " = v" + std::to_string((statement + 5) % 16) +
+                                  " + " + std::to_string(statement) + ";";
+        for (size_t column = 0; column < typed.size(); column++) {
+            if ((column + static_cast<size_t>(statement)) % 9 == 4) {
+                edit(column, column, "x");
+                edit(column, column + 1, "");
+            }
+            edit(column, column, std::string(1, typed[column]));
+        }
+        edit(typed.size(), typed.size(), "\n");
+        JsonValue params = JsonValue::object();
+        params.set("textDocument", document(uri)).set("position", position(line, typed.find(" = v") + 4));
+        session.push_back(message("textDocument/definition", std::move(params), id++));
+        ++line;
+    }
+    session.push_back(message("shutdown", JsonValue(), id));
+    session.push_back(message("exit", JsonValue()));
+
+    std::ofstream out(path, std::ios::binary);
+    for (const std::string &body : session) out << body << '\n';
+    return path;
+}
+
+static std::vector<std::string> loadSession(const std::string &path) {
+    std::vector<std::string> session;
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) session.push_back(line);
+    }
+    return session;
+}
+
+static double percentile(std::vector<double> &samples, const double fraction) {
+    if (samples.empty()) return 0.0;
+    const size_t rank = std::min(samples.size() - 1, static_cast<size_t>(fraction * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rank), samples.end());
+    return samples[rank];
+}
+
+static void BM_LspReplay(BenchmarkState &state) {
+    const char* recorded = std::getenv("MINI_COMPILER_LSP_SESSION");
+    const std::vector<std::string> session = loadSession(recorded != nullptr ? recorded : sessionFile(static_cast<int>(state.range())));
+    std::vector<bool> changes;
+    std::vector<bool> requests;
+    for (const std::string &body : session) {
+        changes.push_back(body.find("\"textDocument/didChange\"") != std::string::npos);
+        requests.push_back(body.find("\"id\"") != std::string::npos && body.find("\"method\"") != std::string::npos);
+    }
+    std::ifstream configFile(benchConfigPath());
+    const std::shared_ptr<const TokenProvider> provider = LexicalAnalyzer::loadProvider(configFile);
+
+    std::vector<double> changeUs;
+    std::vector<double> requestUs;
+    std::vector<std::string> out;
+    size_t slow = 0;
+    while (state.keepRunning()) {
+        LanguageServer server(provider);
+        for (size_t i = 0; i < session.size(); i++) {
+            out.clear();
+            const auto start = std::chrono::steady_clock::now();
+            server.handle(session[i], out);
+            const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            if (changes[i]) changeUs.push_back(us);
+            else if (requests[i]) requestUs.push_back(us);
+            doNotOptimize(out);
+        }
+        slow = server.getSlowRequests();
+    }
+    state.setCounter("change_p50_us", percentile(changeUs, 0.50));
+    state.setCounter("change_p99_us", percentile(changeUs, 0.99));
+    state.setCounter("request_p50_us", percentile(requestUs, 0.50));
+    state.setCounter("request_p99_us", percentile(requestUs, 0.99));
+    state.setCounter("slow", static_cast<double>(slow));
+    state.setItemsProcessed(state.iterations() * static_cast<long long>(session.size()));
+}
+BENCHMARK_ARGS(BM_LspReplay, 16, 128);
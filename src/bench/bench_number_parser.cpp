@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "lexical_analyzer/lexical_analyzer.h"
+
+/**
+ * @brief Literales numéricos deterministas: mitad enteros, 3/8 decimales cortos (`12.75`)
+ * y 1/8 flotantes con 17 dígitos significativos que ejercitan la vía lenta.
+ */
+static std::vector<std::string> numericLiterals(const size_t count) {
+    std::vector<std::string> literals;
+    uint64_t state = 7;
+    char buffer[64];
+    for (size_t i = 0; i < count; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        if (i % 2 == 0) {
+            literals.push_back(std::to_string(state >> 40));
+        } else if (i % 8 != 7) {
+            literals.push_back(std::to_string((state >> 44) % 1000) + "." + std::to_string((state >> 20) % 100));
+        } else {
+            double value = static_cast<double>(state >> 11) / static_cast<double>(1ULL << (state & 31));
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+            literals.emplace_back(buffer);
+        }
+    }
+    return literals;
+}
+
+static void BM_ParseNumberFast(BenchmarkState &state) {
+    const std::vector<std::string> literals = numericLiterals(1024);
+    long long mismatches = 0;
+    while (state.keepRunning()) {
+        double sum = 0;
+        for (const std::string &literal : literals) {
+            NumberValue value;
+            NumberParser::parse(literal, value);
+            sum += value.asDouble();
+        }
+        doNotOptimize(sum);
+    }
+    for (const std::string &literal : literals) {
+        NumberValue value;
+        const double expected = std::stod(literal);
+        const double parsed = NumberParser::parse(literal, value) ? value.asDouble() : -1;
+        if (std::memcmp(&expected, &parsed, sizeof(double)) != 0) ++mismatches;
+    }
+    state.setCounter("roundtrip_mismatches", static_cast<double>(mismatches));
+    state.setItemsProcessed(static_cast<long long>(literals.size()) * state.iterations());
+}
+BENCHMARK(BM_ParseNumberFast);
+
+static void BM_ParseNumberStod(BenchmarkState &state) {
+    const std::vector<std::string> literals = numericLiterals(1024);
+    while (state.keepRunning()) {
+        double sum = 0;
+        for (const std::string &literal : literals) sum += std::stod(literal);
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(static_cast<long long>(literals.size()) * state.iterations());
+}
+BENCHMARK(BM_ParseNumberStod);
+
+/**
+ * @brief Tokeniza un archivo compuesto solo por literales numéricos (un literal por token).
+ */
+static void BM_TokenizeLiteralHeavy(BenchmarkState &state) {
+    const std::string path = "bench_workload_literals.txt";
+    {
+        std::ofstream out(path);
+        const std::vector<std::string> literals = numericLiterals(64 * 1024);
+        for (size_t i = 0; i < literals.size(); i++) out << literals[i] << (i % 8 == 7 ? "\n" : " + ");
+    }
+    long long tokens = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        std::ifstream configFile(benchConfigPath());
+        LexicalAnalyzer analyzer(configFile);
+        std::ifstream code(path);
+        state.resumeTiming();
+
+        ArrayList<NodeStruct> result = analyzer.tokenize(code);
+        tokens += result.getSize();
+    }
+    state.setItemsProcessed(tokens);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+BENCHMARK(BM_TokenizeLiteralHeavy);
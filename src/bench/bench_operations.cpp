@@ -0,0 +1,190 @@
+#include <fstream>
+#include <vector>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "operations_analyzer/operations_analyzer.h"
+#include "test/operator_cases.h"
+
+/**
+ * @brief Tokeniza una vez una expresión generada con la profundidad indicada.
+ */
+static ArrayList<NodeStruct> tokenizeExpression(const std::string &name, const std::string &expression,
+                                                SourceMap* sourceMap = nullptr) {
+    const std::string path = "bench_expression_" + name + ".txt";
+    {
+        std::ofstream out(path);
+        out << expression << "\n";
+    }
+    std::ifstream configFile(benchConfigPath());
+    LexicalAnalyzer lexer(configFile);
+    std::ifstream code(path);
+    return lexer.tokenize(code, nullptr, sourceMap);
+}
+
+static ArrayList<NodeStruct> expressionTokens(const int depth) {
+    WorkloadConfig config;
+    config.expressionDepth = depth;
+    WorkloadGenerator generator(config);
+    return tokenizeExpression(std::to_string(depth), generator.expression(depth));
+}
+
+/**
+ * @brief Expresión anidada a derecha `1+(2*(3-(...)))`: la pila crece linealmente con la profundidad.
+ */
+static ArrayList<NodeStruct> nestedExpressionTokens(const int depth) {
+    static const char operators[] = "+*-";
+    std::string expression;
+    for (int i = 0; i < depth; i++) {
+        expression += std::to_string(i % 9 + 1) + operators[i % 3] + "(";
+    }
+    expression += "1" + std::string(static_cast<size_t>(depth), ')');
+    return tokenizeExpression("nested" + std::to_string(depth), expression);
+}
+
+static void BM_OperationsEvaluate(BenchmarkState &state) {
+    ArrayList<NodeStruct> tokens = expressionTokens(static_cast<int>(state.range()));
+    while (state.keepRunning()) {
+        OperationsAnalyzer analyzer(tokens);
+        doNotOptimize(analyzer.evaluate());
+    }
+    state.setItemsProcessed(tokens.getSize() * state.iterations());
+}
+BENCHMARK_ARGS(BM_OperationsEvaluate, 1, 4, 8);
+
+static void BM_OperationsEvaluateNested(BenchmarkState &state) {
+    ArrayList<NodeStruct> tokens = nestedExpressionTokens(static_cast<int>(state.range()));
+    while (state.keepRunning()) {
+        OperationsAnalyzer analyzer(tokens);
+        doNotOptimize(analyzer.evaluate());
+    }
+    state.setItemsProcessed(tokens.getSize() * state.iterations());
+}
+BENCHMARK_ARGS(BM_OperationsEvaluateNested, 16, 256);
+
+/**
+ * @brief Carga con 90% de repetición: 1000 evaluaciones, 900 sobre 20 fórmulas frecuentes y
+ * 100 sobre fórmulas únicas. El argumento activa (1) o no (0) la caché de expresiones.
+ */
+static void BM_OperationsRepeatedWorkload(BenchmarkState &state) {
+    WorkloadConfig config;
+    WorkloadGenerator generator(config);
+    std::vector<std::string> hot;
+    for (int i = 0; i < 20; i++) hot.push_back(generator.expression(4));
+
+    std::string source;
+    for (int i = 0; i < 1000; i++) {
+        source += (i % 10 == 0 ? generator.expression(4) : hot[static_cast<size_t>(i * 7) % hot.size()]) + "\n";
+    }
+    SourceMap sourceMap;
+    ArrayList<NodeStruct> all = tokenizeExpression("repeated", source, &sourceMap);
+
+    std::vector<ArrayList<NodeStruct>> expressions(1000);
+    for (Node<NodeStruct>* node = all.getFirst(); node != nullptr; node = node->getNextNode()) {
+        const int line = sourceMap.locate(node->getDataRef().offset).line;
+        expressions[static_cast<size_t>(line - 1)].addLast(node->getDataRef());
+    }
+    std::vector<OperationsAnalyzer> analyzers;
+    for (const ArrayList<NodeStruct> &tokens : expressions) analyzers.emplace_back(tokens);
+
+    ExpressionCache cache(256);
+    for (OperationsAnalyzer &analyzer : analyzers) analyzer.setCache(state.range() != 0 ? &cache : nullptr);
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        cache.clear();
+        state.resumeTiming();
+        double sum = 0;
+        for (OperationsAnalyzer &analyzer : analyzers) sum += analyzer.evaluate();
+        doNotOptimize(sum);
+    }
+    state.setCounter("hit_rate", cache.stats().hitRate());
+    state.setItemsProcessed(static_cast<long long>(analyzers.size()) * state.iterations());
+}
+BENCHMARK_ARGS(BM_OperationsRepeatedWorkload, 0, 1);
+
+/**
+ * @brief Tokeniza cada expresión por separado con un mismo analizador léxico.
+ */
+static std::vector<ArrayList<NodeStruct>> tokenizeEach(const std::vector<std::string> &expressions) {
+    std::ifstream configFile(benchConfigPath());
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    std::vector<ArrayList<NodeStruct>> result(expressions.size());
+    for (size_t i = 0; i < expressions.size(); i++) lexer.tokenizeLine(expressions[i], 0, result[i]);
+    return result;
+}
+
+/**
+ * @brief Costo de los casos de conformidad de src/test/operator_cases.h, con y sin caché de
+ * expresiones; el contador debe ser 0. test_operators los comprueba como prueba de ctest.
+ */
+static void BM_OperatorsConformance(BenchmarkState &state) {
+    const std::vector<ArrayList<NodeStruct>> tokens = tokenizeEach(operatorExpressions());
+    ExpressionCache cache(256);
+    long long mismatches = 0;
+
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < tokens.size(); i++) {
+            if (!checkOperatorCase(i, tokens[i], nullptr)) ++mismatches;
+            if (!checkOperatorCase(i, tokens[i], &cache)) ++mismatches;
+        }
+    }
+    state.setCounter("cases", static_cast<double>(tokens.size()));
+    state.setCounter("mismatches", static_cast<double>(mismatches));
+    state.setItemsProcessed(static_cast<long long>(tokens.size()) * 2 * state.iterations());
+}
+BENCHMARK(BM_OperatorsConformance);
+
+/**
+ * @brief Rendimiento sobre 256 expresiones con operadores mixtos: interpretadas desde los
+ * tokens (0) o compiladas una vez y ejecutadas desde la caché (1).
+ */
+static void BM_OperationsEvaluateMixed(BenchmarkState &state) {
+    WorkloadGenerator generator{WorkloadConfig()};
+    std::vector<std::string> expressions;
+    for (int i = 0; i < 256; i++) expressions.push_back(generator.mixedExpression(1 + i % 4));
+    const std::vector<ArrayList<NodeStruct>> tokens = tokenizeEach(expressions);
+    long long count = 0;
+    for (const ArrayList<NodeStruct> &expression : tokens) count += expression.getSize();
+
+    ExpressionCache cache(512);
+    ExpressionCache* expressionCache = state.range() != 0 ? &cache : nullptr;
+    while (state.keepRunning()) {
+        double sum = 0;
+        for (const ArrayList<NodeStruct> &expression : tokens) sum += OperationsAnalyzer::evaluate(expression, expressionCache);
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(count * state.iterations());
+}
+BENCHMARK_ARGS(BM_OperationsEvaluateMixed, 0, 1);
+
+/**
+ * @brief Rama costosa: 64 llamadas anidadas que dependen de x, para que no se pliegue como constante.
+ */
+static std::string costlyBranch() {
+    std::string expression = "x";
+    for (int i = 0; i < 32; i++) expression = "sqrt(abs(sin(" + expression + ") * " + std::to_string(i + 2) + "))";
+    return "(" + expression + ")";
+}
+
+/**
+ * @brief Expresiones en las que el operando costoso se omite: `&&` (0), `||` (1), `?:` (2);
+ * en (3) el `&&` sí lo evalúa y sirve de referencia, pues equivale a evaluar ambos operandos.
+ * Se mide solo la ejecución del programa compilado, con x = 1.
+ */
+static void BM_OperationsShortCircuit(BenchmarkState &state) {
+    static const char* const prefixes[] = {"x < 0 && ", "x > 0 || ", "x > 0 ? x : ", "x > 0 && "};
+    const std::vector<ArrayList<NodeStruct>> tokens =
+        tokenizeEach({prefixes[state.range()] + costlyBranch()});
+    SymbolTable symbols;
+    symbols.set("x", 1);
+    ExpressionCache cache(16);
+    OperationsAnalyzer::evaluate(tokens[0], &cache, &symbols);
+    const std::shared_ptr<const CompiledExpression> program = cache.find(tokens[0]);
+
+    while (state.keepRunning()) {
+        doNotOptimize(OperationsAnalyzer::execute(*program, &symbols));
+    }
+    state.setCounter("instructions", static_cast<double>(program->code.size()));
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK_ARGS(BM_OperationsShortCircuit, 0, 1, 2, 3);
@@ -0,0 +1,50 @@
+#include <fstream>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "pipeline/pipeline.h"
+
+/*
+ * Cadena secuencial (tokenizar todo y después evaluar) frente a la cadena por etapas
+ * solapadas. El argumento es el tamaño del archivo en KiB. first_batch_us es la latencia
+ * hasta que el evaluador recibe sus primeros tokens y total_us la de la ejecución completa.
+ */
+
+static void runPipeline(BenchmarkState &state, const bool overlapped) {
+    WorkloadConfig config;
+    config.targetBytes = static_cast<size_t>(state.range()) * 1024;
+    const std::string path = benchWorkloadFile("pipeline" + std::to_string(state.range()), config);
+    std::ifstream configFile(benchConfigPath());
+    const CompilationPipeline pipeline(LexicalAnalyzer::loadProvider(configFile));
+    double firstBatchUs = 0;
+    double totalUs = 0;
+    long long statements = 0;
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        std::ifstream code(path, std::ios::binary);
+        StatementEvaluator evaluator;
+        state.resumeTiming();
+
+        const PipelineStats stats = overlapped ? pipeline.run(code, evaluator) : pipeline.runSequential(code, evaluator);
+        evaluator.finish();
+        firstBatchUs += stats.firstBatchUs;
+        totalUs += stats.totalUs;
+        statements += evaluator.getEvaluated();
+        doNotOptimize(evaluator.getChecksum());
+    }
+    const double iterations = static_cast<double>(state.iterations());
+    state.setCounter("first_batch_us", firstBatchUs / iterations);
+    state.setCounter("total_us", totalUs / iterations);
+    state.setItemsProcessed(statements);
+    state.setBytesProcessed(benchFileSize(path) * state.iterations());
+}
+
+static void BM_PipelineSequential(BenchmarkState &state) {
+    runPipeline(state, false);
+}
+BENCHMARK_ARGS(BM_PipelineSequential, 1024, 8192);
+
+static void BM_PipelineOverlapped(BenchmarkState &state) {
+    runPipeline(state, true);
+}
+BENCHMARK_ARGS(BM_PipelineOverlapped, 1024, 8192);
@@ -0,0 +1,43 @@
+#include "benchmark.h"
+#include "stack/stack.h"
+#include "small_stack/small_stack.h"
+#include "../interface/node_struct.h"
+
+static void BM_StackPushPop(BenchmarkState &state) {
+    while (state.keepRunning()) {
+        Stack<double> stack;
+        for (long long i = 0; i < state.range(); i++) stack.push(static_cast<double>(i));
+        double sum = 0;
+        while (!stack.isEmpty()) sum += stack.pop();
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_StackPushPop, 8, 1000);
+
+static void BM_StackPushPopNodeStruct(BenchmarkState &state) {
+    NodeStruct token;
+    token.name = "+";
+    token.type = TokenType::OPERATOR;
+    token.offset = 0;
+    token.length = 1;
+    while (state.keepRunning()) {
+        Stack<NodeStruct> stack;
+        for (long long i = 0; i < state.range(); i++) stack.push(token);
+        while (!stack.isEmpty()) doNotOptimize(stack.pop());
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_StackPushPopNodeStruct, 8, 1000);
+
+static void BM_SmallStackPushPop(BenchmarkState &state) {
+    while (state.keepRunning()) {
+        SmallStack<double> stack;
+        for (long long i = 0; i < state.range(); i++) stack.push(static_cast<double>(i));
+        double sum = 0, value = 0;
+        while (stack.tryPop(value)) sum += value;
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_SmallStackPushPop, 8, 1000);
@@ -0,0 +1,70 @@
+#include <fstream>
+#include <string>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "program_parser/program_parser.h"
+#include "tiered_interpreter/tiered_interpreter.h"
+
+/*
+ * Carga mixta para TieredInterpreter: cientos de sentencias que se ejecutan una vez, una rama
+ * que nunca se toma, un bucle tibio de pocas vueltas y un bucle caliente. Cada iteración
+ * construye el intérprete y ejecuta el programa, así que la compilación anticipada cuenta.
+ * El argumento elige la política: 0 siempre interpreta, 1 compila todo al construir y 2 por niveles.
+ */
+
+static std::string coldStatements(const int count, const int seed) {
+    std::string source;
+    for (int i = 0; i < count; i++) {
+        const std::string k = std::to_string((seed + i) % 13 + 1);
+        source += "x = (a * " + k + " + b) / (" + k + " + 1.5) - x * 0.5 + values[" + std::to_string(i % 64) + "];\n";
+        source += "b = (b + a * " + k + ") % 1000 + (x > " + k + " && a < 100 ? 1 : 0);\n";
+    }
+    return source;
+}
+
+static const ProgramStruct &mixedProgram() {
+    static const ProgramStruct program = [] {
+        std::string source = "int main() {\n"
+                             "int a = 3;\n"
+                             "int b = 4;\n"
+                             "double x = 1.5;\n"
+                             "int sum = 0;\n"
+                             "int values[64];\n"
+                             "for (int i = 0; i < 64; i++) values[i] = i * 7 % 11;\n";
+        source += coldStatements(200, 0);
+        source += "if (a > 100) {\n" + coldStatements(400, 5) + "}\n";
+        source += "for (int w = 0; w < 8; w++) {\n" + coldStatements(20, 3) + "}\n";
+        source += "for (int i = 0; i < 20000; i++) {\n"
+                  "sum = sum + values[i % 64] * 2 - i % 3;\n"
+                  "if (i % 7 == 0) x = x + 1;\n"
+                  "}\n"
+                  "return sum;\n"
+                  "}\n";
+        const std::string path = "bench_tiered_mixed.txt";
+        std::ofstream(path, std::ios::binary) << source;
+        std::ifstream configFile(benchConfigPath());
+        LexicalAnalyzer lexer(configFile);
+        std::ifstream code(path, std::ios::binary);
+        return ProgramParser::parse(lexer.tokenize(code));
+    }();
+    return program;
+}
+
+static void BM_TieredMixed(BenchmarkState &state) {
+    const ProgramStruct &program = mixedProgram();
+    TierPolicy policy;
+    if (state.range() == 0) policy = TierPolicy{TieredInterpreter::NEVER, TieredInterpreter::NEVER};
+    if (state.range() == 1) policy = TierPolicy{0, 0};
+    size_t compiled = 0;
+    size_t sites = 0;
+    while (state.keepRunning()) {
+        TieredInterpreter interpreter(program, policy);
+        doNotOptimize(interpreter.run());
+        compiled = interpreter.compiledSites();
+        sites = interpreter.siteProfiles().size();
+    }
+    state.setCounter("sites", static_cast<double>(sites));
+    state.setCounter("compiled", static_cast<double>(compiled));
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK_ARGS(BM_TieredMixed, 0, 1, 2);
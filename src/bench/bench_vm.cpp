@@ -0,0 +1,107 @@
+#include <fstream>
+#include <string>
+#include "benchmark.h"
+#include "bench_common.h"
+#include "program_parser/program_parser.h"
+#include "bytecode_compiler/bytecode_compiler.h"
+#include "bytecode_vm/bytecode_vm.h"
+#include "operations_analyzer/operations_analyzer.h"
+
+/*
+ * Programas completos con bucles ejecutados por BytecodeVm. Las operaciones son las
+ * iteraciones del cuerpo más interno, de modo que items_per_second son operaciones por segundo.
+ * BM_VmNameLookup ejecuta el mismo cuerpo que BM_VmArraySum con OperationsAnalyzer y una
+ * SymbolTable, que busca cada variable por nombre.
+ */
+
+static ArrayList<NodeStruct> tokenizeSource(const std::string &name, const std::string &source) {
+    const std::string path = "bench_vm_" + name + ".txt";
+    std::ofstream(path, std::ios::binary) << source;
+    std::ifstream configFile(benchConfigPath());
+    LexicalAnalyzer lexer(configFile);
+    std::ifstream code(path, std::ios::binary);
+    return lexer.tokenize(code);
+}
+
+static BytecodeProgram compileSource(const std::string &name, const std::string &source) {
+    return BytecodeCompiler::compile(ProgramParser::parse(tokenizeSource(name, source)));
+}
+
+/**
+ * @brief Llena un arreglo de @c size enteros y lo suma 16 veces.
+ */
+static std::string arraySumSource(const int size) {
+    const std::string n = std::to_string(size);
+    return "int main() {\n"
+           "int values[" + n + "];\n"
+           "int sum = 0;\n"
+           "for (int i = 0; i < " + n + "; i++) {\n"
+           "values[i] = i % 97;\n"
+           "}\n"
+           "for (int r = 0; r < 16; r++) {\n"
+           "for (int i = 0; i < " + n + "; i++) {\n"
+           "sum = sum + values[i];\n"
+           "}\n"
+           "}\n"
+           "return sum;\n"
+           "}\n";
+}
+
+static void BM_VmArraySum(BenchmarkState &state) {
+    const int size = static_cast<int>(state.range());
+    const BytecodeProgram program = compileSource("sum" + std::to_string(size), arraySumSource(size));
+    BytecodeVm vm;
+    while (state.keepRunning()) {
+        doNotOptimize(vm.run(program).integer);
+    }
+    state.setCounter("instructions", static_cast<double>(program.code.size()));
+    state.setItemsProcessed(17LL * size * state.iterations());
+}
+BENCHMARK_ARGS(BM_VmArraySum, 1024, 65536);
+
+static void BM_VmNestedLoops(BenchmarkState &state) {
+    const std::string n = std::to_string(state.range());
+    const BytecodeProgram program = compileSource("nested" + n,
+        "int main() {\n"
+        "int total = 0;\n"
+        "double scale = 0.5;\n"
+        "for (int i = 0; i < " + n + "; i++) {\n"
+        "int j = 0;\n"
+        "while (j < " + n + ") {\n"
+        "if (i * j % 7 < 3) total = total + i; else total = total - j;\n"
+        "j++;\n"
+        "}\n"
+        "scale = scale * 1.0001;\n"
+        "}\n"
+        "return total;\n"
+        "}\n");
+    BytecodeVm vm;
+    while (state.keepRunning()) {
+        doNotOptimize(vm.run(program).integer);
+    }
+    state.setCounter("instructions", static_cast<double>(program.code.size()));
+    state.setItemsProcessed(state.range() * state.range() * state.iterations());
+}
+BENCHMARK_ARGS(BM_VmNestedLoops, 64, 512);
+
+static void BM_VmNameLookup(BenchmarkState &state) {
+    const int size = static_cast<int>(state.range());
+    CompiledExpression body;
+    OperationsAnalyzer::compile(OperationsAnalyzer::toPostfix(tokenizeSource("lookup", "sum + values[i]\n")), body);
+    SymbolTable symbols;
+    std::vector<double> values(static_cast<size_t>(size));
+    for (int i = 0; i < size; i++) values[static_cast<size_t>(i)] = i % 97;
+    symbols.setArray("values", values);
+    while (state.keepRunning()) {
+        symbols.set("sum", 0);
+        for (int r = 0; r < 16; r++) {
+            for (int i = 0; i < size; i++) {
+                symbols.set("i", i);
+                symbols.set("sum", OperationsAnalyzer::execute(body, &symbols));
+            }
+        }
+        doNotOptimize(symbols.get("sum"));
+    }
+    state.setItemsProcessed(16LL * size * state.iterations());
+}
+BENCHMARK_ARGS(BM_VmNameLookup, 1024, 65536);
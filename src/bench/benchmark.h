@@ -0,0 +1,330 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Estado que recibe cada micro-benchmark (inspirado en Google Benchmark).
+ * * El cuerpo del benchmark itera con `while (state.keepRunning()) { ... }`; el arnés
+ * decide cuántas iteraciones ejecutar hasta alcanzar el tiempo mínimo de medición.
+ */
+class BenchmarkState {
+
+    private:
+        long long maxIterations;
+        long long iteration;
+        long long argument;
+        bool running;
+        bool paused;
+        std::chrono::steady_clock::time_point wallStart;
+        long long cpuStartNs;
+        long long wallNs;
+        long long cpuNs;
+        long long itemsProcessed;
+        long long bytesProcessed;
+        std::map<std::string, double> counters;
+        void startTimer();
+        void stopTimer();
+
+    public:
+        BenchmarkState(long long iterations, long long argument);
+        static long long cpuNowNs();
+        bool keepRunning();
+        void pauseTiming();
+        void resumeTiming();
+        long long range() const;
+        long long iterations() const;
+        void setItemsProcessed(long long items);
+        void setBytesProcessed(long long bytes);
+        void setCounter(const std::string &name, double value);
+        long long getWallNs() const;
+        long long getCpuNs() const;
+        long long getItemsProcessed() const;
+        long long getBytesProcessed() const;
+        const std::map<std::string, double>& getCounters() const;
+};
+
+/**
+ * @brief Resultado serializable de un benchmark.
+ */
+struct BenchmarkResult {
+    std::string name;
+    long long iterations;
+    double realTimeNs;
+    double cpuTimeNs;
+    double itemsPerSecond;
+    double bytesPerSecond;
+    std::map<std::string, double> counters;
+};
+
+class BenchmarkRegistry {
+
+    public:
+        typedef std::function<void(BenchmarkState&)> Function;
+        struct Entry {
+            std::string name;
+            Function function;
+            std::vector<long long> arguments;
+        };
+        static std::vector<Entry>& entries();
+        static int add(const std::string &name, const Function &function, std::initializer_list<long long> arguments);
+        static int runAll(int argc, char **argv);
+
+    private:
+        static BenchmarkResult runOne(const std::string &name, const Function &function, long long argument,
+                                      double minTimeSeconds);
+        static void writeJson(std::ostream &out, const std::vector<BenchmarkResult> &results);
+};
+
+/**
+ * @brief Impide que el optimizador descarte un valor calculado dentro del benchmark.
+ */
+template <typename T>
+inline void doNotOptimize(T const &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline BenchmarkState::BenchmarkState(const long long iterations, const long long argument)
+    : maxIterations(iterations), iteration(0), argument(argument), running(false), paused(false),
+      cpuStartNs(0), wallNs(0), cpuNs(0), itemsProcessed(0), bytesProcessed(0) {}
+
+/**
+ * @brief Tiempo de CPU del proceso en nanosegundos.
+ */
+inline long long BenchmarkState::cpuNowNs() {
+#if defined(__unix__) || defined(__APPLE__)
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#else
+    return static_cast<long long>(std::clock()) * 1000000000LL / CLOCKS_PER_SEC;
+#endif
+}
+
+inline void BenchmarkState::startTimer() {
+    this->wallStart = std::chrono::steady_clock::now();
+    this->cpuStartNs = cpuNowNs();
+}
+
+inline void BenchmarkState::stopTimer() {
+    this->wallNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - this->wallStart).count();
+    this->cpuNs += cpuNowNs() - this->cpuStartNs;
+}
+
+/**
+ * @brief Controla el bucle de medición.
+ * @return true mientras queden iteraciones por ejecutar; al terminar detiene el temporizador.
+ */
+inline bool BenchmarkState::keepRunning() {
+    if (!this->running) {
+        this->running = true;
+        this->startTimer();
+    }
+    if (this->iteration < this->maxIterations) {
+        ++this->iteration;
+        return true;
+    }
+    if (!this->paused) this->stopTimer();
+    return false;
+}
+
+/**
+ * @brief Excluye de la medición el trabajo de preparación dentro de una iteración.
+ */
+inline void BenchmarkState::pauseTiming() {
+    if (this->paused) return;
+    this->stopTimer();
+    this->paused = true;
+}
+
+/**
+ * @brief Reanuda la medición tras pauseTiming().
+ */
+inline void BenchmarkState::resumeTiming() {
+    if (!this->paused) return;
+    this->startTimer();
+    this->paused = false;
+}
+
+inline long long BenchmarkState::range() const { return this->argument; }
+inline long long BenchmarkState::iterations() const { return this->maxIterations; }
+inline void BenchmarkState::setItemsProcessed(const long long items) { this->itemsProcessed = items; }
+inline void BenchmarkState::setBytesProcessed(const long long bytes) { this->bytesProcessed = bytes; }
+inline void BenchmarkState::setCounter(const std::string &name, const double value) { this->counters[name] = value; }
+inline long long BenchmarkState::getWallNs() const { return this->wallNs; }
+inline long long BenchmarkState::getCpuNs() const { return this->cpuNs; }
+inline long long BenchmarkState::getItemsProcessed() const { return this->itemsProcessed; }
+inline long long BenchmarkState::getBytesProcessed() const { return this->bytesProcessed; }
+inline const std::map<std::string, double>& BenchmarkState::getCounters() const { return this->counters; }
+
+/**
+ * @brief Lista global de benchmarks registrados por las macros BENCHMARK*.
+ */
+inline std::vector<BenchmarkRegistry::Entry>& BenchmarkRegistry::entries() {
+    static std::vector<Entry> registered;
+    return registered;
+}
+
+/**
+ * @brief Registra un benchmark.
+ * @param name Nombre base; si hay argumentos se publica como `name/arg`.
+ * @param function Cuerpo del benchmark.
+ * @param arguments Valores que recibirá el benchmark por medio de BenchmarkState::range().
+ * @return Siempre 0 (permite el registro estático desde una variable global).
+ */
+inline int BenchmarkRegistry::add(const std::string &name, const Function &function,
+                                  const std::initializer_list<long long> arguments) {
+    entries().push_back(Entry{name, function, std::vector<long long>(arguments)});
+    return 0;
+}
+
+/**
+ * @brief Ejecuta un benchmark duplicando las iteraciones hasta superar el tiempo mínimo.
+ */
+inline BenchmarkResult BenchmarkRegistry::runOne(const std::string &name, const Function &function,
+                                                 const long long argument, const double minTimeSeconds) {
+    long long iterations = 1;
+    while (true) {
+        BenchmarkState state(iterations, argument);
+        function(state);
+        const double seconds = static_cast<double>(state.getWallNs()) / 1e9;
+        if (seconds >= minTimeSeconds || iterations >= 1000000000LL) {
+            BenchmarkResult result;
+            result.name = name;
+            result.iterations = iterations;
+            result.realTimeNs = static_cast<double>(state.getWallNs()) / static_cast<double>(iterations);
+            result.cpuTimeNs = static_cast<double>(state.getCpuNs()) / static_cast<double>(iterations);
+            result.itemsPerSecond = seconds > 0 ? static_cast<double>(state.getItemsProcessed()) / seconds : 0;
+            result.bytesPerSecond = seconds > 0 ? static_cast<double>(state.getBytesProcessed()) / seconds : 0;
+            result.counters = state.getCounters();
+            return result;
+        }
+        long long next = seconds > 0 ? static_cast<long long>(iterations * (minTimeSeconds * 1.4 / seconds)) : 0;
+        if (next > iterations * 10) next = iterations * 10;
+        if (next <= iterations) next = iterations * 2;
+        iterations = next;
+    }
+}
+
+/**
+ * @brief Serializa los resultados con el esquema JSON de Google Benchmark para poder
+ * compararlos con sus herramientas (p. ej. compare.py) entre commits.
+ */
+inline void BenchmarkRegistry::writeJson(std::ostream &out, const std::vector<BenchmarkResult> &results) {
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    long cpus = 1;
+#if defined(__unix__) || defined(__APPLE__)
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    out << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n    \"num_cpus\": " << cpus
+        << ",\n    \"library_build_type\": \"mini-compiler\",\n    \"instrumentation\": "
+#ifdef MINI_COMPILER_INSTRUMENTATION
+        << "true"
+#else
+        << "false"
+#endif
+        << "\n  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult &r = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << r.name << "\", \"run_type\": \"iteration\""
+            << ", \"iterations\": " << r.iterations << ", \"real_time\": " << r.realTimeNs
+            << ", \"cpu_time\": " << r.cpuTimeNs << ", \"time_unit\": \"ns\"";
+        if (r.itemsPerSecond > 0) out << ", \"items_per_second\": " << r.itemsPerSecond;
+        if (r.bytesPerSecond > 0) out << ", \"bytes_per_second\": " << r.bytesPerSecond;
+        for (const auto &counter : r.counters) out << ", \"" << counter.first << "\": " << counter.second;
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/**
+ * @brief Punto de entrada del arnés.
+ * * Opciones: `--benchmark_filter=<regex>`, `--benchmark_min_time=<segundos>`,
+ * `--benchmark_out=<archivo.json>` y `--benchmark_list`.
+ * @return Código de salida del proceso.
+ */
+inline int BenchmarkRegistry::runAll(const int argc, char **argv) {
+    std::string filter = ".*";
+    std::string outPath;
+    double minTime = 0.2;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--benchmark_filter=", 0) == 0) filter = arg.substr(19);
+        else if (arg.rfind("--benchmark_min_time=", 0) == 0) minTime = std::stod(arg.substr(21));
+        else if (arg.rfind("--benchmark_out=", 0) == 0) outPath = arg.substr(16);
+        else if (arg == "--benchmark_list") listOnly = true;
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    const std::regex pattern(filter);
+    std::vector<BenchmarkResult> results;
+    for (const Entry &entry : entries()) {
+        std::vector<long long> arguments = entry.arguments;
+        if (arguments.empty()) arguments.push_back(0);
+        for (const long long argument : arguments) {
+            const std::string name = entry.arguments.empty() ? entry.name : entry.name + "/" + std::to_string(argument);
+            if (!std::regex_search(name, pattern)) continue;
+            if (listOnly) { std::cout << name << std::endl; continue; }
+
+            const BenchmarkResult result = runOne(name, entry.function, argument, minTime);
+            std::cerr << name << "  " << result.realTimeNs << " ns  (" << result.iterations << " it)" << std::endl;
+            results.push_back(result);
+        }
+    }
+    if (listOnly) return 0;
+
+    if (outPath.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream out(outPath);
+        if (!out.is_open()) {
+            std::cerr << "Error: Unable to open " << outPath << std::endl;
+            return 1;
+        }
+        writeJson(out, results);
+    }
+    return 0;
+}
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+
+/** Registra `function` sin argumentos. */
+#define BENCHMARK(function) \
+    static int BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = \
+        BenchmarkRegistry::add(#function, function, {})
+
+/** Registra `function` una vez por cada argumento listado (accesible con state.range()). */
+#define BENCHMARK_ARGS(function, ...) \
+    static int BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = \
+        BenchmarkRegistry::add(#function, function, {__VA_ARGS__})
+
+#endif
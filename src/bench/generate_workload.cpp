@@ -0,0 +1,69 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "workload_generator.h"
+
+/**
+ * Genera un archivo de código sintético determinista.
+ * Uso: generate_workload <salida> [--bytes=N] [--depth=N] [--ident=N] [--strings=P] [--comments=P] [--utf8=P] [--utf8-ident=P] [--seed=N] [--program] [--expression]
+ * Con --program escribe un programa `int main() { ... }` para la representación intermedia.
+ * Con --expression escribe una única suma de expresiones aritméticas, una por línea, que
+ * `proyectos --evaluate` puede evaluar completa.
+ */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: generate_workload <output> [--bytes=N] [--depth=N] [--ident=N] "
+                     "[--strings=P] [--comments=P] [--utf8=P] [--utf8-ident=P] [--seed=N] [--program] [--expression]" << std::endl;
+        return 1;
+    }
+
+    WorkloadConfig config;
+    bool program = false;
+    bool expression = false;
+    for (int i = 2; i < argc; i++) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--bytes") config.targetBytes = std::stoull(value);
+        else if (key == "--depth") config.expressionDepth = std::stoi(value);
+        else if (key == "--ident") config.identifierLength = std::stoi(value);
+        else if (key == "--strings") config.stringDensity = std::stod(value);
+        else if (key == "--comments") config.commentRatio = std::stod(value);
+        else if (key == "--utf8") config.utf8Ratio = std::stod(value);
+        else if (key == "--utf8-ident") config.utf8IdentifierRatio = std::stod(value);
+        else if (key == "--seed") config.seed = std::stoull(value);
+        else if (key == "--program") program = true;
+        else if (key == "--expression") expression = true;
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    WorkloadGenerator generator(config);
+    if (program || expression) {
+        std::ofstream out(argv[1], std::ios::binary);
+        if (program) {
+            out << generator.program();
+        } else {
+            size_t written = 0;
+            while (written < config.targetBytes) {
+                const std::string line = "(" + generator.expression(config.expressionDepth) + ") +\n";
+                out << line;
+                written += line.size();
+            }
+            out << "0\n";
+        }
+        if (!out) {
+            std::cerr << "Error: Unable to write " << argv[1] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (!generator.writeFile(argv[1])) {
+        std::cerr << "Error: Unable to write " << argv[1] << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Parámetros que definen el tamaño y la forma del código sintético.
+ */
+struct WorkloadConfig {
+    size_t targetBytes = 64 * 1024;
+    int expressionDepth = 3;
+    int identifierLength = 6;
+    double stringDensity = 0.1;
+    double commentRatio = 0.1;
+    double blockCommentRatio = 0.0;
+    int stringWords = 0;
+    double utf8Ratio = 0.0;
+    double utf8IdentifierRatio = 0.0;
+    uint64_t seed = 42;
+};
+
+/**
+ * @brief Generador determinista de código fuente para los benchmarks.
+ * * Usa su propio PRNG (splitmix64) en lugar de <random> para que la misma semilla
+ * produzca exactamente el mismo archivo en cualquier compilador y plataforma.
+ */
+class WorkloadGenerator {
+
+    private:
+        WorkloadConfig config;
+        uint64_t state;
+        uint64_t next();
+        int nextInt(int bound);
+        bool chance(double probability);
+        std::string identifier();
+        std::string word();
+        std::string number();
+        std::string statement();
+        std::string variable(int count);
+        std::string programStatement(int variables, int depth, int &loops);
+
+    public:
+        explicit WorkloadGenerator(const WorkloadConfig &config);
+        std::string expression(int depth);
+        std::string mixedExpression(int depth);
+        std::string source();
+        std::string program(int variables = 16);
+        bool writeFile(const std::string &path);
+};
+
+inline WorkloadGenerator::WorkloadGenerator(const WorkloadConfig &config) : config(config), state(config.seed) {}
+
+/**
+ * @brief Siguiente valor de la secuencia splitmix64.
+ */
+inline uint64_t WorkloadGenerator::next() {
+    uint64_t z = (this->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline int WorkloadGenerator::nextInt(const int bound) {
+    return static_cast<int>(this->next() % static_cast<uint64_t>(bound));
+}
+
+inline bool WorkloadGenerator::chance(const double probability) {
+    return static_cast<double>(this->next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+}
+
+/**
+ * @brief Identificador de longitud configurable que empieza por letra. Con probabilidad
+ * utf8IdentifierRatio empieza en cambio por una palabra no ASCII válida como identificador.
+ */
+inline std::string WorkloadGenerator::identifier() {
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyz_";
+    static const char digits[] = "0123456789";
+    static const char* const words[] = {"año", "canción", "über", "façade", "привет", "данные",
+                                        "日本語", "変数", "λόγος", "résumé", "naïve", "ñandú"};
+    if (this->config.utf8IdentifierRatio > 0 && this->chance(this->config.utf8IdentifierRatio)) {
+        return words[this->nextInt(12)] + std::string(1, letters[this->nextInt(27)]);
+    }
+    std::string name(1, letters[this->nextInt(26)]);
+    for (int i = 1; i < this->config.identifierLength; i++) {
+        name += this->chance(0.8) ? letters[this->nextInt(27)] : digits[this->nextInt(10)];
+    }
+    return name;
+}
+
+/**
+ * @brief Palabra de texto libre para cadenas y comentarios: con probabilidad utf8Ratio es una
+ * palabra con acentos, cirílico, CJK o emoji (bytes ≥ 0x80) en lugar de un identificador.
+ */
+inline std::string WorkloadGenerator::word() {
+    static const char* const words[] = {"año", "canción", "über", "façade", "привет", "данные",
+                                        "日本語", "変数", "λόγος", "😀", "naïve", "ñandú"};
+    if (this->config.utf8Ratio <= 0 || !this->chance(this->config.utf8Ratio)) return this->identifier();
+    return words[this->nextInt(12)];
+}
+
+/**
+ * @brief Literal numérico entero o flotante.
+ */
+inline std::string WorkloadGenerator::number() {
+    std::string value = std::to_string(1 + this->nextInt(999));
+    if (this->chance(0.4)) value += "." + std::to_string(this->nextInt(100));
+    return value;
+}
+
+/**
+ * @brief Expresión aritmética con paréntesis anidados hasta la profundidad indicada.
+ * Solo contiene literales numéricos y + - * /, por lo que OperationsAnalyzer puede evaluarla.
+ * @param depth Nivel máximo de anidamiento restante.
+ */
+inline std::string WorkloadGenerator::expression(const int depth) {
+    static const char operators[] = "+-*/";
+    if (depth <= 0) return this->number();
+    const std::string left = this->chance(0.7) ? "(" + this->expression(depth - 1) + ")" : this->number();
+    const std::string right = this->chance(0.5) ? "(" + this->expression(depth - 1) + ")" : this->number();
+    return left + operators[this->nextInt(4)] + right;
+}
+
+/**
+ * @brief Expresión con todos los operadores de OperationsAnalyzer: menos unario, resto,
+ * potencia, comparaciones, lógicos, condicional y llamadas a funciones predefinidas.
+ * Solo usa literales, por lo que se evalúa sin tabla de variables.
+ * @param depth Nivel máximo de anidamiento restante.
+ */
+inline std::string WorkloadGenerator::mixedExpression(const int depth) {
+    static const char* const arithmetic[] = {"+", "-", "*", "/", "%"};
+    static const char* const logical[] = {"<", ">", "<=", ">=", "==", "!=", "&&", "||"};
+    if (depth <= 0) {
+        switch (this->nextInt(4)) {
+            case 0: return "-" + this->number();
+            case 1: return "sqrt(" + this->number() + ")";
+            default: return this->number();
+        }
+    }
+    const std::string left = "(" + this->mixedExpression(depth - 1) + ")";
+    const std::string right = "(" + this->mixedExpression(depth - 1) + ")";
+    switch (this->nextInt(5)) {
+        case 0: return left + arithmetic[this->nextInt(5)] + right;
+        case 1: return left + " " + logical[this->nextInt(8)] + " " + right;
+        case 2: return left + " ? " + right + " : " + this->number();
+        case 3: return (this->chance(0.5) ? "max(" : "min(") + left + ", " + right + ")";
+        default: return "abs" + left + " ** 2";
+    }
+}
+
+/**
+ * @brief Una línea de código: comentario, declaración de cadena o asignación aritmética.
+ * Los comentarios de bloque (blockCommentRatio) pueden ocupar varias líneas.
+ */
+inline std::string WorkloadGenerator::statement() {
+    if (this->config.blockCommentRatio > 0 && this->chance(this->config.blockCommentRatio)) {
+        std::string comment = "/*";
+        const int lines = 1 + this->nextInt(4);
+        for (int i = 0; i < lines; i++) {
+            comment += (i == 0 ? " " : "\n * ") + this->word() + " " + this->expression(1) + " " + this->word();
+        }
+        return comment + " */";
+    }
+    if (this->chance(this->config.commentRatio)) {
+        return "// " + this->word() + " " + this->word() + " " + this->number();
+    }
+    if (this->chance(this->config.stringDensity)) {
+        std::string text;
+        const int words = this->config.stringWords > 0 ? this->config.stringWords : 2 + this->nextInt(6);
+        for (int i = 0; i < words; i++) text += (i == 0 ? "" : " ") + this->word();
+        return "string " + this->identifier() + " = \"" + text + "\";";
+    }
+    static const char* const types[] = {"int", "float", "double"};
+    return std::string(types[this->nextInt(3)]) + " " + this->identifier() + " = " +
+           this->expression(this->config.expressionDepth) + ";";
+}
+
+/**
+ * @brief Genera el programa completo hasta alcanzar el tamaño objetivo.
+ * @return Código fuente con líneas terminadas en '\n'.
+ */
+inline std::string WorkloadGenerator::source() {
+    this->state = this->config.seed;
+    std::string code;
+    code.reserve(this->config.targetBytes + 256);
+    while (code.size() < this->config.targetBytes) {
+        code += this->statement();
+        code += '\n';
+    }
+    return code;
+}
+
+inline std::string WorkloadGenerator::variable(const int count) {
+    return "v" + std::to_string(this->nextInt(count));
+}
+
+/**
+ * @brief Sentencia de un programa completo sobre las variables v0..v<N-1>.
+ * Mezcla lo que aprovechan las pasadas de IrOptimizer: copias, condiciones constantes,
+ * asignaciones muertas en bloques internos y bucles `for` de límites constantes con
+ * subexpresiones invariantes. No genera división ni resto enteros.
+ * @param variables Cantidad de variables globales declaradas.
+ * @param depth Nivel máximo de anidamiento de bloques restante.
+ * @param loops Contador de bucles, usado para nombrar sus variables de control.
+ */
+inline std::string WorkloadGenerator::programStatement(const int variables, const int depth, int &loops) {
+    const std::string target = this->variable(variables);
+    const std::string a = this->variable(variables);
+    const std::string b = this->variable(variables);
+    switch (depth > 0 ? this->nextInt(8) : this->nextInt(4)) {
+        case 0: return target + " = " + a + " + " + std::to_string(1 + this->nextInt(9)) + ";";
+        case 1: return target + " = " + a + " * " + std::to_string(1 + this->nextInt(3)) + " - " + b + ";";
+        case 2: return target + " = " + a + ";";
+        case 3: return target + " = (" + std::to_string(2 + this->nextInt(8)) + " * 3 + 1) - " + a + ";";
+        case 4: {
+            const std::string counter = "i" + std::to_string(loops++);
+            const std::string body = this->programStatement(variables, depth - 1, loops);
+            return "for (int " + counter + " = 0; " + counter + " < " + std::to_string(2 + this->nextInt(30)) + "; " +
+                   counter + "++) {\n" + target + " = " + target + " + (" + a + " * 2 + " + b + ") - " + counter +
+                   ";\n" + body + "\n}";
+        }
+        case 5: {
+            const std::string condition = this->chance(0.5) ? std::to_string(this->nextInt(4)) + " < 2"
+                                                             : a + " > " + b + " && " + b + " != 0";
+            return "if (" + condition + ") {\n" + this->programStatement(variables, depth - 1, loops) + "\n} else {\n" +
+                   this->programStatement(variables, depth - 1, loops) + "\n}";
+        }
+        case 6: {
+            const std::string temporary = "t" + std::to_string(loops++);
+            return "{\nint " + temporary + " = " + a + " * " + b + ";\n" + temporary + " = " + temporary + " + " + a +
+                   ";\n" + this->programStatement(variables, depth - 1, loops) + "\n}";
+        }
+        default:
+            return target + " = " + std::to_string(this->nextInt(100)) + ";\n" + target + " = " + a + " - " + b + ";";
+    }
+}
+
+/**
+ * @brief Genera un programa completo `int main() { ... }` para la representación intermedia.
+ * A diferencia de source(), sus variables se declaran antes de usarse y forma un solo
+ * programa válido para ProgramParser.
+ * @param variables Cantidad de variables globales (mitad `int`, mitad `double`).
+ * @return Código fuente de aproximadamente config.targetBytes bytes.
+ */
+inline std::string WorkloadGenerator::program(const int variables) {
+    this->state = this->config.seed;
+    std::string code = "int main() {\n";
+    code.reserve(this->config.targetBytes + 256);
+    for (int i = 0; i < variables; i++) {
+        code += std::string(i % 2 == 0 ? "int" : "double") + " v" + std::to_string(i) + " = " +
+                std::to_string(1 + this->nextInt(9)) + ";\n";
+    }
+    int loops = 0;
+    while (code.size() < this->config.targetBytes) {
+        code += this->programStatement(variables, this->config.expressionDepth, loops);
+        code += '\n';
+    }
+    return code + "return 0;\n}\n";
+}
+
+/**
+ * @brief Escribe el programa generado en disco.
+ * @param path Ruta del archivo destino.
+ * @return true si el archivo se escribió correctamente.
+ */
+inline bool WorkloadGenerator::writeFile(const std::string &path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+    out << this->source();
+    return static_cast<bool>(out);
+}
+
+#endif
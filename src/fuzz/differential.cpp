@@ -0,0 +1,330 @@
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "fuzz_common.h"
+#include "block_reader/block_reader.h"
+#include "constexpr_evaluator/constexpr_evaluator.h"
+#include "operations_analyzer/operations_analyzer.h"
+#include "program_parser/program_parser.h"
+#include "bytecode_compiler/bytecode_compiler.h"
+#include "bytecode_vm/bytecode_vm.h"
+#include "tiered_interpreter/tiered_interpreter.h"
+#include "ir_builder/ir_builder.h"
+#include "ir_optimizer/ir_optimizer.h"
+#include "ir_reference.h"
+#include "test/char_classes.h"
+#include "utf8/utf8.h"
+
+/*
+ * Arnés diferencial: compara cada ruta rápida con una implementación de referencia sobre
+ * entradas aleatorias de WorkloadGenerator y sobre los archivos indicados.
+ *   lexer        tokenize() por bloques (BlockReader)  contra tokenize() por líneas.
+ *   classes      La tabla CharClass de TokenProvider   contra una clasificación escrita a mano.
+ *   utf8         Utf8::isValid() y Utf8::decode()       contra la tabla 3-7 del estándar Unicode.
+ *   expressions  OperationsAnalyzer, con y sin caché   contra ConstexprEvaluator.
+ *   programs     BytecodeVm y la IR optimizada          contra IrReference sobre la IR sin optimizar.
+ *   tiered       TieredInterpreter compilado           contra TieredInterpreter interpretado.
+ * Cada discrepancia se guarda en differential_<caso>_<n>.txt para reproducirla.
+ * Uso: differential [--iterations=N] [--seed=S] [archivos o directorios...]
+ */
+
+/**
+ * @brief Casos probados y discrepancias de una comparación.
+ */
+struct DifferentialStats {
+    const char* name;
+    long long cases = 0;
+    long long mismatches = 0;
+};
+
+static void report(DifferentialStats &stats, const std::string &input, const std::string &detail) {
+    const std::string path = "differential_" + std::string(stats.name) + "_" + std::to_string(stats.mismatches) + ".txt";
+    std::ofstream(path, std::ios::binary) << input;
+    std::cout << stats.name << ": " << detail << " (" << path << ")" << std::endl;
+    ++stats.mismatches;
+}
+
+/**
+ * @brief Longitud de la secuencia UTF-8 bien formada que empieza en @c text según la tabla 3-7
+ * del estándar Unicode (rangos permitidos del segundo byte según el primero); 0 si no lo es.
+ */
+static size_t wellFormedLength(const unsigned char* text, const size_t available) {
+    struct Row { unsigned char lead0, lead1, second0, second1; size_t size; };
+    static const Row rows[] = {
+        {0x00, 0x7F, 0x00, 0x00, 1}, {0xC2, 0xDF, 0x80, 0xBF, 2}, {0xE0, 0xE0, 0xA0, 0xBF, 3},
+        {0xE1, 0xEC, 0x80, 0xBF, 3}, {0xED, 0xED, 0x80, 0x9F, 3}, {0xEE, 0xEF, 0x80, 0xBF, 3},
+        {0xF0, 0xF0, 0x90, 0xBF, 4}, {0xF1, 0xF3, 0x80, 0xBF, 4}, {0xF4, 0xF4, 0x80, 0x8F, 4},
+    };
+    for (const Row &row : rows) {
+        if (text[0] < row.lead0 || text[0] > row.lead1) continue;
+        if (row.size > available) return 0;
+        if (row.size > 1 && (text[1] < row.second0 || text[1] > row.second1)) return 0;
+        for (size_t k = 2; k < row.size; k++) {
+            if (text[k] < 0x80 || text[k] > 0xBF) return 0;
+        }
+        return row.size;
+    }
+    return 0;
+}
+
+/**
+ * @brief Utf8::isValid() y Utf8::decode() contra wellFormedLength() sobre texto casi ASCII con
+ * secuencias válidas e inválidas en posiciones y longitudes que cruzan los bloques SIMD.
+ */
+static void checkUtf8(const std::string &text, DifferentialStats &stats) {
+    ++stats.cases;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    bool expected = true;
+    for (size_t i = 0; i < text.size();) {
+        const size_t size = wellFormedLength(bytes + i, text.size() - i);
+        uint32_t codePoint = 0;
+        if (Utf8::decode(text.data() + i, text.data() + text.size(), codePoint) != size) {
+            report(stats, text, "decode disagrees at byte " + std::to_string(i));
+            return;
+        }
+        if (size == 0) {
+            expected = false;
+            break;
+        }
+        i += size;
+    }
+    if (Utf8::isValid(text.data(), text.size()) != expected) report(stats, text, "isValid disagrees");
+}
+
+static void checkLexer(const std::string &source, DifferentialStats &stats) {
+    ++stats.cases;
+    const std::string path = fuzzInputFile(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+    std::ifstream code(path, std::ios::binary);
+    const ArrayList<NodeStruct> lines = fuzzLexer().tokenize(code);
+    BlockReader reader(path, 4096);
+    const ArrayList<NodeStruct> blocks = fuzzLexer().tokenize(reader);
+    if (!sameTokens(lines, blocks)) {
+        report(stats, source, std::to_string(lines.getSize()) + " tokens by line, " +
+                              std::to_string(blocks.getSize()) + " by block");
+    }
+}
+
+static ArrayList<NodeStruct> tokenizeSource(const std::string &source) {
+    std::ifstream code(fuzzInputFile(reinterpret_cast<const uint8_t*>(source.data()), source.size()), std::ios::binary);
+    return fuzzLexer().tokenize(code);
+}
+
+static void checkCharClasses(DifferentialStats &stats) {
+    stats.cases += CHAR_CLASS_CASES;
+    for (const std::string &mismatch : charClassMismatches(fuzzLexer())) report(stats, "", mismatch);
+}
+
+/**
+ * @brief Solo + - * / y paréntesis: ConstexprEvaluator es la referencia. Una división entre
+ * cero no es constante para ella, así que esos casos no se comparan.
+ */
+static void checkExpression(const std::string &expression, DifferentialStats &stats) {
+    double expected = 0;
+    try {
+        expected = ConstexprEvaluator::evaluate(expression);
+    } catch (const std::exception &) {
+        return;
+    }
+    ++stats.cases;
+    const ArrayList<NodeStruct> tokens = tokenizeSource(expression + "\n");
+    ExpressionCache cache(4);
+    const double interpreted = OperationsAnalyzer::evaluate(tokens, nullptr);
+    const double compiled = OperationsAnalyzer::evaluate(tokens, &cache);
+    const double cached = OperationsAnalyzer::evaluate(tokens, &cache);
+    if (!sameResult(expected, interpreted) || !sameResult(expected, compiled) || !sameResult(expected, cached)) {
+        std::ostringstream detail;
+        detail.precision(17);
+        detail << "expected " << expected << ", got " << interpreted << " / " << compiled << " / " << cached;
+        report(stats, expression, detail.str());
+    }
+}
+
+/**
+ * @brief Ejecuta el programa en BytecodeVm y escribe sus variables globales como IrReference.
+ * @return Texto de las variables o el mensaje de la excepción.
+ */
+static std::string runVm(const ProgramStruct &program) {
+    const BytecodeProgram bytecode = BytecodeCompiler::compile(program);
+    BytecodeVm vm;
+    try {
+        vm.run(bytecode);
+    } catch (const std::exception &e) {
+        return std::string("error: ") + e.what();
+    }
+    std::ostringstream out;
+    out.precision(17);
+    vm.dump(out);
+    return out.str();
+}
+
+static std::string runIr(const IrFunction &function) {
+    try {
+        const std::vector<std::string> exports = IrReference::run(function);
+        std::string out;
+        for (size_t i = 0; i < function.variables.size(); i++) {
+            if (function.variables[i].global) out += function.variables[i].name + " = " + exports[i] + "\n";
+        }
+        return out;
+    } catch (const std::exception &e) {
+        return std::string("error: ") + e.what();
+    }
+}
+
+/**
+ * @brief Quita de la salida de BytecodeVm las variables que la IR no exporta, como las
+ * declaradas después de un `return` ejecutado, para las que BytecodeVm informa su valor inicial.
+ */
+static std::string exportedOnly(const std::string &vm, const std::string &ir) {
+    std::istringstream fast(vm);
+    std::istringstream expected(ir);
+    std::string out;
+    std::string left;
+    std::string right;
+    while (std::getline(fast, left) && std::getline(expected, right)) {
+        out += (right.size() >= 3 && right.compare(right.size() - 3, 3, " = ") == 0 ? right : left) + "\n";
+    }
+    return vm.rfind("error: ", 0) == 0 ? vm : out;
+}
+
+/**
+ * @brief BytecodeVm y la IR optimizada contra IrReference sobre la IR sin optimizar.
+ */
+static void checkProgram(const ProgramStruct &program, const std::string &source, DifferentialStats &stats) {
+    ++stats.cases;
+    IrFunction function = IrBuilder::build(program);
+    const std::string expected = runIr(function);
+    IrOptimizer::optimize(function);
+    const std::string optimized = runIr(function);
+    const std::string fast = exportedOnly(runVm(program), expected);
+    if (optimized != expected) report(stats, source, "optimized IR differs:\n" + optimized + "expected:\n" + expected);
+    else if (fast != expected) report(stats, source, "BytecodeVm differs:\n" + fast + "expected:\n" + expected);
+}
+
+/**
+ * @brief Ejecuta el programa en @c interpreter.
+ * @return Cadena vacía, o "error: " y el mensaje si la ejecución lanzó una excepción.
+ */
+static std::string runTiered(TieredInterpreter &interpreter, double &result) {
+    try {
+        result = interpreter.run();
+        return std::string();
+    } catch (const std::exception &e) {
+        return std::string("error: ") + e.what();
+    }
+}
+
+/**
+ * @brief TieredInterpreter con todo compilado de antemano contra el mismo sin compilar nada:
+ * los dos calculan en doubles, así que deben coincidir bit a bit. Un error en tiempo de
+ * ejecución cuenta como coincidencia si ambos fallan con el mismo mensaje, como en checkProgram().
+ */
+static void checkTiered(const ProgramStruct &program, const std::string &source, DifferentialStats &stats) {
+    for (const VariableInfo &variable : program.variables) {
+        if (variable.type == ValueType::STRING) return;
+    }
+    ++stats.cases;
+    TieredInterpreter reference(program, TierPolicy{TieredInterpreter::NEVER, TieredInterpreter::NEVER});
+    TieredInterpreter compiled(program, TierPolicy{0, 0});
+    double expected = 0;
+    double result = 0;
+    const std::string expectedError = runTiered(reference, expected);
+    const std::string error = runTiered(compiled, result);
+    if (error != expectedError) {
+        report(stats, source, "error differs: '" + error + "', expected '" + expectedError + "'");
+        return;
+    }
+    if (!error.empty()) return;
+    if (!sameResult(expected, result)) {
+        report(stats, source, "return differs");
+        return;
+    }
+    for (size_t i = 0; i < program.variables.size(); i++) {
+        const int32_t variable = static_cast<int32_t>(i);
+        if (!sameResult(reference.get(variable), compiled.get(variable))) {
+            report(stats, source, program.variables[i].name + " differs");
+            return;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int iterations = 200;
+    uint64_t seed = 1;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--iterations=", 0) == 0) iterations = std::stoi(arg.substr(13));
+        else if (arg.rfind("--seed=", 0) == 0) seed = std::stoull(arg.substr(7));
+        else if (std::filesystem::is_directory(arg)) {
+            for (const auto &entry : std::filesystem::recursive_directory_iterator(arg)) {
+                if (entry.is_regular_file()) files.push_back(entry.path().string());
+            }
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    DifferentialStats lexer{"lexer"};
+    DifferentialStats classes{"classes"};
+    DifferentialStats utf8{"utf8"};
+    DifferentialStats expressions{"expressions"};
+    DifferentialStats programs{"programs"};
+    DifferentialStats tiered{"tiered"};
+    const auto checkSource = [&](const std::string &source) {
+        ProgramStruct program;
+        try {
+            program = ProgramParser::parse(tokenizeSource(source));
+        } catch (const std::exception &) {
+            return;
+        }
+        checkProgram(program, source, programs);
+        checkTiered(program, source, tiered);
+    };
+
+    checkCharClasses(classes);
+    for (const std::string &file : files) {
+        std::ifstream in(file, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Cannot open " << file << std::endl;
+            return 1;
+        }
+        const std::string source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        checkLexer(source, lexer);
+        checkSource(source);
+    }
+    for (int i = 0; i < iterations; i++) {
+        WorkloadConfig config;
+        config.seed = seed + static_cast<uint64_t>(i);
+        config.targetBytes = 1024 + static_cast<size_t>(i % 16) * 1024;
+        config.blockCommentRatio = i % 3 == 0 ? 0.05 : 0.0;
+        config.utf8Ratio = i % 2 == 0 ? 0.3 : 0.0;
+        config.utf8IdentifierRatio = i % 4 == 0 ? 0.3 : 0.0;
+        config.expressionDepth = 2;
+        WorkloadGenerator generator(config);
+        checkLexer(generator.source(), lexer);
+        for (int k = 0; k < 8; k++) checkExpression(generator.expression(1 + k % 5), expressions);
+        checkSource(generator.program(4 + i % 8));
+        uint64_t noise = config.seed * 0x9E3779B97F4A7C15ULL;
+        for (int k = 0; k < 8; k++) {
+            std::string text(static_cast<size_t>(1 + k * 9 + i % 40), 'a');
+            for (int m = 0; m < 1 + k % 3; m++) {
+                noise = noise * 6364136223846793005ULL + 1442695040888963407ULL;
+                text[(noise >> 33) % text.size()] = static_cast<char>(noise >> 56);
+            }
+            if (k % 2 == 0) text += std::string("ñ日😀").substr(0, 9 - static_cast<size_t>(k % 3));
+            checkUtf8(text, utf8);
+        }
+    }
+
+    bool failed = false;
+    for (const DifferentialStats &stats : {lexer, classes, utf8, expressions, programs, tiered}) {
+        std::cout << stats.name << ": " << stats.cases << " cases, " << stats.mismatches << " mismatches" << std::endl;
+        failed = failed || stats.mismatches > 0;
+    }
+    return failed ? 1 : 0;
+}
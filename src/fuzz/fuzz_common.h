@@ -0,0 +1,72 @@
+#ifndef FUZZ_COMMON_H
+#define FUZZ_COMMON_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "bench/bench_common.h"
+#include "lexical_analyzer/lexical_analyzer.h"
+
+/**
+ * @brief Analizador léxico compartido por todas las entradas de un proceso de fuzzing.
+ */
+inline const LexicalAnalyzer &fuzzLexer() {
+    static const LexicalAnalyzer lexer = [] {
+        std::ifstream configFile(benchConfigPath());
+        return LexicalAnalyzer(configFile);
+    }();
+    return lexer;
+}
+
+/**
+ * @brief Archivo temporal propio del proceso; se borra al terminar.
+ */
+struct FuzzInputPath {
+    std::string path;
+
+    FuzzInputPath()
+        : path((std::filesystem::temp_directory_path() /
+                ("fuzz_input_" + std::to_string(static_cast<long long>(getpid())) + ".txt")).string()) {}
+    ~FuzzInputPath() { std::remove(this->path.c_str()); }
+};
+
+/**
+ * @brief Escribe una entrada en un archivo temporal del proceso, ya que el analizador léxico lee archivos.
+ * @return Ruta del archivo, en el directorio temporal del sistema; se sobrescribe en la siguiente llamada.
+ */
+inline std::string fuzzInputFile(const uint8_t* data, const size_t size) {
+    static const FuzzInputPath input;
+    std::ofstream(input.path, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(data),
+                                                                        static_cast<std::streamsize>(size));
+    return input.path;
+}
+
+/**
+ * @brief Compara dos secuencias de tokens por tipo, lexema, valor y posición.
+ */
+inline bool sameTokens(const ArrayList<NodeStruct> &left, const ArrayList<NodeStruct> &right) {
+    if (left.getSize() != right.getSize()) return false;
+    Node<NodeStruct>* b = right.getFirst();
+    for (Node<NodeStruct>* a = left.getFirst(); a != nullptr; a = a->getNextNode(), b = b->getNextNode()) {
+        const NodeStruct &x = a->getDataRef();
+        const NodeStruct &y = b->getDataRef();
+        if (x.type != y.type || x.name != y.name || x.offset != y.offset || x.length != y.length ||
+            x.value.kind != y.value.kind || x.value.integer != y.value.integer) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Igualdad bit a bit de dos resultados; dos NaN se consideran iguales.
+ */
+inline bool sameResult(const double left, const double right) {
+    if (std::isnan(left) && std::isnan(right)) return true;
+    return std::memcmp(&left, &right, sizeof(double)) == 0;
+}
+
+#endif
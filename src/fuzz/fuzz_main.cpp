@@ -0,0 +1,41 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/*
+ * Sustituto de libFuzzer para compiladores sin -fsanitize=fuzzer: ejecuta el objetivo sobre
+ * cada archivo indicado y sobre los archivos de cada directorio (p. ej. fuzz_corpus/). Sirve
+ * para reproducir fallos y repasar el corpus con ASan/UBSan.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static bool runFile(const std::filesystem::path &path, long long &executed) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open " << path.string() << std::endl;
+        return false;
+    }
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    ++executed;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    long long executed = 0;
+    for (int i = 1; i < argc; i++) {
+        const std::filesystem::path path = argv[i];
+        if (std::filesystem::is_directory(path)) {
+            for (const auto &entry : std::filesystem::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file() && !runFile(entry.path(), executed)) return 1;
+            }
+        } else if (!runFile(path, executed)) {
+            return 1;
+        }
+    }
+    std::cout << "Executed " << executed << " inputs" << std::endl;
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include <cstdlib>
+#include <stdexcept>
+#include "fuzz_common.h"
+#include "operations_analyzer/operations_analyzer.h"
+
+/*
+ * Objetivo de libFuzzer para OperationsAnalyzer. La entrada se tokeniza y se evalúa desde los
+ * tokens, compilándola en una caché vacía y otra vez desde la caché. Las tres evaluaciones deben
+ * dar el mismo resultado bit a bit o lanzar las tres. Cada una parte de una SymbolTable nueva
+ * porque `++` y `--` la modifican.
+ */
+static bool evaluate(const ArrayList<NodeStruct> &tokens, ExpressionCache* cache, double &result) {
+    SymbolTable symbols;
+    symbols.set("x", 3);
+    symbols.set("y", 4);
+    symbols.setArray("a", {10, 20, 30});
+    try {
+        result = OperationsAnalyzer::evaluate(tokens, cache, &symbols);
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size) {
+    ArrayList<NodeStruct> tokens;
+    try {
+        std::ifstream code(fuzzInputFile(data, size), std::ios::binary);
+        tokens = fuzzLexer().tokenize(code);
+    } catch (const std::exception &) {
+        return 0;
+    }
+
+    ExpressionCache cache(4);
+    double interpreted = 0;
+    double compiled = 0;
+    double cached = 0;
+    const bool a = evaluate(tokens, nullptr, interpreted);
+    const bool b = evaluate(tokens, &cache, compiled);
+    const bool c = evaluate(tokens, &cache, cached);
+    if (a != b || a != c) std::abort();
+    if (a && (!sameResult(interpreted, compiled) || !sameResult(interpreted, cached))) std::abort();
+    return 0;
+}
@@ -0,0 +1,24 @@
+#include <stdexcept>
+#include "fuzz_common.h"
+#include "program_parser/program_parser.h"
+#include "ir_builder/ir_builder.h"
+#include "ir_optimizer/ir_optimizer.h"
+#include "bytecode_compiler/bytecode_compiler.h"
+
+/*
+ * Objetivo de libFuzzer para ProgramParser y lo que consume su árbol: IrBuilder, IrOptimizer y
+ * BytecodeCompiler. Los programas no se ejecutan porque una entrada arbitraria puede no terminar.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size) {
+    ProgramStruct program;
+    try {
+        std::ifstream code(fuzzInputFile(data, size), std::ios::binary);
+        program = ProgramParser::parse(fuzzLexer().tokenize(code));
+    } catch (const std::exception &) {
+        return 0;
+    }
+    IrFunction function = IrBuilder::build(program);
+    IrOptimizer::optimize(function);
+    BytecodeCompiler::compile(program);
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include <cstdlib>
+#include <stdexcept>
+#include "fuzz_common.h"
+#include "block_reader/block_reader.h"
+
+/*
+ * Objetivo de libFuzzer para LexicalAnalyzer::tokenize(). Cada entrada se tokeniza por líneas
+ * y por bloques; las dos rutas deben producir los mismos tokens o lanzar las dos.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, const size_t size) {
+    const std::string path = fuzzInputFile(data, size);
+    ArrayList<NodeStruct> lines;
+    ArrayList<NodeStruct> blocks;
+    bool linesFailed = false;
+    bool blocksFailed = false;
+
+    try {
+        std::ifstream code(path, std::ios::binary);
+        lines = fuzzLexer().tokenize(code);
+    } catch (const std::exception &) {
+        linesFailed = true;
+    }
+    try {
+        BlockReader reader(path, 4096);
+        blocks = fuzzLexer().tokenize(reader);
+    } catch (const std::exception &) {
+        blocksFailed = true;
+    }
+
+    if (linesFailed != blocksFailed || (!linesFailed && !sameTokens(lines, blocks))) std::abort();
+    return 0;
+}
@@ -0,0 +1,233 @@
+#ifndef IR_REFERENCE_H
+#define IR_REFERENCE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "builtin_functions/builtin_functions.h"
+#include "../../interface/ir_struct.h"
+
+/**
+ * @brief Intérprete de referencia de la IR SSA, escrito para ser obvio y no rápido.
+ * * Ejecuta bloque a bloque, resolviendo los φ con el predecesor del que se llega, con la misma
+ * semántica que BytecodeVm: enteros de 64 bits con desbordamiento circular, conversión a entero
+ * saturada (NaN da 0) y std::out_of_range para la división entera entre cero, los índices fuera
+ * de rango y los tamaños negativos. El resultado son los valores de las instrucciones EXPORT,
+ * escritos con formatValue().
+ */
+class IrReference {
+
+    private:
+        struct Value {
+            int64_t integer = 0;
+            double real = 0.0;
+            std::string text;
+            int64_t array = -1;
+        };
+
+        static int64_t wrap(uint64_t value);
+        static int64_t toInteger(double value);
+
+    public:
+        static std::string formatValue(ValueType type, int64_t integer, double real, const std::string &text);
+        static std::vector<std::string> run(const IrFunction &function);
+};
+
+inline int64_t IrReference::wrap(const uint64_t value) {
+    return static_cast<int64_t>(value);
+}
+
+inline int64_t IrReference::toInteger(const double value) {
+    if (std::isnan(value)) return 0;
+    if (value >= 9223372036854775807.0) return INT64_MAX;
+    if (value <= -9223372036854775808.0) return INT64_MIN;
+    return static_cast<int64_t>(value);
+}
+
+/**
+ * @brief Texto canónico de un valor: entero en decimal, real con 17 cifras y cadena entre comillas.
+ */
+inline std::string IrReference::formatValue(const ValueType type, const int64_t integer, const double real,
+                                            const std::string &text) {
+    if (type == ValueType::INT) return std::to_string(integer);
+    if (type == ValueType::STRING) return "\"" + text + "\"";
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", real);
+    return buffer;
+}
+
+/**
+ * @brief Ejecuta la función desde el bloque 0 hasta su RETURN.
+ * @throw std::out_of_range Con los mismos mensajes que BytecodeVm.
+ * @return Por cada variable, su valor exportado (`{a, b}` para los arreglos); vacío si no se exportó.
+ */
+inline std::vector<std::string> IrReference::run(const IrFunction &function) {
+    std::vector<Value> values(function.instructions.size());
+    std::vector<std::vector<Value>> arrays;
+    std::vector<std::string> exports(function.variables.size());
+    const auto operand = [&](const IrInstruction &instruction, const uint32_t k) -> const Value & {
+        return values[function.operands[instruction.first + k]];
+    };
+    const auto typeOf = [&](const IrInstruction &instruction, const uint32_t k) {
+        return function.instructions[function.operands[instruction.first + k]].type;
+    };
+    const auto element = [&](const IrInstruction &instruction) -> Value & {
+        const Value &array = operand(instruction, 0);
+        const int64_t index = operand(instruction, 1).integer;
+        std::vector<Value> &storage = arrays[static_cast<size_t>(array.array)];
+        if (index < 0 || index >= static_cast<int64_t>(storage.size())) throw std::out_of_range("Index out of range");
+        return storage[static_cast<size_t>(index)];
+    };
+
+    uint32_t block = 0;
+    uint32_t previous = 0;
+    while (true) {
+        const IrBlock &current = function.blocks[block];
+        if (!current.phis.empty()) {
+            const size_t from = static_cast<size_t>(std::find(current.predecessors.begin(), current.predecessors.end(), previous) -
+                                                    current.predecessors.begin());
+            std::vector<Value> incoming;
+            for (const uint32_t phi : current.phis) incoming.push_back(operand(function.instructions[phi], static_cast<uint32_t>(from)));
+            for (size_t k = 0; k < current.phis.size(); k++) values[current.phis[k]] = incoming[k];
+        }
+
+        bool jumped = false;
+        for (const uint32_t id : current.code) {
+            const IrInstruction &instruction = function.instructions[id];
+            Value result;
+            switch (instruction.op) {
+                case IrOp::CONST:
+                    if (instruction.type == ValueType::INT) result.integer = instruction.constant.integer;
+                    else result.real = instruction.constant.asDouble();
+                    break;
+                case IrOp::STRING:
+                    if (instruction.symbol >= 0) result.text = function.strings[static_cast<size_t>(instruction.symbol)];
+                    break;
+                case IrOp::PHI:
+                    break;
+                case IrOp::CONVERT: {
+                    const Value &a = operand(instruction, 0);
+                    if (instruction.type == ValueType::INT) result.integer = toInteger(a.real);
+                    else result.real = typeOf(instruction, 0) == ValueType::INT ? static_cast<double>(a.integer) : a.real;
+                    break;
+                }
+                case IrOp::UNARY: {
+                    const Value &a = operand(instruction, 0);
+                    const bool integer = typeOf(instruction, 0) == ValueType::INT;
+                    if (instruction.code == OpCode::NOT) result.integer = integer ? a.integer == 0 : a.real == 0.0;
+                    else if (integer) result.integer = wrap(0 - static_cast<uint64_t>(a.integer));
+                    else result.real = -a.real;
+                    break;
+                }
+                case IrOp::BINARY: {
+                    const Value &a = operand(instruction, 0);
+                    const Value &b = operand(instruction, 1);
+                    const ValueType type = typeOf(instruction, 0);
+                    const OpCode code = instruction.code;
+                    if (type == ValueType::STRING) {
+                        if (code == OpCode::ADD) result.text = a.text + b.text;
+                        else result.integer = (a.text == b.text) == (code == OpCode::EQ);
+                    } else if (type == ValueType::INT) {
+                        const int64_t x = a.integer;
+                        const int64_t y = b.integer;
+                        switch (code) {
+                            case OpCode::ADD: result.integer = wrap(static_cast<uint64_t>(x) + static_cast<uint64_t>(y)); break;
+                            case OpCode::SUB: result.integer = wrap(static_cast<uint64_t>(x) - static_cast<uint64_t>(y)); break;
+                            case OpCode::MUL: result.integer = wrap(static_cast<uint64_t>(x) * static_cast<uint64_t>(y)); break;
+                            case OpCode::DIV:
+                            case OpCode::MOD:
+                                if (y == 0) throw std::out_of_range("Division by zero");
+                                if (y == -1) result.integer = code == OpCode::DIV ? wrap(0 - static_cast<uint64_t>(x)) : 0;
+                                else result.integer = code == OpCode::DIV ? x / y : x % y;
+                                break;
+                            case OpCode::EQ: result.integer = x == y; break;
+                            case OpCode::NE: result.integer = x != y; break;
+                            case OpCode::LT: result.integer = x < y; break;
+                            case OpCode::GT: result.integer = x > y; break;
+                            case OpCode::LE: result.integer = x <= y; break;
+                            case OpCode::GE: result.integer = x >= y; break;
+                            default: throw std::out_of_range("Invalid integer operator");
+                        }
+                    } else {
+                        const double x = a.real;
+                        const double y = b.real;
+                        switch (code) {
+                            case OpCode::ADD: result.real = x + y; break;
+                            case OpCode::SUB: result.real = x - y; break;
+                            case OpCode::MUL: result.real = x * y; break;
+                            case OpCode::DIV: result.real = x / y; break;
+                            case OpCode::MOD: result.real = std::fmod(x, y); break;
+                            case OpCode::POW: result.real = std::pow(x, y); break;
+                            case OpCode::EQ: result.integer = x == y; break;
+                            case OpCode::NE: result.integer = x != y; break;
+                            case OpCode::LT: result.integer = x < y; break;
+                            case OpCode::GT: result.integer = x > y; break;
+                            case OpCode::LE: result.integer = x <= y; break;
+                            case OpCode::GE: result.integer = x >= y; break;
+                            default: throw std::out_of_range("Invalid real operator");
+                        }
+                    }
+                    break;
+                }
+                case IrOp::CALL: {
+                    double args[BuiltinFunctions::MAX_ARITY] = {};
+                    for (uint32_t k = 0; k < instruction.count; k++) args[k] = operand(instruction, k).real;
+                    result.real = BuiltinFunctions::get(instruction.symbol).apply(args);
+                    break;
+                }
+                case IrOp::ARRAY_NEW: {
+                    const int64_t size = operand(instruction, 0).integer;
+                    if (size < 0) throw std::out_of_range("Invalid array size");
+                    arrays.emplace_back(static_cast<size_t>(size));
+                    result.array = static_cast<int64_t>(arrays.size() - 1);
+                    break;
+                }
+                case IrOp::ARRAY_LOAD:
+                    result = element(instruction);
+                    break;
+                case IrOp::ARRAY_STORE:
+                    element(instruction) = operand(instruction, 2);
+                    break;
+                case IrOp::EXPORT: {
+                    const Value &a = operand(instruction, 0);
+                    std::string &out = exports[static_cast<size_t>(instruction.symbol)];
+                    if (a.array < 0) {
+                        out = formatValue(instruction.type, a.integer, a.real, a.text);
+                        break;
+                    }
+                    out = "{";
+                    for (const Value &item : arrays[static_cast<size_t>(a.array)]) {
+                        if (out.size() > 1) out += ", ";
+                        out += formatValue(instruction.type, item.integer, item.real, item.text);
+                    }
+                    out += "}";
+                    break;
+                }
+                case IrOp::JUMP:
+                    previous = block;
+                    block = current.successors[0];
+                    jumped = true;
+                    break;
+                case IrOp::BRANCH: {
+                    const Value &a = operand(instruction, 0);
+                    const bool taken = typeOf(instruction, 0) == ValueType::INT ? a.integer != 0 : a.real != 0.0;
+                    previous = block;
+                    block = current.successors[taken ? 0 : 1];
+                    jumped = true;
+                    break;
+                }
+                case IrOp::RETURN:
+                    return exports;
+            }
+            if (jumped) break;
+            values[id] = result;
+        }
+        if (!jumped) throw std::out_of_range("Block without terminator");
+    }
+}
+
+#endif
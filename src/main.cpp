@@ -1,6 +1,321 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "pipeline/pipeline.h"
+#include "program_parser/program_parser.h"
+#include "ir_builder/ir_builder.h"
+#include "ir_optimizer/ir_optimizer.h"
+#include "bytecode_compiler/bytecode_compiler.h"
+#include "bytecode_vm/bytecode_vm.h"
+#include "tiered_interpreter/tiered_interpreter.h"
+#include "language_server/language_server.h"
 
-int main() {
+/**
+ * @brief Memoria observada al finalizar una fase de la compilación.
+ */
+struct PhaseMemory {
+    std::string name;
+    MemoryFootprint tracked;
+    size_t rssBytes;
+    size_t peakRssBytes;
+};
 
+static PhaseMemory snapshot(const std::string &name, const MemoryFootprint &tracked) {
+    return PhaseMemory{name, tracked, MemoryUsage::currentRssBytes(), MemoryUsage::peakRssBytes()};
+}
 
-    return 0;
-}
\ No newline at end of file
+static void printMemoryReport(const std::vector<PhaseMemory> &phases, const long long inputBytes) {
+    const int wPhase = 14;
+    const int wCol = 14;
+    std::cout << std::left << std::setw(wPhase) << "FASE"
+              << std::right << std::setw(wCol) << "NODOS" << std::setw(wCol) << "CADENAS"
+              << std::setw(wCol) << "RSS" << std::setw(wCol) << "PICO RSS" << std::endl;
+    std::cout << std::string(wPhase + 4 * wCol, '-') << std::endl;
+    for (const PhaseMemory &phase : phases) {
+        std::cout << std::left << std::setw(wPhase) << phase.name
+                  << std::right << std::setw(wCol) << phase.tracked.nodeBytes
+                  << std::setw(wCol) << phase.tracked.stringBytes
+                  << std::setw(wCol) << phase.rssBytes
+                  << std::setw(wCol) << phase.peakRssBytes << std::endl;
+    }
+    std::cout << "Entrada: " << inputBytes << " bytes" << std::endl;
+}
+
+static void printUsage() {
+    std::cerr << "Usage: proyectos <source> [--config=<csv>] [--release] [--evaluate] [--pipeline] [--ir] [--run] [--profile] [--memory] "
+                 "[--block-size=<KiB>] [--max-phase-memory-ratio=R] [--max-peak-rss-ratio=R] [--trace=<file.json>] [--stats=<file.json>]\n"
+                 "       proyectos --lsp [--config=<csv>] [--latency-budget=<ms>] [--lsp-record=<file.jsonl>]" << std::endl;
+}
+
+/**
+ * @brief Escribe la traza de Chrome (--trace) y el resumen de contadores y fases (--stats) pedidos.
+ */
+static void writeInstrumentation(const std::string &tracePath, const std::string &statsPath) {
+    if (!tracePath.empty()) {
+        std::ofstream trace(tracePath);
+        Instrumentation::dumpChromeTrace(trace);
+    }
+    if (!statsPath.empty()) {
+        std::ofstream stats(statsPath);
+        Instrumentation::dumpJson(stats);
+    }
+}
+
+/**
+ * @brief Lee el valor de una opción numérica `--nombre=valor` con NumberParser, sin depender del locale.
+ * @param arg Argumento completo.
+ * @param prefix Parte `--nombre=`.
+ * @param[out] value Valor leído.
+ * @return false, tras mostrar el uso, si el valor no es un número positivo.
+ */
+static bool optionValue(const std::string &arg, const std::string &prefix, double &value) {
+    NumberValue number;
+    if (NumberParser::parse(arg.substr(prefix.size()), number) && number.asDouble() > 0) {
+        value = number.asDouble();
+        return true;
+    }
+    std::cerr << "Invalid value for " << prefix.substr(0, prefix.size() - 1) << ": '" << arg.substr(prefix.size())
+              << "'" << std::endl;
+    printUsage();
+    return false;
+}
+
+/**
+ * @brief Modo servidor: atiende el Language Server Protocol por la entrada y salida estándar.
+ * Uso: proyectos --lsp [--config=<csv>] [--latency-budget=<ms>] [--lsp-record=<archivo.jsonl>]
+ */
+static int runLanguageServer(const int argc, char **argv) {
+    std::string configPath = "../config/lexical_config.csv";
+    std::string recordPath;
+    double latencyBudgetMs = 50.0;
+    for (int i = 2; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--config=", 0) == 0) configPath = arg.substr(9);
+        else if (arg.rfind("--lsp-record=", 0) == 0) recordPath = arg.substr(13);
+        else if (arg.rfind("--latency-budget=", 0) == 0) {
+            if (!optionValue(arg, "--latency-budget=", latencyBudgetMs)) return 1;
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::ifstream configFile(configPath);
+    if (!configFile.is_open()) {
+        std::cerr << "Error: No se pudo abrir la configuración léxica. Verifica la ruta." << std::endl;
+        return 1;
+    }
+    std::ofstream record;
+    if (!recordPath.empty()) record.open(recordPath);
+    std::ios::sync_with_stdio(false);
+    LanguageServer server(LexicalAnalyzer::loadProvider(configFile), latencyBudgetMs);
+    return server.serve(std::cin, std::cout, record.is_open() ? &record : nullptr);
+}
+
+/**
+ * Driver del compilador.
+ * Uso: proyectos <codigo> [--config=<csv>] [--release] [--evaluate] [--pipeline] [--ir] [--run] [--profile] [--memory]
+ *                [--block-size=<KiB>] [--max-phase-memory-ratio=R] [--max-peak-rss-ratio=R] [--trace=<archivo.json>]
+ *                [--stats=<archivo.json>]
+ *      proyectos --lsp [--config=<csv>] [--latency-budget=<ms>] [--lsp-record=<archivo.jsonl>]
+ */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+    if (std::string(argv[1]) == "--lsp") return runLanguageServer(argc, argv);
+
+    const std::string sourcePath = argv[1];
+    std::string configPath = "../config/lexical_config.csv";
+    std::string tracePath;
+    std::string statsPath;
+    bool release = false;
+    bool evaluate = false;
+    bool memory = false;
+    bool pipeline = false;
+    bool ir = false;
+    bool run = false;
+    bool profile = false;
+    double maxPhaseMemoryRatio = 0;
+    double maxPeakRssRatio = 0;
+    double blockKiB = 0;
+    const size_t baselineRss = MemoryUsage::currentRssBytes();
+
+    for (int i = 2; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--config=", 0) == 0) configPath = arg.substr(9);
+        else if (arg.rfind("--trace=", 0) == 0) tracePath = arg.substr(8);
+        else if (arg.rfind("--stats=", 0) == 0) statsPath = arg.substr(8);
+        else if (arg.rfind("--max-phase-memory-ratio=", 0) == 0) {
+            if (!optionValue(arg, "--max-phase-memory-ratio=", maxPhaseMemoryRatio)) return 1;
+        } else if (arg.rfind("--max-peak-rss-ratio=", 0) == 0) {
+            if (!optionValue(arg, "--max-peak-rss-ratio=", maxPeakRssRatio)) return 1;
+        } else if (arg.rfind("--block-size=", 0) == 0) {
+            if (!optionValue(arg, "--block-size=", blockKiB)) return 1;
+        }
+        else if (arg == "--release") release = true;
+        else if (arg == "--evaluate") evaluate = true;
+        else if (arg == "--memory") memory = true;
+        else if (arg == "--pipeline") pipeline = true;
+        else if (arg == "--ir") ir = true;
+        else if (arg == "--run") run = true;
+        else if (arg == "--profile") profile = true;
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+#ifndef MINI_COMPILER_INSTRUMENTATION
+    if (!tracePath.empty() || !statsPath.empty()) {
+        std::cerr << "Error: --trace and --stats require a build configured with -DENABLE_INSTRUMENTATION=ON." << std::endl;
+        return 1;
+    }
+#endif
+
+    std::ifstream configFile(configPath);
+    std::ifstream code(sourcePath);
+    if (!configFile.is_open() || !code.is_open()) {
+        std::cerr << "Error: No se pudieron abrir los archivos. Verifica las rutas." << std::endl;
+        return 1;
+    }
+    std::ifstream sizeProbe(sourcePath, std::ios::binary | std::ios::ate);
+    const long long inputBytes = static_cast<long long>(sizeProbe.tellg());
+    if (inputBytes > static_cast<long long>(NodeStruct::MAX_OFFSET)) {
+        std::cerr << "Error: " << sourcePath << " is larger than 4 GiB; token offsets are 32-bit." << std::endl;
+        return 1;
+    }
+
+    if (!tracePath.empty() || !statsPath.empty()) Instrumentation::enable();
+
+    std::vector<PhaseMemory> phases;
+    int exitCode = 0;
+
+    if (pipeline) {
+        const CompilationPipeline stages(LexicalAnalyzer::loadProvider(configFile));
+        StatementEvaluator evaluator(&ExpressionCache::shared());
+        try {
+            const PipelineStats stats = stages.run(code, evaluator);
+            evaluator.finish();
+            std::cout << "Tokens: " << stats.tokens << std::endl;
+            std::cout << "Statements: " << evaluator.getStatements()
+                      << " (evaluated " << evaluator.getEvaluated() << ")" << std::endl;
+            std::cout << "First batch: " << stats.firstBatchUs << " us, total: " << stats.totalUs << " us" << std::endl;
+        } catch (const std::exception &e) {
+            std::cerr << "Error evaluating expression: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+        writeInstrumentation(tracePath, statsPath);
+        return exitCode;
+    }
+
+    LexicalAnalyzer lexer(configFile);
+    lexer.setReleaseSource(release);
+    MemoryFootprint lexed;
+    ArrayList<NodeStruct> tokens;
+    try {
+        if (blockKiB > 0) {
+            BlockReader reader(sourcePath, static_cast<size_t>(blockKiB * 1024));
+            tokens = lexer.tokenize(reader);
+            lexed = tokens.footprint();
+        } else {
+            tokens = lexer.tokenize(code, &lexed);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    phases.push_back(snapshot("tokenize", lexed));
+    std::cout << "Tokens: " << tokens.getSize() << std::endl;
+
+    if (ir) {
+        try {
+            const ProgramStruct program = ProgramParser::parse(tokens);
+            IrFunction function = IrBuilder::build(program);
+            const std::vector<IrPassStats> stats = IrOptimizer::optimize(function);
+            std::cout << std::left << std::setw(28) << "PASADA" << std::right << std::setw(10) << "ANTES"
+                      << std::setw(10) << "DESPUES" << std::setw(12) << "US" << std::endl;
+            for (const IrPassStats &pass : stats) {
+                std::cout << std::left << std::setw(28) << pass.name << std::right << std::setw(10) << pass.before
+                          << std::setw(10) << pass.after << std::setw(12) << std::fixed << std::setprecision(1)
+                          << pass.microseconds << std::endl;
+            }
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6);
+            IrBuilder::print(function, std::cout);
+        } catch (const std::exception &e) {
+            std::cerr << "Error building IR: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+    }
+
+    if (run) {
+        try {
+            const BytecodeProgram program = BytecodeCompiler::compile(ProgramParser::parse(tokens));
+            BytecodeVm vm;
+            const Value result = vm.run(program);
+            std::cout << "Result: ";
+            if (result.type == ValueType::STRING) std::cout << vm.text(static_cast<uint32_t>(result.integer));
+            else if (result.type == ValueType::INT) std::cout << result.integer;
+            else std::cout << result.real;
+            std::cout << std::endl;
+            vm.dump(std::cout);
+        } catch (const std::exception &e) {
+            std::cerr << "Error running program: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+    }
+
+    if (profile) {
+        try {
+            const ProgramStruct program = ProgramParser::parse(tokens);
+            TieredInterpreter interpreter(program);
+            const double result = interpreter.run();
+            std::cout << "Result: " << result << std::endl;
+            interpreter.dump(std::cout);
+        } catch (const std::exception &e) {
+            std::cerr << "Error running program: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+    }
+
+    if (evaluate) {
+        OperationsAnalyzer analyzer = release ? OperationsAnalyzer(std::move(tokens)) : OperationsAnalyzer(tokens);
+        MemoryFootprint evaluated = tokens.footprint();
+        evaluated += analyzer.footprint();
+        try {
+            std::cout << "Result: " << analyzer.evaluate() << std::endl;
+        } catch (const std::exception &e) {
+            std::cerr << "Error evaluating expression: " << e.what() << std::endl;
+            exitCode = 1;
+        }
+        phases.push_back(snapshot("evaluate", evaluated));
+    }
+
+    if (memory) printMemoryReport(phases, inputBytes);
+
+    writeInstrumentation(tracePath, statsPath);
+
+    const double limit = static_cast<double>(inputBytes);
+    for (const PhaseMemory &phase : phases) {
+        if (inputBytes <= 0) break;
+        if (maxPhaseMemoryRatio > 0 && static_cast<double>(phase.tracked.total()) > maxPhaseMemoryRatio * limit) {
+            std::cerr << "Error: tracked memory at end of phase '" << phase.name << "' (" << phase.tracked.total()
+                      << " bytes) exceeds " << maxPhaseMemoryRatio << "x input size" << std::endl;
+            return 2;
+        }
+        const size_t peak = std::max(phase.peakRssBytes, phase.rssBytes);
+        const size_t growth = peak > baselineRss ? peak - baselineRss : 0;
+        if (maxPeakRssRatio > 0 && static_cast<double>(growth) > maxPeakRssRatio * limit) {
+            std::cerr << "Error: peak RSS by end of phase '" << phase.name << "' grew " << growth
+                      << " bytes, exceeding " << maxPeakRssRatio << "x input size" << std::endl;
+            return 2;
+        }
+    }
+    return exitCode;
+}
@@ -0,0 +1,64 @@
+#ifndef CHAR_CLASSES_H
+#define CHAR_CLASSES_H
+
+#include <string>
+#include <vector>
+#include "lexical_analyzer/lexical_analyzer.h"
+
+/*
+ * Comprobación de la tabla CharClass compartida por test_char_classes y el arnés diferencial.
+ */
+
+/**
+ * @brief Casos de charClassMismatches(): los 256 bytes y la línea de bytes ≥ 0x80.
+ */
+static const int CHAR_CLASS_CASES = 257;
+
+/**
+ * @brief Comprueba los 256 bytes de la tabla CharClass contra una clasificación escrita a mano y
+ * el análisis de los bytes ≥ 0x80: una línea con todos ellos, que no forma ninguna secuencia
+ * UTF-8 válida, debe dar un token UNKNOWN de un byte por cada uno, con su desplazamiento.
+ * @return Una descripción por cada discrepancia; vacío si todo coincide.
+ */
+inline std::vector<std::string> charClassMismatches(const LexicalAnalyzer &lexer) {
+    std::vector<std::string> mismatches;
+    const TokenProvider &provider = *lexer.getTokenProvider();
+    for (int c = 0; c < 256; c++) {
+        const char character = static_cast<char>(c);
+        const bool space = c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        const bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        const bool digit = c >= '0' && c <= '9';
+        const bool high = c >= 0x80;
+        const bool token = !high && provider.isToken(std::string(1, character));
+        bool comment = false;
+        for (const std::string &prefix : provider.getLineComments()) comment = comment || prefix[0] == character;
+        for (const BlockComment &block : provider.getBlockComments()) comment = comment || block.open[0] == character;
+        uint8_t expected = 0;
+        if (space) expected |= CharClass::SPACE;
+        if (letter) expected |= CharClass::IDENT_START | CharClass::IDENT_CONTINUE;
+        if (digit) expected |= CharClass::DIGIT | CharClass::IDENT_CONTINUE;
+        if (high) expected |= CharClass::NON_ASCII;
+        else if (!space && c != '.' && (token || (!letter && !digit))) expected |= CharClass::OPERATOR;
+        if (token && provider.getToken(std::string(1, character)) == TokenType::TEXT_DELIMITER) expected |= CharClass::QUOTE;
+        if (comment) expected |= CharClass::COMMENT;
+        if (provider.charClass(character) != expected) {
+            mismatches.push_back("byte " + std::to_string(c) + " has class " + std::to_string(provider.charClass(character)) +
+                                 ", expected " + std::to_string(expected));
+        }
+    }
+
+    std::string high;
+    for (int c = 0x80; c < 0x100; c++) high += static_cast<char>(c);
+    ArrayList<NodeStruct> tokens;
+    lexer.tokenizeLine(high, 0, tokens);
+    bool valid = static_cast<size_t>(tokens.getSize()) == high.size();
+    for (size_t k = 0; valid && k < high.size(); k++) {
+        const NodeStruct &token = tokens.get()->getDataRef();
+        valid = token.type == TokenType::UNKNOWN && token.name == high.substr(k, 1) && token.offset == k && token.length == 1;
+        tokens.currentNext();
+    }
+    if (!valid) mismatches.push_back("bytes >= 0x80 not split into single-byte UNKNOWN tokens");
+    return mismatches;
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef CONCURRENT_COMPILE_H
+#define CONCURRENT_COMPILE_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench/workload_generator.h"
+#include "operations_analyzer/operations_analyzer.h"
+
+/*
+ * Prueba de estrés compartida por bench_concurrency y test_concurrency: una única configuración
+ * léxica, un único LexicalAnalyzer y una única caché de expresiones para todos los hilos. Con
+ * -DENABLE_TSAN=ON se ejecuta bajo ThreadSanitizer.
+ */
+
+/**
+ * @brief Expresiones de la prueba y su resultado de referencia, calculado en un solo hilo y sin caché.
+ */
+struct ConcurrentSources {
+    std::vector<std::string> expressions;
+    std::vector<double> expected;
+};
+
+inline ConcurrentSources concurrentSources(const LexicalAnalyzer &lexer, const int count = 16) {
+    ConcurrentSources sources;
+    WorkloadGenerator generator{WorkloadConfig()};
+    for (int i = 0; i < count; i++) {
+        sources.expressions.push_back(generator.expression(4));
+        ArrayList<NodeStruct> tokens;
+        lexer.tokenizeLine(sources.expressions.back(), 0, tokens);
+        sources.expected.push_back(OperationsAnalyzer::evaluate(tokens, nullptr));
+    }
+    return sources;
+}
+
+/**
+ * @brief Tokeniza y evalúa @c compilations expresiones repartidas entre @c threads hilos.
+ * @return Cantidad de resultados distintos de la referencia; debe ser 0.
+ */
+inline long long concurrentCompile(const LexicalAnalyzer &lexer, ExpressionCache &cache,
+                                   const ConcurrentSources &sources, const int threads, const int compilations) {
+    std::atomic<long long> mismatches(0);
+    std::vector<std::thread> workers;
+    const size_t count = sources.expressions.size();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            for (int i = t; i < compilations; i += threads) {
+                const size_t source = static_cast<size_t>(i) % count;
+                ArrayList<NodeStruct> tokens;
+                lexer.tokenizeLine(sources.expressions[source], 0, tokens);
+                if (OperationsAnalyzer::evaluate(tokens, &cache) != sources.expected[source]) mismatches.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread &worker : workers) worker.join();
+    return mismatches.load();
+}
+
+#endif
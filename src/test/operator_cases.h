@@ -0,0 +1,76 @@
+#ifndef OPERATOR_CASES_H
+#define OPERATOR_CASES_H
+
+#include <string>
+#include <vector>
+#include "operations_analyzer/operations_analyzer.h"
+
+struct OperatorCase {
+    const char* expression;
+    double expected;
+};
+
+/**
+ * @brief Casos de conformidad de los operadores unarios, de potencia, lógicos, condicionales,
+ * llamadas, indexado e incrementos. Se evalúan con x = 3, y = 4 y a = [10, 20, 30]; los que
+ * combinan `&&`, `||` o `?:` con `++`/`--` o índices inválidos comprueban que la rama omitida
+ * no se evalúa.
+ */
+static const OperatorCase OPERATOR_CASES[] = {
+    {"-3 + 5", 2}, {"- -4", 4}, {"+7 - +2", 5}, {"-2 ** 2", -4}, {"2 ** -1", 0.5},
+    {"2 ** 3 ** 2", 512}, {"2 ^ 3 ^ 2", 512}, {"(2 ** 3) ** 2", 64}, {"10 - 4 - 3", 3}, {"7 % 4", 3},
+    {"1 + 2 * 3 == 7", 1}, {"3 < 4 && 4 < 3", 0}, {"3 < 4 || 4 < 3", 1}, {"!0 + !5", 1},
+    {"1 <= 1 && 2 >= 3 == 0", 1}, {"1 != 2", 1}, {"1 ? 2 : 3", 2}, {"0 ? 2 : 3", 3},
+    {"0 ? 1 : 0 ? 2 : 3", 3}, {"1 ? 0 ? 4 : 5 : 6", 5}, {"1 + 1 > 1 ? 10 : 20", 10},
+    {"sqrt(16) + abs(-2)", 6}, {"max(1, min(5, 3)) * 2", 6}, {"pow(2, 10)", 1024}, {"hypot(3, 4)", 5},
+    {"floor(2.7) + ceil(2.1)", 5}, {"sin(0) + cos(0)", 1}, {"sqrt(x * x + y * y)", 5},
+    {"a[1] + a[2]", 50}, {"a[x - 2] * 2", 40}, {"x++ + x", 7}, {"++x + x", 8}, {"x-- - x", 1},
+    {"--y", 3}, {"a[0]++ + a[0]", 21}, {"-x ** 2", -9}, {"-(x + 1) * 2", -8},
+    {"(0 && x++) + x", 3}, {"(1 || x++) + x", 4}, {"(x > 5 ? x++ : x--) + x", 5}, {"(x < 5 ? y++ : y--) + y", 9},
+    {"(x++ && x++) + x", 6}, {"x++ + x++ * x", 23}, {"0 && 1 / 0", 0}, {"2 && 3", 1}, {"0 || 0.5", 1},
+    {"(1 ? x : a[9]) + 0", 3}, {"0 ? a[9] : 7", 7},
+};
+
+/**
+ * @brief Expresiones mal formadas: todas deben lanzar una excepción.
+ */
+static const char* const OPERATOR_ERRORS[] = {
+    "sqrt(1, 2)", "foo(1)", "1 ? 2", "(1 + 2", "1 + 2)", "a[3]", "5++", "z + 1", "1 +", "max(1,)", "[1]",
+};
+
+static const size_t OPERATOR_CASE_COUNT = sizeof(OPERATOR_CASES) / sizeof(OPERATOR_CASES[0]);
+
+/**
+ * @brief Todas las expresiones: primero los casos con valor y después los errores.
+ */
+inline std::vector<std::string> operatorExpressions() {
+    std::vector<std::string> expressions;
+    for (const OperatorCase &test : OPERATOR_CASES) expressions.push_back(test.expression);
+    for (const char* error : OPERATOR_ERRORS) expressions.push_back(error);
+    return expressions;
+}
+
+/**
+ * @brief Evalúa el caso @c index de operatorExpressions() con las variables de los casos.
+ * @param tokens Tokens de la expresión.
+ * @param cache Caché de expresiones; nullptr para evaluar desde los tokens.
+ * @param[out] actual Valor obtenido, o el mensaje de la excepción.
+ * @return true si el valor coincide con el esperado o, en los errores, si se lanzó una excepción.
+ */
+inline bool checkOperatorCase(const size_t index, const ArrayList<NodeStruct> &tokens, ExpressionCache* cache,
+                              std::string* actual = nullptr) {
+    SymbolTable symbols;
+    symbols.set("x", 3);
+    symbols.set("y", 4);
+    symbols.setArray("a", {10, 20, 30});
+    try {
+        const double value = OperationsAnalyzer::evaluate(tokens, cache, &symbols);
+        if (actual != nullptr) *actual = std::to_string(value);
+        return index < OPERATOR_CASE_COUNT && value == OPERATOR_CASES[index].expected;
+    } catch (const std::exception &e) {
+        if (actual != nullptr) *actual = e.what();
+        return index >= OPERATOR_CASE_COUNT;
+    }
+}
+
+#endif
@@ -0,0 +1,34 @@
+#include <clocale>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bench/bench_common.h"
+#include "char_classes.h"
+
+/*
+ * Prueba de la tabla CharClass y de los bytes ≥ 0x80 (véase char_classes.h). Se repite con los
+ * locales de un byte disponibles, en los que isalpha o isdigit clasificarían algunos bytes altos
+ * de otra forma, para que volver a usar <cctype> en el analizador haga fallar la prueba.
+ * Sale con 1 si algún caso no coincide.
+ */
+int main() {
+    int failures = 0;
+    int locales = 0;
+    for (const char* locale : {"C", "C.UTF-8", "en_US.ISO-8859-1", "de_DE.ISO-8859-1", "es_ES.ISO-8859-1"}) {
+        if (std::setlocale(LC_ALL, locale) == nullptr) continue;
+        ++locales;
+        std::ifstream configFile(benchConfigPath());
+        if (!configFile.is_open()) {
+            std::cerr << "Cannot open " << benchConfigPath() << std::endl;
+            return 1;
+        }
+        const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+        for (const std::string &mismatch : charClassMismatches(lexer)) {
+            ++failures;
+            std::cerr << "FAIL (" << locale << ") " << mismatch << std::endl;
+        }
+    }
+    std::cout << locales << " locales, " << CHAR_CLASS_CASES << " cases each, " << failures << " failures" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
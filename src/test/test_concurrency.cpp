@@ -0,0 +1,27 @@
+#include <fstream>
+#include <iostream>
+#include "bench/bench_common.h"
+#include "concurrent_compile.h"
+
+/*
+ * Prueba de estrés de concurrencia: 2000 compilaciones por ronda con 1, 2, 4 y 8 hilos sobre
+ * una misma caché. Sale con 1 si algún resultado difiere de la referencia secuencial; bajo
+ * ThreadSanitizer (-DENABLE_TSAN=ON) una carrera también hace fallar la prueba.
+ */
+int main() {
+    std::ifstream configFile(benchConfigPath());
+    if (!configFile.is_open()) {
+        std::cerr << "Cannot open " << benchConfigPath() << std::endl;
+        return 1;
+    }
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    const ConcurrentSources sources = concurrentSources(lexer);
+    ExpressionCache cache(64);
+    long long total = 0;
+    for (const int threads : {1, 2, 4, 8}) {
+        const long long mismatches = concurrentCompile(lexer, cache, sources, threads, 2000);
+        std::cout << threads << " threads: " << mismatches << " mismatches" << std::endl;
+        total += mismatches;
+    }
+    return total == 0 ? 0 : 1;
+}
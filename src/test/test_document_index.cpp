@@ -0,0 +1,103 @@
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench/bench_common.h"
+#include "language_server/document_index.h"
+
+/*
+ * Prueba del relex incremental de DocumentIndex: aplica ediciones aleatorias (con comillas,
+ * barras invertidas, saltos de línea y comentarios de bloque) y compara, tras cada una, los
+ * tokens y diagnósticos con los de un índice nuevo construido sobre el mismo texto. Sale con 1
+ * si alguno difiere.
+ */
+
+static const char* const FRAGMENTS[] = {
+    "\"", "'", "\\", "\n", "/*", "*/", "//", " ", "a", "7", "+", ";", "=", "(", ")", "{", "}", "ñ",
+    "int x = 1;\n", "string s = \"a'\nb\";\n", "x = x + 2;\n", "while (x < 3) { x++; }\n",
+};
+
+static bool sameIndex(DocumentIndex &incremental, DocumentIndex &full, std::string &difference) {
+    const std::vector<SemanticToken> left = incremental.semanticTokens();
+    const std::vector<SemanticToken> right = full.semanticTokens();
+    if (incremental.getTokenCount() != full.getTokenCount() || left.size() != right.size()) {
+        difference = "token count " + std::to_string(incremental.getTokenCount()) + " vs " +
+                     std::to_string(full.getTokenCount());
+        return false;
+    }
+    for (size_t i = 0; i < left.size(); i++) {
+        if (left[i].offset != right[i].offset || left[i].length != right[i].length || left[i].type != right[i].type ||
+            left[i].declaration != right[i].declaration) {
+            difference = "token " + std::to_string(i) + " at " + std::to_string(left[i].offset) + "+" +
+                         std::to_string(left[i].length) + " vs " + std::to_string(right[i].offset) + "+" +
+                         std::to_string(right[i].length);
+            return false;
+        }
+    }
+    const std::vector<DocumentDiagnostic> &leftDiagnostics = incremental.getDiagnostics();
+    const std::vector<DocumentDiagnostic> &rightDiagnostics = full.getDiagnostics();
+    if (leftDiagnostics.size() != rightDiagnostics.size()) {
+        difference = "diagnostic count";
+        return false;
+    }
+    for (size_t i = 0; i < leftDiagnostics.size(); i++) {
+        if (leftDiagnostics[i].offset != rightDiagnostics[i].offset || leftDiagnostics[i].length != rightDiagnostics[i].length ||
+            leftDiagnostics[i].message != rightDiagnostics[i].message) {
+            difference = "diagnostic '" + leftDiagnostics[i].message + "' vs '" + rightDiagnostics[i].message + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::ifstream configFile(benchConfigPath());
+    if (!configFile.is_open()) {
+        std::cerr << "Cannot open " << benchConfigPath() << std::endl;
+        return 1;
+    }
+    const std::shared_ptr<const TokenProvider> provider = LexicalAnalyzer::loadProvider(configFile);
+    int failures = 0;
+    long long edits = 0;
+
+    // Caso reducido: una barra invertida dentro de una cadena de varias líneas no cambia el
+    // cuerpo decodificado, pero sí la extensión del token.
+    {
+        DocumentIndex incremental(provider, "int s = \"a'\nb\";");
+        incremental.replace(10, 10, "\\");
+        DocumentIndex full(provider, incremental.getText());
+        std::string difference;
+        ++edits;
+        if (!sameIndex(incremental, full, difference)) {
+            ++failures;
+            std::cerr << "FAIL escaped quote in multi-line string: " << difference << std::endl;
+        }
+    }
+
+    std::mt19937 random(1);
+    const size_t fragmentCount = sizeof(FRAGMENTS) / sizeof(FRAGMENTS[0]);
+    for (int document = 0; document < 1000 && failures < 10; document++) {
+        std::string text;
+        for (int k = 0; k < 40; k++) text += FRAGMENTS[random() % fragmentCount];
+        DocumentIndex incremental(provider, text);
+
+        for (int edit = 0; edit < 100; edit++) {
+            const size_t size = incremental.getText().size();
+            const size_t start = random() % (size + 1);
+            const size_t end = std::min(size, start + random() % 4);
+            const std::string replacement = random() % 4 == 0 ? "" : FRAGMENTS[random() % fragmentCount];
+            incremental.replace(start, end, replacement);
+            DocumentIndex full(provider, incremental.getText());
+            std::string difference;
+            ++edits;
+            if (sameIndex(incremental, full, difference)) continue;
+            ++failures;
+            std::cerr << "FAIL document " << document << ", edit " << edit << " [" << start << ", " << end
+                      << ") -> \"" << replacement << "\": " << difference << std::endl;
+            break;
+        }
+    }
+    std::cout << edits << " edits, " << failures << " failures" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
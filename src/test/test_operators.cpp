@@ -0,0 +1,40 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bench/bench_common.h"
+#include "operator_cases.h"
+
+/*
+ * Prueba de conformidad de los operadores: evalúa cada caso de operator_cases.h desde los
+ * tokens y desde una caché de expresiones (dos veces, para ejecutar también lo ya compilado).
+ * Sale con 1 si algún caso no coincide.
+ */
+int main() {
+    std::ifstream configFile(benchConfigPath());
+    if (!configFile.is_open()) {
+        std::cerr << "Cannot open " << benchConfigPath() << std::endl;
+        return 1;
+    }
+    const LexicalAnalyzer lexer(LexicalAnalyzer::loadProvider(configFile));
+    const std::vector<std::string> expressions = operatorExpressions();
+    ExpressionCache cache(256);
+    int failures = 0;
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < expressions.size(); i++) {
+            ArrayList<NodeStruct> tokens;
+            lexer.tokenizeLine(expressions[i], 0, tokens);
+            for (ExpressionCache* expressionCache : {static_cast<ExpressionCache*>(nullptr), &cache}) {
+                std::string actual;
+                if (checkOperatorCase(i, tokens, expressionCache, &actual)) continue;
+                ++failures;
+                std::cerr << "FAIL " << expressions[i] << (expressionCache != nullptr ? " (cache)" : "") << ": expected "
+                          << (i < OPERATOR_CASE_COUNT ? std::to_string(OPERATOR_CASES[i].expected) : "an error")
+                          << ", got " << actual << std::endl;
+            }
+        }
+    }
+    std::cout << expressions.size() << " cases, " << failures << " failures" << std::endl;
+    return failures == 0 ? 0 : 1;
+}